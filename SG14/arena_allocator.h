@@ -0,0 +1,239 @@
+#ifndef SG14_ARENA_ALLOCATOR_H
+#define SG14_ARENA_ALLOCATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace sg14
+{
+	// A monotonic memory resource: allocations are bumped out of large chunks and individual deallocations are no-ops.
+	// Memory is returned all at once, either by reset() (chunks are kept and reused by subsequent allocations) or by release()/destruction.
+	// Intended for per-level or per-frame data, eg. plf::colony<entity, sg14::arena_allocator<entity>> - the container's own deallocations cost nothing,
+	// and the level's memory is dropped in one go. Not thread-safe.
+	class bump_arena
+	{
+	public:
+		explicit bump_arena(std::size_t chunk_size = 1 << 20) noexcept;
+		~bump_arena();
+
+		bump_arena(const bump_arena&) = delete;
+		bump_arena& operator=(const bump_arena&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+		void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept {}
+
+		// Makes all chunks available for reuse. Any memory previously handed out must no longer be in use:
+		void reset() noexcept;
+		// Returns all chunks to the global heap:
+		void release() noexcept;
+
+		std::size_t bytes_allocated() const noexcept { return m_allocated; }
+		std::size_t bytes_reserved() const noexcept { return m_reserved; }
+
+	private:
+		struct chunk
+		{
+			chunk* next;
+			std::size_t size; // usable bytes following the header
+		};
+
+		static char* chunk_begin(chunk* c) noexcept { return reinterpret_cast<char*>(c) + sizeof(chunk); }
+		void* try_bump(std::size_t bytes, std::size_t alignment) noexcept;
+		void* allocate_from_new_chunk(std::size_t bytes, std::size_t alignment);
+
+		chunk* m_first;
+		chunk* m_current;
+		char* m_cursor;
+		char* m_end;
+		std::size_t m_chunk_size;
+		std::size_t m_allocated;
+		std::size_t m_reserved;
+	};
+
+
+
+	// Stateful allocator drawing from a bump_arena. Copies (including rebound copies) share the arena, and compare equal only if they do.
+	// Like std::pmr::polymorphic_allocator, the arena does not propagate on container copy, move or swap - a container keeps the arena it was constructed with.
+	template <class T>
+	class arena_allocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::false_type;
+		using propagate_on_container_swap = std::false_type;
+		using is_always_equal = std::false_type;
+
+		template <class U>
+		struct rebind
+		{
+			using other = arena_allocator<U>;
+		};
+
+		arena_allocator(bump_arena& arena) noexcept : m_arena(&arena) {}
+
+		template <class U>
+		arena_allocator(const arena_allocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > std::size_t(-1) / sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			m_arena->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		arena_allocator select_on_container_copy_construction() const noexcept
+		{
+			return *this;
+		}
+
+		bump_arena* arena() const noexcept { return m_arena; }
+
+	private:
+		bump_arena* m_arena;
+	};
+
+	template <class T, class U>
+	bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+	{
+		return lhs.arena() == rhs.arena();
+	}
+
+	template <class T, class U>
+	bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+	{
+		return lhs.arena() != rhs.arena();
+	}
+}
+
+
+
+// Implementation:
+
+inline sg14::bump_arena::bump_arena(std::size_t chunk_size) noexcept
+	: m_first(nullptr)
+	, m_current(nullptr)
+	, m_cursor(nullptr)
+	, m_end(nullptr)
+	, m_chunk_size(chunk_size)
+	, m_allocated(0)
+	, m_reserved(0)
+{
+}
+
+inline sg14::bump_arena::~bump_arena()
+{
+	release();
+}
+
+// Returns nullptr if the current chunk cannot hold the allocation:
+inline void* sg14::bump_arena::try_bump(std::size_t bytes, std::size_t alignment) noexcept
+{
+	const std::size_t padding = (alignment - (reinterpret_cast<std::uintptr_t>(m_cursor) & (alignment - 1))) & (alignment - 1);
+	const std::size_t available = static_cast<std::size_t>(m_end - m_cursor);
+
+	if (m_cursor == nullptr || padding > available || bytes > available - padding)
+	{
+		return nullptr;
+	}
+
+	char* const p = m_cursor + padding;
+	m_cursor = p + bytes;
+	m_allocated += bytes;
+	return p;
+}
+
+inline void* sg14::bump_arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+	assert((alignment & (alignment - 1)) == 0);
+
+	if (void* const p = try_bump(bytes, alignment))
+	{
+		return p;
+	}
+
+	return allocate_from_new_chunk(bytes, alignment);
+}
+
+inline void* sg14::bump_arena::allocate_from_new_chunk(std::size_t bytes, std::size_t alignment)
+{
+	// Move on to the next retained chunk (after a reset()) if the allocation fits in it:
+	while (m_current != nullptr && m_current->next != nullptr)
+	{
+		m_current = m_current->next;
+		m_cursor = chunk_begin(m_current);
+		m_end = m_cursor + m_current->size;
+
+		if (void* const p = try_bump(bytes, alignment))
+		{
+			return p;
+		}
+	}
+
+	if (bytes > std::size_t(-1) - sizeof(chunk) - alignment)
+	{
+		throw std::bad_alloc();
+	}
+
+	// Oversized requests get a chunk of their own:
+	const std::size_t size = (bytes + alignment > m_chunk_size) ? bytes + alignment : m_chunk_size;
+	chunk* const new_chunk = static_cast<chunk*>(::operator new(sizeof(chunk) + size));
+	new_chunk->next = nullptr;
+	new_chunk->size = size;
+
+	if (m_current == nullptr)
+	{
+		m_first = new_chunk;
+	}
+	else
+	{
+		m_current->next = new_chunk;
+	}
+
+	m_current = new_chunk;
+	m_reserved += size;
+	m_cursor = chunk_begin(new_chunk);
+	m_end = m_cursor + size;
+	return try_bump(bytes, alignment);
+}
+
+inline void sg14::bump_arena::reset() noexcept
+{
+	m_current = m_first;
+	m_allocated = 0;
+
+	if (m_first != nullptr)
+	{
+		m_cursor = chunk_begin(m_first);
+		m_end = m_cursor + m_first->size;
+	}
+}
+
+inline void sg14::bump_arena::release() noexcept
+{
+	while (m_first != nullptr)
+	{
+		chunk* const next = m_first->next;
+		::operator delete(m_first);
+		m_first = next;
+	}
+
+	m_current = nullptr;
+	m_cursor = nullptr;
+	m_end = nullptr;
+	m_allocated = 0;
+	m_reserved = 0;
+}
+
+#endif // SG14_ARENA_ALLOCATOR_H
@@ -0,0 +1,306 @@
+#ifndef SG14_FILE_BACKED_ALLOCATOR_H
+#define SG14_FILE_BACKED_ALLOCATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <type_traits>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace sg14
+{
+	// Carves allocations out of a memory-mapped backing file, keeping only the most recently allocated resident_bytes in memory, so that a container which grows beyond RAM
+	// spills it's oldest blocks to disk. This suits plf::stack, whose groups are allocated bottom-to-top: cold bottom groups are written back to the file and dropped from memory
+	// as new groups are allocated, and are paged back in (with read-ahead) when pops return to them. Pair it with a plf::stack trim policy other than trim_never, so that the groups
+	// left behind by pops are deallocated and the resident window follows the top of the stack back down.
+	// On Linux the file at 'path' is created (or truncated) and unlinked straight away, so it never outlives the resource. It is sized to 'capacity' up-front as a sparse file and
+	// mapped in one piece, so the addresses handed out never move. Elsewhere allocations come from the global heap and nothing is spilled. Thread-safe.
+	// Allocations are bumped; returned allocations lower the bump point once everything above them has also been returned, as is the case for the groups of a stack. Each allocation
+	// is followed by a small trailer recording where it starts and whether it has been returned, so that deallocate() needs no other bookkeeping - it never allocates, and cannot throw.
+	class file_backed_resource
+	{
+	public:
+		static constexpr std::size_t default_capacity = (sizeof(void*) > 4) ? (std::size_t(64) << 30) : (std::size_t(1) << 30);
+
+		file_backed_resource(const char* path, std::size_t resident_bytes, std::size_t capacity = default_capacity);
+		~file_backed_resource();
+
+		file_backed_resource(const file_backed_resource&) = delete;
+		file_backed_resource& operator=(const file_backed_resource&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+		void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+		// Bytes between the start of the file and the bump point, and how many of those have been written back and dropped from memory:
+		std::size_t bytes_in_use() const noexcept { std::lock_guard<std::mutex> lock(m_mutex); return m_cursor; }
+		std::size_t bytes_spilled() const noexcept { std::lock_guard<std::mutex> lock(m_mutex); return m_spilled; }
+		std::size_t resident_bytes() const noexcept { return m_resident_bytes; }
+
+	private:
+		void spill_cold_pages();
+		void recall_cold_pages() noexcept;
+		std::size_t round_down_to_page(std::size_t offset) const noexcept { return offset & ~(m_page_size - 1); }
+
+		static constexpr std::size_t minimum_alignment = alignof(std::max_align_t); // Sizes are rounded up to this, so that only over-aligned allocations leave padding below them
+
+		struct trailer
+		{
+			std::size_t start; // The bump point before this allocation, ie. it's offset less any padding below it
+			bool returned;
+		};
+
+		static constexpr std::size_t trailer_size = (sizeof(trailer) + (minimum_alignment - 1)) & ~(minimum_alignment - 1);
+
+		trailer* trailer_at(std::size_t offset) const noexcept { return reinterpret_cast<trailer*>(m_base + offset); }
+
+		mutable std::mutex m_mutex;
+		char* m_base;
+		int m_file;
+		std::size_t m_capacity;
+		std::size_t m_resident_bytes;
+		std::size_t m_page_size;
+		std::size_t m_granularity; // Spilling, recalling and releasing happen in steps of at least this many bytes, so that a bump point oscillating across a boundary is cheap
+		std::size_t m_cursor;
+		std::size_t m_spilled; // Offset below which pages have been written back and dropped
+		std::size_t m_high_water; // Offset below which pages may hold file data
+	};
+
+
+
+	// Allocator drawing from a file_backed_resource, which must be supplied as it names the backing file. Usable as the allocator for plf::stack and plf::colony.
+	// Copies (including rebound copies) share the resource, and the resource propagates with the container's contents.
+	template <class T>
+	class file_backed_allocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		template <class U>
+		struct rebind
+		{
+			using other = file_backed_allocator<U>;
+		};
+
+		explicit file_backed_allocator(file_backed_resource& resource) noexcept : m_resource(&resource) {}
+
+		template <class U>
+		file_backed_allocator(const file_backed_allocator<U>& other) noexcept : m_resource(other.resource()) {}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > std::size_t(-1) / sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			m_resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		file_backed_resource* resource() const noexcept { return m_resource; }
+
+	private:
+		file_backed_resource* m_resource;
+	};
+
+	template <class T, class U>
+	bool operator==(const file_backed_allocator<T>& lhs, const file_backed_allocator<U>& rhs) noexcept
+	{
+		return lhs.resource() == rhs.resource();
+	}
+
+	template <class T, class U>
+	bool operator!=(const file_backed_allocator<T>& lhs, const file_backed_allocator<U>& rhs) noexcept
+	{
+		return lhs.resource() != rhs.resource();
+	}
+}
+
+
+
+// Implementation:
+
+inline sg14::file_backed_resource::file_backed_resource(const char* path, std::size_t resident_bytes, std::size_t capacity)
+	: m_base(nullptr)
+	, m_file(-1)
+	, m_capacity(capacity)
+	, m_resident_bytes(resident_bytes)
+	, m_page_size(4096)
+	, m_granularity(4096)
+	, m_cursor(0)
+	, m_spilled(0)
+	, m_high_water(0)
+{
+#if defined(__linux__)
+	const long page_size = sysconf(_SC_PAGESIZE);
+
+	if (page_size > 0)
+	{
+		m_page_size = static_cast<std::size_t>(page_size);
+	}
+
+	m_capacity = (capacity + (m_page_size - 1)) & ~(m_page_size - 1);
+	m_granularity = round_down_to_page(resident_bytes / 4);
+	m_granularity = (m_granularity < m_page_size) ? m_page_size : m_granularity;
+
+	m_file = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+
+	if (m_file == -1)
+	{
+		throw std::system_error(errno, std::generic_category(), "file_backed_resource: cannot open backing file");
+	}
+
+	unlink(path);
+
+	if (ftruncate(m_file, static_cast<off_t>(m_capacity)) != 0)
+	{
+		const int error = errno;
+		close(m_file);
+		throw std::system_error(error, std::generic_category(), "file_backed_resource: cannot size backing file");
+	}
+
+	void* const mapping = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, m_file, 0);
+
+	if (mapping == MAP_FAILED)
+	{
+		const int error = errno;
+		close(m_file);
+		throw std::system_error(error, std::generic_category(), "file_backed_resource: cannot map backing file");
+	}
+
+	m_base = static_cast<char*>(mapping);
+#else
+	(void)path;
+#endif
+}
+
+inline sg14::file_backed_resource::~file_backed_resource()
+{
+#if defined(__linux__)
+	munmap(m_base, m_capacity);
+	close(m_file);
+#endif
+}
+
+inline void sg14::file_backed_resource::spill_cold_pages()
+{
+#if defined(__linux__)
+	const std::size_t new_spilled = (m_cursor > m_resident_bytes) ? round_down_to_page(m_cursor - m_resident_bytes) : 0;
+
+	if (new_spilled < m_spilled + m_granularity)
+	{
+		return;
+	}
+
+	// Write the pages back so that they are clean, then drop them both from this mapping and from the page cache:
+	char* const first = m_base + m_spilled;
+	const std::size_t length = new_spilled - m_spilled;
+	msync(first, length, MS_SYNC);
+	madvise(first, length, MADV_DONTNEED);
+	posix_fadvise(m_file, static_cast<off_t>(m_spilled), static_cast<off_t>(length), POSIX_FADV_DONTNEED);
+	m_spilled = new_spilled;
+#endif
+}
+
+inline void sg14::file_backed_resource::recall_cold_pages() noexcept
+{
+#if defined(__linux__)
+	const std::size_t new_spilled = (m_cursor > m_resident_bytes) ? round_down_to_page(m_cursor - m_resident_bytes) : 0;
+
+	if (new_spilled + m_granularity <= m_spilled)
+	{
+		// Start reading back the pages that have come within the resident window, ahead of the pops that will touch them:
+		madvise(m_base + new_spilled, m_spilled - new_spilled, MADV_WILLNEED);
+		m_spilled = new_spilled;
+	}
+
+	// Release the file blocks (and any page cache) above the bump point, so that a container which has shrunk gives back it's disk space:
+	const std::size_t in_use = (m_cursor + (m_page_size - 1)) & ~(m_page_size - 1);
+
+	if (in_use + m_granularity <= m_high_water)
+	{
+		madvise(m_base + in_use, m_high_water - in_use, MADV_REMOVE);
+		m_high_water = in_use;
+	}
+#endif
+}
+
+inline void* sg14::file_backed_resource::allocate(std::size_t bytes, std::size_t alignment)
+{
+	assert((alignment & (alignment - 1)) == 0);
+
+#if defined(__linux__)
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const std::size_t offset = (alignment > minimum_alignment) ? ((m_cursor + (alignment - 1)) & ~(alignment - 1)) : m_cursor;
+
+	if (bytes > m_capacity || offset > m_capacity)
+	{
+		throw std::bad_alloc();
+	}
+
+	bytes = (bytes == 0) ? minimum_alignment : ((bytes + (minimum_alignment - 1)) & ~(minimum_alignment - 1));
+
+	if (bytes > m_capacity - offset || trailer_size > m_capacity - offset - bytes)
+	{
+		throw std::bad_alloc();
+	}
+
+	new (m_base + offset + bytes) trailer{m_cursor, false};
+	m_cursor = offset + bytes + trailer_size;
+	m_high_water = (m_cursor > m_high_water) ? m_cursor : m_high_water;
+	spill_cold_pages();
+	return m_base + offset;
+#else
+	(void)alignment;
+	return ::operator new(bytes);
+#endif
+}
+
+inline void sg14::file_backed_resource::deallocate(void* p, std::size_t bytes, std::size_t) noexcept
+{
+	if (p == nullptr)
+	{
+		return;
+	}
+
+#if defined(__linux__)
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const std::size_t end = static_cast<std::size_t>(static_cast<char*>(p) - m_base) + ((bytes == 0) ? minimum_alignment : ((bytes + (minimum_alignment - 1)) & ~(minimum_alignment - 1)));
+	trailer_at(end)->returned = true;
+
+	if (end + trailer_size != m_cursor)
+	{
+		return; // Still below live allocations
+	}
+
+	// Lower the bump point past this allocation and any returned allocations it uncovers, along with the padding below each:
+	do
+	{
+		m_cursor = trailer_at(m_cursor - trailer_size)->start;
+	} while (m_cursor != 0 && trailer_at(m_cursor - trailer_size)->returned);
+
+	recall_cold_pages();
+#else
+	(void)bytes;
+	::operator delete(p);
+#endif
+}
+
+#endif // SG14_FILE_BACKED_ALLOCATOR_H
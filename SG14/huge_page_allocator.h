@@ -0,0 +1,311 @@
+#ifndef SG14_HUGE_PAGE_ALLOCATOR_H
+#define SG14_HUGE_PAGE_ALLOCATOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+	#include <sys/mman.h>
+#endif
+
+namespace sg14
+{
+	// Carves allocations out of 2MB regions aligned to 2MB, so that a container's blocks (eg. plf::colony or plf::stack groups) share huge pages rather than being scattered over 4K pages.
+	// On Linux each region is first requested from the explicit huge page pool (mmap with MAP_HUGETLB). If the pool is empty or unconfigured, an ordinary mapping is aligned to 2MB and marked
+	// MADV_HUGEPAGE so that transparent huge pages can back it. Elsewhere regions come from the global heap.
+	// Allocations are bumped out of the current region; a region is reused once all of it's allocations have been returned, and unmapped (bar one spare) afterwards.
+	// Allocations too large for a region get a dedicated mapping, rounded up to a multiple of 2MB. Thread-safe.
+	class huge_page_resource
+	{
+	public:
+		static constexpr std::size_t region_size = std::size_t(2) << 20;
+
+		huge_page_resource() noexcept;
+		~huge_page_resource();
+
+		huge_page_resource(const huge_page_resource&) = delete;
+		huge_page_resource& operator=(const huge_page_resource&) = delete;
+
+		void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+		void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+		// Number of regions mapped so far from the explicit huge page pool and from ordinary (transparent huge page advised) memory respectively:
+		std::size_t explicit_huge_page_regions() const noexcept { return m_explicit_regions; }
+		std::size_t transparent_huge_page_regions() const noexcept { return m_transparent_regions; }
+
+		// Shared resource used by default-constructed huge_page_allocators. Never destroyed, so that it outlives containers with static storage duration:
+		static huge_page_resource& default_resource();
+
+	private:
+		struct region
+		{
+			std::size_t mapped_size;
+			std::size_t live_allocations;
+			void* base; // start of the underlying allocation, where it differs from the region itself
+		};
+
+		static constexpr std::size_t header_size = 64;
+
+		static region* region_of(void* p) noexcept { return reinterpret_cast<region*>(reinterpret_cast<std::uintptr_t>(p) & ~(region_size - 1)); }
+		static char* region_begin(region* r) noexcept { return reinterpret_cast<char*>(r) + header_size; }
+		static char* align_up(char* p, std::size_t alignment) noexcept;
+		region* map_region(std::size_t size);
+		static void unmap_region(region* r) noexcept;
+
+		std::mutex m_mutex;
+		region* m_current;
+		region* m_spare;
+		char* m_cursor;
+		std::size_t m_explicit_regions;
+		std::size_t m_transparent_regions;
+	};
+
+
+
+	// Allocator drawing from a huge_page_resource - the shared default resource unless one is supplied. Usable as the allocator for plf::colony and plf::stack, whose rebound
+	// group and element allocations then come from the same regions. Copies (including rebound copies) share the resource, and the resource propagates with the container's contents.
+	template <class T>
+	class huge_page_allocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+		template <class U>
+		struct rebind
+		{
+			using other = huge_page_allocator<U>;
+		};
+
+		huge_page_allocator() : m_resource(&huge_page_resource::default_resource()) {}
+		explicit huge_page_allocator(huge_page_resource& resource) noexcept : m_resource(&resource) {}
+
+		template <class U>
+		huge_page_allocator(const huge_page_allocator<U>& other) noexcept : m_resource(other.resource()) {}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > std::size_t(-1) / sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			m_resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		huge_page_resource* resource() const noexcept { return m_resource; }
+
+	private:
+		huge_page_resource* m_resource;
+	};
+
+	template <class T, class U>
+	bool operator==(const huge_page_allocator<T>& lhs, const huge_page_allocator<U>& rhs) noexcept
+	{
+		return lhs.resource() == rhs.resource();
+	}
+
+	template <class T, class U>
+	bool operator!=(const huge_page_allocator<T>& lhs, const huge_page_allocator<U>& rhs) noexcept
+	{
+		return lhs.resource() != rhs.resource();
+	}
+}
+
+
+
+// Implementation:
+
+inline sg14::huge_page_resource::huge_page_resource() noexcept
+	: m_current(nullptr)
+	, m_spare(nullptr)
+	, m_cursor(nullptr)
+	, m_explicit_regions(0)
+	, m_transparent_regions(0)
+{
+}
+
+inline sg14::huge_page_resource::~huge_page_resource()
+{
+	// Regions with outstanding allocations other than the current one are not tracked, as they are unmapped by their final deallocation:
+	if (m_current != nullptr && m_current->live_allocations == 0)
+	{
+		unmap_region(m_current);
+	}
+
+	if (m_spare != nullptr)
+	{
+		unmap_region(m_spare);
+	}
+}
+
+inline sg14::huge_page_resource& sg14::huge_page_resource::default_resource()
+{
+	static huge_page_resource* const resource = new huge_page_resource();
+	return *resource;
+}
+
+inline char* sg14::huge_page_resource::align_up(char* p, std::size_t alignment) noexcept
+{
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+	return p + ((alignment - (address & (alignment - 1))) & (alignment - 1));
+}
+
+inline sg14::huge_page_resource::region* sg14::huge_page_resource::map_region(std::size_t size)
+{
+	void* base = nullptr;
+	char* aligned = nullptr;
+
+#if defined(__linux__)
+	#ifdef MAP_HUGETLB
+		aligned = static_cast<char*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0));
+
+		if (aligned == MAP_FAILED)
+		{
+			aligned = nullptr;
+		}
+		else
+		{
+			++m_explicit_regions;
+		}
+	#endif
+
+	if (aligned == nullptr)
+	{
+		// Over-map by a region so that a 2MB-aligned range can be kept, then return the slack either side:
+		char* const mapping = static_cast<char*>(mmap(nullptr, size + region_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+		if (mapping == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+
+		aligned = align_up(mapping, region_size);
+		const std::size_t front_slack = static_cast<std::size_t>(aligned - mapping);
+
+		if (front_slack != 0)
+		{
+			munmap(mapping, front_slack);
+		}
+
+		munmap(aligned + size, region_size - front_slack);
+
+		#ifdef MADV_HUGEPAGE
+			madvise(aligned, size, MADV_HUGEPAGE);
+		#endif
+
+		++m_transparent_regions;
+	}
+#else
+	base = ::operator new(size + region_size);
+	aligned = align_up(static_cast<char*>(base), region_size);
+	++m_transparent_regions;
+#endif
+
+	region* const r = reinterpret_cast<region*>(aligned);
+	r->mapped_size = size;
+	r->live_allocations = 0;
+	r->base = base;
+	return r;
+}
+
+inline void sg14::huge_page_resource::unmap_region(region* r) noexcept
+{
+#if defined(__linux__)
+	munmap(r, r->mapped_size);
+#else
+	::operator delete(r->base);
+#endif
+}
+
+inline void* sg14::huge_page_resource::allocate(std::size_t bytes, std::size_t alignment)
+{
+	assert((alignment & (alignment - 1)) == 0 && alignment <= region_size / 2);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (bytes > region_size - header_size - alignment)
+	{
+		if (bytes > std::size_t(-1) - header_size - alignment - region_size)
+		{
+			throw std::bad_alloc();
+		}
+
+		// Dedicated mapping - the returned pointer lies within the first 2MB, so region_of() still finds the header on deallocation:
+		region* const r = map_region(((header_size + alignment + bytes) + (region_size - 1)) & ~(region_size - 1));
+		r->live_allocations = 1;
+		return align_up(region_begin(r), alignment);
+	}
+
+	if (m_current != nullptr)
+	{
+		char* const p = align_up(m_cursor, alignment);
+
+		if (bytes <= static_cast<std::size_t>(reinterpret_cast<char*>(m_current) + region_size - p))
+		{
+			m_cursor = p + bytes;
+			++m_current->live_allocations;
+			return p;
+		}
+
+		// The current region is retired here - it will be unmapped (or become the spare) when it's last allocation is returned:
+	}
+
+	if (m_spare != nullptr)
+	{
+		m_current = m_spare;
+		m_spare = nullptr;
+	}
+	else
+	{
+		m_current = map_region(region_size);
+	}
+
+	char* const p = align_up(region_begin(m_current), alignment);
+	m_cursor = p + bytes;
+	m_current->live_allocations = 1;
+	return p;
+}
+
+inline void sg14::huge_page_resource::deallocate(void* p, std::size_t, std::size_t) noexcept
+{
+	if (p == nullptr)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	region* const r = region_of(p);
+
+	if (--r->live_allocations != 0)
+	{
+		return;
+	}
+
+	if (r == m_current)
+	{
+		m_cursor = region_begin(r);
+	}
+	else if (r->mapped_size == region_size && m_spare == nullptr)
+	{
+		m_spare = r;
+	}
+	else
+	{
+		unmap_region(r);
+	}
+}
+
+#endif // SG14_HUGE_PAGE_ALLOCATOR_H
@@ -0,0 +1,235 @@
+#ifndef SG14_MIRRORED_RING_H
+#define SG14_MIRRORED_RING_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace sg14
+{
+	// Byte ring whose storage is mapped twice, back to back, so that the bytes at offset i and i + capacity() are the same memory. The readable bytes, and the free space
+	// after them, are then each one contiguous range however they wrap around the end of the storage: a parser can read straight from read_data() and a producer (or read()
+	// system call) can write straight into write_data(), with no split copies or scratch buffers at the wrap point.
+	// On Linux the storage is an anonymous memfd mapped at both halves of a reserved address range, and the capacity is rounded up to a multiple of the page size.
+	// Elsewhere the storage is a heap buffer of twice the capacity, and commit() copies each write into the other half, which gives the same view at the cost of a copy.
+	// Like ring_span, it is not synchronised - the producer and consumer must be on the same thread, or share a lock.
+	class mirrored_ring
+	{
+	public:
+		using size_type = std::size_t;
+
+		explicit mirrored_ring(size_type min_capacity);
+		~mirrored_ring();
+
+		mirrored_ring(mirrored_ring&& source) noexcept;
+		mirrored_ring& operator=(mirrored_ring&& source) noexcept;
+		mirrored_ring(const mirrored_ring&) = delete;
+		mirrored_ring& operator=(const mirrored_ring&) = delete;
+
+		bool empty() const noexcept { return m_size == 0; }
+		bool full() const noexcept { return m_size == m_capacity; }
+		size_type size() const noexcept { return m_size; }
+		size_type capacity() const noexcept { return m_capacity; }
+		size_type free_space() const noexcept { return m_capacity - m_size; }
+
+		// Consumer - the size() readable bytes, oldest first, then drop the first n of them:
+		const char* read_data() const noexcept { return m_data + m_read_offset; }
+		void consume(size_type n) noexcept;
+
+		// Producer - room for free_space() bytes after the readable ones, then make the first n of them readable:
+		char* write_data() noexcept { return m_data + m_read_offset + m_size; }
+		void commit(size_type n) noexcept;
+
+		// Copying convenience functions, transferring as many bytes as there are room for (write) or are readable (read), and returning how many:
+		size_type write(const void* source, size_type n) noexcept;
+		size_type read(void* destination, size_type n) noexcept;
+
+		void swap(mirrored_ring& rhs) noexcept;
+
+	private:
+		void release() noexcept;
+
+		char* m_data; // Start of the 2 * m_capacity bytes
+		size_type m_capacity;
+		size_type m_read_offset; // Always below m_capacity
+		size_type m_size;
+	};
+}
+
+
+
+// Implementation:
+
+inline sg14::mirrored_ring::mirrored_ring(size_type min_capacity)
+	: m_data(nullptr)
+	, m_capacity(0)
+	, m_read_offset(0)
+	, m_size(0)
+{
+#if defined(__linux__)
+	const long page_size_result = sysconf(_SC_PAGESIZE);
+	const size_type page_size = (page_size_result > 0) ? static_cast<size_type>(page_size_result) : 4096;
+	const size_type capacity = (min_capacity == 0) ? page_size : (min_capacity + (page_size - 1)) & ~(page_size - 1);
+
+	if (capacity < min_capacity || capacity > static_cast<size_type>(-1) / 2)
+	{
+		throw std::bad_alloc();
+	}
+
+	const int file = memfd_create("sg14_mirrored_ring", MFD_CLOEXEC);
+
+	if (file == -1)
+	{
+		throw std::system_error(errno, std::generic_category(), "mirrored_ring: cannot create memory file");
+	}
+
+	if (ftruncate(file, static_cast<off_t>(capacity)) != 0)
+	{
+		const int error = errno;
+		close(file);
+		throw std::system_error(error, std::generic_category(), "mirrored_ring: cannot size memory file");
+	}
+
+	// Reserve the whole range first, so that nothing else can be mapped into the second half between the two file mappings:
+	void* const reserved = mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+	if (reserved == MAP_FAILED)
+	{
+		const int error = errno;
+		close(file);
+		throw std::system_error(error, std::generic_category(), "mirrored_ring: cannot reserve address range");
+	}
+
+	char* const base = static_cast<char*>(reserved);
+
+	if (mmap(base, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0) == MAP_FAILED ||
+		mmap(base + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0) == MAP_FAILED)
+	{
+		const int error = errno;
+		munmap(base, capacity * 2);
+		close(file);
+		throw std::system_error(error, std::generic_category(), "mirrored_ring: cannot map memory file");
+	}
+
+	close(file); // The mappings keep the file alive
+	m_data = base;
+	m_capacity = capacity;
+#else
+	m_capacity = (min_capacity == 0) ? 1 : min_capacity;
+
+	if (m_capacity > static_cast<size_type>(-1) / 2)
+	{
+		throw std::bad_alloc();
+	}
+
+	m_data = static_cast<char*>(::operator new(m_capacity * 2));
+#endif
+}
+
+inline sg14::mirrored_ring::~mirrored_ring()
+{
+	release();
+}
+
+inline sg14::mirrored_ring::mirrored_ring(mirrored_ring&& source) noexcept
+	: m_data(source.m_data)
+	, m_capacity(source.m_capacity)
+	, m_read_offset(source.m_read_offset)
+	, m_size(source.m_size)
+{
+	source.m_data = nullptr;
+	source.m_capacity = source.m_read_offset = source.m_size = 0;
+}
+
+inline sg14::mirrored_ring& sg14::mirrored_ring::operator=(mirrored_ring&& source) noexcept
+{
+	if (this != &source)
+	{
+		release();
+		swap(source);
+	}
+
+	return *this;
+}
+
+inline void sg14::mirrored_ring::release() noexcept
+{
+	if (m_data != nullptr)
+	{
+	#if defined(__linux__)
+		munmap(m_data, m_capacity * 2);
+	#else
+		::operator delete(m_data);
+	#endif
+
+		m_data = nullptr;
+		m_capacity = m_read_offset = m_size = 0;
+	}
+}
+
+inline void sg14::mirrored_ring::consume(size_type n) noexcept
+{
+	assert(n <= m_size);
+	m_size -= n;
+	m_read_offset += n;
+	m_read_offset = (m_read_offset < m_capacity) ? m_read_offset : m_read_offset - m_capacity;
+}
+
+inline void sg14::mirrored_ring::commit(size_type n) noexcept
+{
+	assert(n <= m_capacity - m_size);
+
+#if !defined(__linux__)
+	// Copy the new bytes into the other half - those written below m_capacity go up, those written above it go down. Each copy is skipped when empty, as it's destination
+	// would then lie outside the buffer:
+	const size_type start = m_read_offset + m_size;
+	const size_type lower = (start < m_capacity) ? ((n < m_capacity - start) ? n : m_capacity - start) : 0;
+
+	if (lower != 0)
+	{
+		std::memcpy(m_data + start + m_capacity, m_data + start, lower);
+	}
+
+	if (n != lower)
+	{
+		std::memcpy(m_data + start + lower - m_capacity, m_data + start + lower, n - lower);
+	}
+#endif
+
+	m_size += n;
+}
+
+inline sg14::mirrored_ring::size_type sg14::mirrored_ring::write(const void* source, size_type n) noexcept
+{
+	n = (n < m_capacity - m_size) ? n : m_capacity - m_size;
+	std::memcpy(write_data(), source, n);
+	commit(n);
+	return n;
+}
+
+inline sg14::mirrored_ring::size_type sg14::mirrored_ring::read(void* destination, size_type n) noexcept
+{
+	n = (n < m_size) ? n : m_size;
+	std::memcpy(destination, read_data(), n);
+	consume(n);
+	return n;
+}
+
+inline void sg14::mirrored_ring::swap(mirrored_ring& rhs) noexcept
+{
+	std::swap(m_data, rhs.m_data);
+	std::swap(m_capacity, rhs.m_capacity);
+	std::swap(m_read_offset, rhs.m_read_offset);
+	std::swap(m_size, rhs.m_size);
+}
+
+#endif // SG14_MIRRORED_RING_H
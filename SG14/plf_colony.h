@@ -110,15 +110,21 @@
 
 
 
+// Optional features, enabled by defining the macro before including this header:
+// PLF_COLONY_CHANGE_TRACKING - each group records inserted, erased and modified slots in a compact bitset, see for_each_change() and reset_changes(). When undefined, colony has no additional size or speed overhead.
+
+
+
 #include <cstring>	// memset, memcpy, memmove
 #include <cassert>	// assert
 #include <limits>  // std::numeric_limits
 #include <memory>	// std::uninitialized_copy, std::allocator
 #include <iterator> // std::bidirectional_iterator_tag
+#include <climits> // CHAR_BIT
 
 
-#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-	#include <type_traits> // std::is_trivially_destructible, etc
+#if defined(PLF_COLONY_TYPE_TRAITS_SUPPORT) || defined(PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT)
+	#include <type_traits> // std::is_trivially_destructible, std::true_type, etc
 #endif
 
 #ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
@@ -135,6 +141,20 @@ namespace plf
 {
 
 
+// Whether an element can be moved to a new address by copying it's bytes, after which the original is discarded without it's destructor being run - colony::transfer() relocates
+// such elements instead of move-constructing and destroying them. Trivially-copyable types qualify. Specialise as true for other types which do, eg. a handle owning a heap pointer:
+template <class element_type>
+struct colony_is_trivially_relocatable
+{
+	#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+		static const bool value = std::is_trivially_copyable<element_type>::value;
+	#else
+		static const bool value = false;
+	#endif
+};
+
+
+
 template <class element_type, class element_allocator_type = std::allocator<element_type>, typename element_skipfield_type = unsigned short > class colony : private element_allocator_type  // Empty base class optimisation - inheriting allocator functions
 // Note: unsigned short is equivalent to uint_least16_t ie. Using 16-bit integer in best-case scenario, > or < 16-bit integer in case where platform doesn't support 16-bit types
 {
@@ -231,7 +251,8 @@ private:
 
 
 			#ifdef PLF_COLONY_VARIADICS_SUPPORT
-				group(const size_type elements_per_group, stack_group_pointer_type const previous = NULL):
+				group(const element_pointer_allocator_type &alloc, const size_type elements_per_group, stack_group_pointer_type const previous = NULL):
+					element_pointer_allocator_type(alloc),
 					elements(PLF_COLONY_ALLOCATE_INITIALIZATION(element_pointer_allocator_type, elements_per_group, (previous == NULL) ? 0 : previous->elements)),
 					next_group(NULL),
 					previous_group(previous),
@@ -240,7 +261,8 @@ private:
 
 			#else
 				// This is a hack around the fact that element_pointer_allocator_type::construct only supports copy construction in C++03 and copy elision does not occur on the vast majority of compilers in this circumstance. And to avoid running out of memory (and performance loss) from allocating the same block twice, we're allocating in this constructor and moving data in the copy constructor.
-				group(const size_type elements_per_group, stack_group_pointer_type const previous = NULL):
+				group(const element_pointer_allocator_type &alloc, const size_type elements_per_group, stack_group_pointer_type const previous = NULL):
+					element_pointer_allocator_type(alloc),
 					elements(NULL),
 					next_group(reinterpret_cast<stack_group_pointer_type>(elements_per_group)), // Guaranteed by the standard to be safe on any platform where size_type bitdepth == pointer bitdepth (ie. all known platforms)
 					previous_group(previous),
@@ -273,7 +295,7 @@ private:
 		struct ebco_pair : stack_group_allocator_type // Packaging the group allocator with least-used member variable, for empty-base-class optimisation
 		{
 			size_type min_elements_per_group;
-			ebco_pair(const size_type min_elements) : min_elements_per_group(min_elements) {};
+			ebco_pair(const size_type min_elements, const element_pointer_allocator_type &alloc) : stack_group_allocator_type(alloc), min_elements_per_group(min_elements) {};
 		}						group_allocator_pair;
 
 		friend class colony;
@@ -281,7 +303,7 @@ private:
 
 	public:
 
-		explicit reduced_stack(const size_type min_allocation_amount = 8, const element_pointer_allocator_type &alloc = element_pointer_allocator_type()):
+		reduced_stack(const size_type min_allocation_amount, const element_allocator_type &alloc):
 			element_pointer_allocator_type(alloc),
 			current_group(NULL),
 			first_group(NULL),
@@ -289,7 +311,7 @@ private:
 			start_element(NULL),
 			end_element(NULL),
 			total_number_of_elements(0),
-			group_allocator_pair(min_allocation_amount)
+			group_allocator_pair(min_allocation_amount, *this)
 		{}
 
 
@@ -301,7 +323,7 @@ private:
 			start_element(NULL),
 			end_element(NULL),
 			total_number_of_elements(source.total_number_of_elements),
-			group_allocator_pair(source.group_allocator_pair.min_elements_per_group)
+			group_allocator_pair(source.group_allocator_pair.min_elements_per_group, source)
 		{
 			if (total_number_of_elements == 0)
 			{
@@ -338,7 +360,7 @@ private:
 				start_element(std::move(source.start_element)),
 				end_element(std::move(source.end_element)),
 				total_number_of_elements(source.total_number_of_elements),
-				group_allocator_pair(source.group_allocator_pair.min_elements_per_group)
+				group_allocator_pair(source.group_allocator_pair.min_elements_per_group, source)
 			{
 				// Nullify source object's contents - only first_group and total_number_of_elements required for destructor:
 				source.first_group = NULL;
@@ -438,9 +460,9 @@ private:
 			try
 			{
 				#ifdef PLF_COLONY_VARIADICS_SUPPORT
-					PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, first_group, first_group_size);
+					PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, first_group, static_cast<const element_pointer_allocator_type &>(*this), first_group_size);
 				#else
-					PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, first_group, group(first_group_size));
+					PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, first_group, group(*this, first_group_size));
 				#endif
 			}
 			catch (...)
@@ -476,9 +498,9 @@ private:
 						try
 						{
 							#ifdef PLF_COLONY_VARIADICS_SUPPORT
-								PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, current_group->next_group, (total_number_of_elements < std::numeric_limits<size_type>::max() / 2) ? total_number_of_elements : std::numeric_limits<size_type>::max() / 2, current_group);
+								PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, current_group->next_group, static_cast<const element_pointer_allocator_type &>(*this), (total_number_of_elements < std::numeric_limits<size_type>::max() / 2) ? total_number_of_elements : std::numeric_limits<size_type>::max() / 2, current_group);
 							#else
-								PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, current_group->next_group, group((total_number_of_elements < std::numeric_limits<size_type>::max() / 2) ? total_number_of_elements : std::numeric_limits<size_type>::max() / 2, current_group));
+								PLF_COLONY_CONSTRUCT(stack_group_allocator_type, group_allocator_pair, current_group->next_group, group(*this, (total_number_of_elements < std::numeric_limits<size_type>::max() / 2) ? total_number_of_elements : std::numeric_limits<size_type>::max() / 2, current_group));
 							#endif
 						}
 						catch (...)
@@ -559,6 +581,32 @@ private:
 
 
 
+		// Empties the stack but retains it's groups for reuse, leaving it in the same state as if every element had been popped:
+		void reset() PLF_COLONY_NOEXCEPT
+		{
+			#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+				if (!(std::is_trivially_destructible<stack_element_type>::value))
+			#endif
+			{
+				while (total_number_of_elements != 0)
+				{
+					pop();
+				}
+			}
+
+			total_number_of_elements = 0;
+
+			if (first_group != NULL)
+			{
+				current_group = first_group;
+				start_element = first_group->elements;
+				top_element = start_element - 1;
+				end_element = first_group->end;
+			}
+		}
+
+
+
 		void swap(reduced_stack &source) PLF_COLONY_NOEXCEPT_SWAP(element_pointer_allocator_type)
 		{
 			#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
@@ -592,7 +640,7 @@ private:
 
 
 	// Colony groups:
-	struct group : private uchar_allocator_type	// Empty base class optimisation - inheriting allocator functions
+	struct group : private element_allocator_type	// Empty base class optimisation - inheriting allocator functions
 	{
 		element_pointer_type				last_endpoint; // the address that is one past the highest cell number that's been used so far in this group - does not change with erase command - is necessary because an iterator cannot access the colony's end_iterator - also used to determine whether erasures have occured in the group by negating 'elements' and comparing with 'number_of_elements' - useful for some functions
 		group_pointer_type					next_group;
@@ -602,44 +650,90 @@ private:
 		size_type							group_number; // Used for comparison (> < >= <=) iterator operators (used by distance function and user)
 		skipfield_type						number_of_elements; // indicates total number of used cells - changes with insert and erase commands - used to check for empty group in erase function, as indication to remove group
 		const skipfield_type				size; // The number of elements this particular group can house
+		size_type							version; // stamped from the colony's version_counter when the group is created or reused, and on every insertion or erasure in it - frozen_view stores the version it saw for each group, so freeze() can tell which groups have changed since it's last call
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			const uchar_pointer_type		change_bits; // three bit-planes (inserted, erased, modified) of change_plane_size() bytes each, allocated directly after the skipfield
+		#endif
+
+
+
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			static inline size_type change_plane_size(const skipfield_type elements_per_group) PLF_COLONY_NOEXCEPT
+			{
+				return (static_cast<size_type>(elements_per_group) + CHAR_BIT - 1) / CHAR_BIT;
+			}
+		#endif
+
+
+
+		// Elements, skipfield (size + 1 nodes) and change-log bits (if enabled) are allocated as a single block.
+		// The block is allocated in units of element_type rather than bytes, so that allocators which align to the requested type (eg. memory resources) align it for the elements:
+		static inline size_type allocation_size(const skipfield_type elements_per_group) PLF_COLONY_NOEXCEPT
+		{
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				const size_type bytes = (elements_per_group * sizeof(element_type)) + ((elements_per_group + 1) * sizeof(skipfield_type)) + (3 * change_plane_size(elements_per_group));
+			#else
+				const size_type bytes = (elements_per_group * sizeof(element_type)) + ((elements_per_group + 1) * sizeof(skipfield_type));
+			#endif
+
+			return (bytes + sizeof(element_type) - 1) / sizeof(element_type);
+		}
 
 
 
 		#ifdef PLF_COLONY_VARIADICS_SUPPORT
-			group(const skipfield_type elements_per_group, group_pointer_type const previous = NULL):
-				last_endpoint(reinterpret_cast<element_pointer_type>(PLF_COLONY_ALLOCATE_INITIALIZATION(uchar_allocator_type, ((elements_per_group * (sizeof(element_type))) + ((elements_per_group + 1) * sizeof(skipfield_type))), (previous == NULL) ? 0 : previous->elements))), /* allocating to here purely because it is first in the struct sequence - actual pointer is elements, last_endpoint is simply initialised to element's base value initially */
+			group(const group_allocator_type &alloc, const skipfield_type elements_per_group, group_pointer_type const previous = NULL):
+				element_allocator_type(alloc),
+				last_endpoint(PLF_COLONY_ALLOCATE_INITIALIZATION(element_allocator_type, allocation_size(elements_per_group), (previous == NULL) ? 0 : previous->elements)), /* allocating to here purely because it is first in the struct sequence - actual pointer is elements, last_endpoint is simply initialised to element's base value initially */
 				next_group(NULL),
 				elements(last_endpoint++),
 				skipfield(reinterpret_cast<skipfield_pointer_type>(elements + elements_per_group)),
 				previous_group(previous),
 				group_number((previous == NULL) ? 0 : previous->group_number + 1),
 				number_of_elements(1),
-				size(elements_per_group)
+				size(elements_per_group),
+				version(0)
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					, change_bits(reinterpret_cast<uchar_pointer_type>(skipfield + elements_per_group + 1))
+				#endif
 			{
 				// Static casts to unsigned int from short not necessary as C++ automatically promotes lesser types for arithmetic purposes.
 				std::memset(&*skipfield, 0, sizeof(skipfield_type) * (size + 1)); // &* to avoid problems with non-trivial pointers - size + 1 to allow for computationally-faster operator ++ and other operations - extra field is unused but checked - not having it will result in out-of-bounds checks
+
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					std::memset(&*change_bits, 0, 3 * change_plane_size(size));
+				#endif
 			}
 
 		#else
 			// This is a hack around the fact that element_allocator_type::construct only supports copy construction in C++03 and copy elision does not occur on the vast majority of compilers in this circumstance. And to avoid running out of memory (and performance loss) from allocating the same block twice, we're allocating in this constructor and moving data in the copy constructor.
-			group(const skipfield_type elements_per_group, group_pointer_type const previous = NULL):
-				last_endpoint(reinterpret_cast<element_pointer_type>(PLF_COLONY_ALLOCATE_INITIALIZATION(uchar_allocator_type, ((elements_per_group * (sizeof(element_type))) + ((elements_per_group + 1) * sizeof(skipfield_type))), (previous == NULL) ? 0 : previous->elements))), /* allocating to here purely because it is first in the struct sequence - actual pointer is elements, last_endpoint is simply initialised to element's base value initially */
+			group(const group_allocator_type &alloc, const skipfield_type elements_per_group, group_pointer_type const previous = NULL):
+				element_allocator_type(alloc),
+				last_endpoint(PLF_COLONY_ALLOCATE_INITIALIZATION(element_allocator_type, allocation_size(elements_per_group), (previous == NULL) ? 0 : previous->elements)), /* allocating to here purely because it is first in the struct sequence - actual pointer is elements, last_endpoint is simply initialised to element's base value initially */
 				next_group(NULL),
 				elements(NULL),
 				skipfield(reinterpret_cast<skipfield_pointer_type>(last_endpoint + elements_per_group)),
 				previous_group(previous),
 				group_number((previous == NULL) ? 0 : previous->group_number + 1),
-				size(elements_per_group)
+				size(elements_per_group),
+				version(0)
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					, change_bits(reinterpret_cast<uchar_pointer_type>(skipfield + elements_per_group + 1))
+				#endif
 			{
 				// Static casts to unsigned int from short not necessary as C++ automatically promotes lesser types for arithmetic purposes.
 				std::memset(&*skipfield, 0, sizeof(skipfield_type) * (size + 1)); // &* to avoid problems with non-trivial pointers - size + 1 to allow for computationally-faster operator ++ and other operations - extra field is unused but checked - not having it will result in out-of-bounds checks
+
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					std::memset(&*change_bits, 0, 3 * change_plane_size(size));
+				#endif
 			}
 
 
 
 			// Not a real copy constructor ie. actually a move constructor. Only used for allocator.construct in C++03 for reasons stated above:
 			group(const group &source) PLF_COLONY_NOEXCEPT:
-				uchar_allocator_type(source),
+				element_allocator_type(source),
 				last_endpoint(source.last_endpoint + 1),
 				next_group(NULL),
 				elements(source.last_endpoint),
@@ -647,16 +741,38 @@ private:
 				previous_group(source.previous_group),
 				group_number(source.group_number),
 				number_of_elements(1),
-				size(source.size)
+				size(source.size),
+				version(0)
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					, change_bits(source.change_bits)
+				#endif
 			{}
 		#endif
 
 
 
+		// Returns a group retained by clear(true) to the state of a newly-constructed group. Skipfield nodes past the last used element are always zero, so only the used portion needs zeroing:
+		void reset(group_pointer_type const previous) PLF_COLONY_NOEXCEPT
+		{
+			std::memset(&*skipfield, 0, sizeof(skipfield_type) * ((last_endpoint - elements) + 1));
+
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				std::memset(&*change_bits, 0, 3 * change_plane_size(size));
+			#endif
+
+			last_endpoint = elements + 1;
+			next_group = NULL;
+			previous_group = previous;
+			group_number = (previous == NULL) ? 0 : previous->group_number + 1;
+			number_of_elements = 1;
+		}
+
+
+
 		~group() PLF_COLONY_NOEXCEPT
 		{
 			// Null check not necessary (for copied group as above) as delete will ignore.
-			PLF_COLONY_DEALLOCATE(uchar_allocator_type, (*this), reinterpret_cast<uchar_pointer_type>(elements), (size * sizeof(element_type)) + ((size + 1) * sizeof(skipfield_type)));
+			PLF_COLONY_DEALLOCATE(element_allocator_type, (*this), elements, allocation_size(size));
 		}
 	};
 
@@ -1238,6 +1354,301 @@ public:
 
 
 
+	// Frozen view: a densely-packed, read-only snapshot of pointers to a colony's elements in iteration order, plus an index map (one entry per group) for getting from a dense index back to a colony iterator.
+	// Filled by colony::freeze(). Subsequent calls to freeze() with the same view only re-walk the skipfields of groups which have had insertions or erasures since the view's last call - other groups have their pointers copied across from the previous snapshot.
+	// Each view records the version of each group it saw, so any number of views can be refreshed incrementally from the same colony.
+	// Note: element values are accessed through the stored pointers, so modifying an element via a colony iterator does not require a re-freeze, but any insertion or erasure does.
+	class frozen_view : private element_pointer_allocator_type  // Empty base class optimisation - inheriting allocator functions
+	{
+	private:
+		struct segment // index map entry
+		{
+			group_pointer_type	group_pointer;
+			size_type			first_index; // index of the first pointer from this group within the dense array
+			size_type			version; // the group's version when it's pointers were taken
+		};
+
+		#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+			typedef typename std::allocator_traits<element_pointer_allocator_type>::template rebind_alloc<segment>	segment_allocator_type;
+			typedef typename std::allocator_traits<segment_allocator_type>::pointer									segment_pointer_type;
+			typedef typename std::allocator_traits<element_pointer_allocator_type>::pointer							dense_pointer_type;
+			typedef typename std::allocator_traits<element_pointer_allocator_type>::const_pointer					dense_const_pointer_type;
+		#else
+			typedef typename element_pointer_allocator_type::template rebind<segment>::other	segment_allocator_type;
+			typedef typename segment_allocator_type::pointer									segment_pointer_type;
+			typedef typename element_pointer_allocator_type::pointer							dense_pointer_type;
+			typedef typename element_pointer_allocator_type::const_pointer						dense_const_pointer_type;
+		#endif
+
+		dense_pointer_type		pointers, back_pointers; // back_pointers is the buffer the next freeze() is built into, before being swapped with pointers
+		size_type				number_of_pointers, pointer_capacity;
+		segment_pointer_type	segments, back_segments;
+		size_type				number_of_segments;
+		const colony *			frozen_colony; // the colony this view was last frozen against - an incremental freeze is only possible against the same colony
+		size_type				frozen_generation; // and it's generation at the time
+		struct ebco_pair : segment_allocator_type // Packaging the segment allocator with least-used member variable, for empty-base-class optimisation
+		{
+			size_type segment_capacity;
+			ebco_pair(const segment_allocator_type &alloc) : segment_allocator_type(alloc), segment_capacity(0) {};
+		}						segment_allocator_pair;
+
+		friend class colony;
+
+		// Non-copyable:
+		frozen_view(const frozen_view &source);
+		frozen_view & operator = (const frozen_view &source);
+
+
+		void destroy_pointers(const dense_pointer_type the_pointers, const size_type number) PLF_COLONY_NOEXCEPT
+		{
+			#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+				if (!(std::is_trivially_destructible<element_pointer_type>::value)) // Should be removed by the compiler for raw pointers
+			#endif
+			{
+				for (dense_pointer_type current = the_pointers; current != the_pointers + number; ++current)
+				{
+					PLF_COLONY_DESTROY(element_pointer_allocator_type, (*this), current);
+				}
+			}
+		}
+
+
+		void destroy_all_data() PLF_COLONY_NOEXCEPT
+		{
+			destroy_pointers(pointers, number_of_pointers);
+
+			if (pointers != NULL)
+			{
+				PLF_COLONY_DEALLOCATE(element_pointer_allocator_type, (*this), pointers, pointer_capacity);
+				PLF_COLONY_DEALLOCATE(element_pointer_allocator_type, (*this), back_pointers, pointer_capacity);
+			}
+
+			if (segments != NULL)
+			{
+				PLF_COLONY_DEALLOCATE(segment_allocator_type, segment_allocator_pair, segments, segment_allocator_pair.segment_capacity);
+				PLF_COLONY_DEALLOCATE(segment_allocator_type, segment_allocator_pair, back_segments, segment_allocator_pair.segment_capacity);
+			}
+		}
+
+
+		// Make sure the back buffers can hold the next snapshot. If the pointer buffers have to grow, the current snapshot is discarded, which forces a full re-walk:
+		void reserve_back_buffers(const size_type required_pointers, const size_type required_segments)
+		{
+			if (required_pointers > pointer_capacity)
+			{
+				const size_type new_capacity = (required_pointers > pointer_capacity * 2) ? required_pointers : pointer_capacity * 2;
+				const dense_pointer_type new_pointers = PLF_COLONY_ALLOCATE(element_pointer_allocator_type, (*this), new_capacity, 0);
+				dense_pointer_type new_back_pointers;
+
+				try
+				{
+					new_back_pointers = PLF_COLONY_ALLOCATE(element_pointer_allocator_type, (*this), new_capacity, 0);
+				}
+				catch (...)
+				{
+					PLF_COLONY_DEALLOCATE(element_pointer_allocator_type, (*this), new_pointers, new_capacity);
+					throw;
+				}
+
+				destroy_pointers(pointers, number_of_pointers);
+
+				if (pointers != NULL)
+				{
+					PLF_COLONY_DEALLOCATE(element_pointer_allocator_type, (*this), pointers, pointer_capacity);
+					PLF_COLONY_DEALLOCATE(element_pointer_allocator_type, (*this), back_pointers, pointer_capacity);
+				}
+
+				pointers = new_pointers;
+				back_pointers = new_back_pointers;
+				pointer_capacity = new_capacity;
+				number_of_pointers = 0;
+				number_of_segments = 0;
+			}
+
+			if (required_segments > segment_allocator_pair.segment_capacity)
+			{
+				const size_type new_capacity = (required_segments > segment_allocator_pair.segment_capacity * 2) ? required_segments : segment_allocator_pair.segment_capacity * 2;
+				const segment_pointer_type new_segments = PLF_COLONY_ALLOCATE(segment_allocator_type, segment_allocator_pair, new_capacity, 0);
+				segment_pointer_type new_back_segments;
+
+				try
+				{
+					new_back_segments = PLF_COLONY_ALLOCATE(segment_allocator_type, segment_allocator_pair, new_capacity, 0);
+				}
+				catch (...)
+				{
+					PLF_COLONY_DEALLOCATE(segment_allocator_type, segment_allocator_pair, new_segments, new_capacity);
+					throw;
+				}
+
+				if (segments != NULL)
+				{
+					std::memcpy(&*new_segments, &*segments, number_of_segments * sizeof(segment)); // segment is always trivially-copyable unless the allocator supplies non-trivial group pointers
+					PLF_COLONY_DEALLOCATE(segment_allocator_type, segment_allocator_pair, segments, segment_allocator_pair.segment_capacity);
+					PLF_COLONY_DEALLOCATE(segment_allocator_type, segment_allocator_pair, back_segments, segment_allocator_pair.segment_capacity);
+				}
+
+				segments = new_segments;
+				back_segments = new_back_segments;
+				segment_allocator_pair.segment_capacity = new_capacity;
+			}
+		}
+
+
+	public:
+
+		explicit frozen_view(const element_pointer_allocator_type &alloc = element_pointer_allocator_type()):
+			element_pointer_allocator_type(alloc),
+			pointers(NULL),
+			back_pointers(NULL),
+			number_of_pointers(0),
+			pointer_capacity(0),
+			segments(NULL),
+			back_segments(NULL),
+			number_of_segments(0),
+			frozen_colony(NULL),
+			frozen_generation(0),
+			segment_allocator_pair(segment_allocator_type(alloc))
+		{}
+
+
+
+		~frozen_view() PLF_COLONY_NOEXCEPT
+		{
+			destroy_all_data();
+		}
+
+
+
+		inline size_type size() const PLF_COLONY_NOEXCEPT
+		{
+			return number_of_pointers;
+		}
+
+
+
+		inline bool empty() const PLF_COLONY_NOEXCEPT
+		{
+			return number_of_pointers == 0;
+		}
+
+
+
+		// Iteration is over the dense array of element pointers:
+		inline dense_const_pointer_type begin() const PLF_COLONY_NOEXCEPT
+		{
+			return pointers;
+		}
+
+
+
+		inline dense_const_pointer_type end() const PLF_COLONY_NOEXCEPT
+		{
+			return pointers + number_of_pointers;
+		}
+
+
+
+		inline const_reference operator [] (const size_type index) const
+		{
+			assert(index < number_of_pointers);
+			return *(pointers[index]);
+		}
+
+
+
+		// Index map - dense index to colony iterator. Only valid until the next insertion or erasure in the colony:
+		const_iterator get_iterator(const size_type index) const
+		{
+			assert(index < number_of_pointers);
+
+			// Find the last segment whose first index is <= index:
+			size_type low = 0, high = number_of_segments;
+
+			while (high - low > 1)
+			{
+				const size_type middle = low + ((high - low) >> 1);
+
+				if (segments[middle].first_index <= index)
+				{
+					low = middle;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			const group_pointer_type the_group = segments[low].group_pointer;
+			const element_pointer_type the_element = pointers[index];
+			return const_iterator(the_group, the_element, the_group->skipfield + (the_element - the_group->elements));
+		}
+
+
+
+		// Index map - colony iterator to dense index. Only valid until the next insertion or erasure in the colony:
+		size_type get_index(const const_iterator &the_iterator) const
+		{
+			assert(the_iterator.group_pointer != NULL);
+
+			// Group numbers ascend along the chain (though are not necessarily contiguous after a range-erase), so binary search the segments by group number:
+			const size_type group_number = the_iterator.group_pointer->group_number;
+			size_type segment_index = 0, high = number_of_segments;
+
+			while (segment_index != high)
+			{
+				const size_type middle = segment_index + ((high - segment_index) >> 1);
+
+				if (segments[middle].group_pointer->group_number < group_number)
+				{
+					segment_index = middle + 1;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			assert(segment_index != number_of_segments && segments[segment_index].group_pointer == the_iterator.group_pointer);
+
+			const size_type segment_end = (segment_index + 1 == number_of_segments) ? number_of_pointers : segments[segment_index + 1].first_index;
+
+			// Pointers within a segment are in ascending address order, so binary search:
+			size_type low = segments[segment_index].first_index;
+			high = segment_end;
+
+			while (low != high)
+			{
+				const size_type middle = low + ((high - low) >> 1);
+
+				if (pointers[middle] < the_iterator.element_pointer)
+				{
+					low = middle + 1;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			assert(low != segment_end && pointers[low] == the_iterator.element_pointer);
+			return low;
+		}
+
+
+
+		void clear() PLF_COLONY_NOEXCEPT
+		{
+			destroy_pointers(pointers, number_of_pointers);
+			number_of_pointers = 0;
+			number_of_segments = 0;
+			frozen_colony = NULL;
+		}
+	}; // frozen_view
+
+
+
+
 private:
 
 	// Used by range-insert and range-constructor to prevent fill-insert and fill-constructor function calls mistakenly resolving to the range insert/constructor
@@ -1254,16 +1665,24 @@ private:
 
 	iterator				end_iterator, begin_iterator;
 	group_pointer_type		first_group;
+	group_pointer_type		unused_groups; // groups retained by clear(true) for reuse, linked by next_group
+	size_type				unused_groups_capacity, number_of_unused_groups; // totals for unused_groups, kept so that capacity() and approximate_memory_use() need not traverse them
 	size_type				total_number_of_elements;
+	size_type				version_counter; // the last version stamped onto a group - see group::version
+	size_type				generation; // advanced whenever this colony takes over another colony's groups, as group versions from the two colonies may coincide - frozen views only reuse pointers from a matching generation
 	skipfield_type 			min_elements_per_group;
 	struct ebco_pair : group_allocator_type // Packaging the group allocator with least-used member variable, for empty-base-class optimisation
 	{
 		skipfield_type max_elements_per_group;
-		ebco_pair(const skipfield_type max_elements) : max_elements_per_group(max_elements) {};
+		ebco_pair(const skipfield_type max_elements, const element_allocator_type &alloc) : group_allocator_type(alloc), max_elements_per_group(max_elements) {};
 	}						group_allocator_pair;
 
 	reduced_stack erased_locations;
 
+	#ifdef PLF_COLONY_CHANGE_TRACKING
+		reduced_stack freed_erasures; // change log entries for erased elements whose groups have since been deallocated
+	#endif
+
 
 public:
 
@@ -1272,10 +1691,18 @@ public:
 	colony():
 		element_allocator_type(element_allocator_type()),
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group((sizeof(element_type) * 8 > (sizeof(*this) + sizeof(group)) * 2) ? 8 : (((sizeof(*this) + sizeof(group)) * 2) / sizeof(element_type)) + 1),
-		group_allocator_pair(std::numeric_limits<skipfield_type>::max()),
-		erased_locations((min_elements_per_group >> 7) + 8)
+		group_allocator_pair(std::numeric_limits<skipfield_type>::max(), *this),
+		erased_locations((min_elements_per_group >> 7) + 8, *this)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, *this)
+		#endif
 	{
 	 	assert(std::numeric_limits<skipfield_type>::is_integer & !std::numeric_limits<skipfield_type>::is_signed); // skipfield type must be of unsigned integer type (uchar, ushort, uint etc)
 	}
@@ -1285,10 +1712,18 @@ public:
 	explicit colony(const element_allocator_type &alloc):
 		element_allocator_type(alloc),
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group((sizeof(element_type) * 8 > (sizeof(*this) + sizeof(group)) * 2) ? 8 : (((sizeof(*this) + sizeof(group)) * 2) / sizeof(element_type)) + 1),
-		group_allocator_pair(std::numeric_limits<skipfield_type>::max()),
-		erased_locations((min_elements_per_group >> 7) + 8)
+		group_allocator_pair(std::numeric_limits<skipfield_type>::max(), alloc),
+		erased_locations((min_elements_per_group >> 7) + 8, alloc)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, alloc)
+		#endif
 	{
 	 	assert(std::numeric_limits<skipfield_type>::is_integer & !std::numeric_limits<skipfield_type>::is_signed); // skipfield type must be of unsigned integer type (uchar, ushort, uint etc)
 	}
@@ -1298,15 +1733,26 @@ public:
 	// Copy constructor:
 
 	colony(const colony &source):
-		element_allocator_type(source),
+		#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+			element_allocator_type(std::allocator_traits<element_allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			element_allocator_type(source),
+		#endif
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group(source.min_elements_per_group),
-		group_allocator_pair(source.group_allocator_pair.max_elements_per_group),
-		erased_locations(source.erased_locations.group_allocator_pair.min_elements_per_group)
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, *this),
+		erased_locations(source.erased_locations.group_allocator_pair.min_elements_per_group, *this)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, *this)
+		#endif
 	{
-		// Copy data from source:
-		insert(source.begin(), source.end());
+		copy_from_source(source);
 	}
 
 
@@ -1316,13 +1762,20 @@ public:
 	colony(const colony &source, const allocator_type &alloc):
 		element_allocator_type(alloc),
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group(source.min_elements_per_group),
-		group_allocator_pair(source.group_allocator_pair.max_elements_per_group),
-		erased_locations(source.erased_locations.group_allocator_pair.min_elements_per_group)
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, alloc),
+		erased_locations(source.erased_locations.group_allocator_pair.min_elements_per_group, alloc)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, alloc)
+		#endif
 	{
-		// Copy data from source:
-		insert(source.begin(), source.end());
+		copy_from_source(source);
 	}
 
 
@@ -1335,29 +1788,56 @@ public:
 			end_iterator(std::move(source.end_iterator)),
 			begin_iterator(std::move(source.begin_iterator)),
 			first_group(std::move(source.first_group)),
+			unused_groups(std::move(source.unused_groups)),
+			unused_groups_capacity(source.unused_groups_capacity),
+			number_of_unused_groups(source.number_of_unused_groups),
 			total_number_of_elements(source.total_number_of_elements),
+			version_counter(source.version_counter),
+			generation(source.generation),
 			min_elements_per_group(source.min_elements_per_group),
-			group_allocator_pair(source.group_allocator_pair.max_elements_per_group),
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, source),
 			erased_locations(std::move(source.erased_locations))
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				, freed_erasures(std::move(source.freed_erasures))
+			#endif
 		{
 			source.first_group = NULL;
+			source.unused_groups = NULL;
+			source.unused_groups_capacity = 0;
+			source.number_of_unused_groups = 0;
 			source.total_number_of_elements = 0; // Nullifying the other data members is unnecessary - technically all can be removed except first_group NULL and total_number_of_elements 0, to allow for clean destructor usage
 		}
 		
 		
-		// Move constructor:
+		// Move constructor (allocator-extended) - memory can only be taken over from the source if it's allocator is equal to the supplied allocator, otherwise elements are moved individually:
 		colony(colony &&source, const allocator_type &alloc):
 			element_allocator_type(alloc),
-			end_iterator(std::move(source.end_iterator)),
-			begin_iterator(std::move(source.begin_iterator)),
-			first_group(std::move(source.first_group)),
-			total_number_of_elements(source.total_number_of_elements),
+			first_group(NULL),
+			unused_groups(NULL),
+			unused_groups_capacity(0),
+			number_of_unused_groups(0),
+			total_number_of_elements(0),
+			version_counter(0),
+			generation(0),
 			min_elements_per_group(source.min_elements_per_group),
-			group_allocator_pair(source.group_allocator_pair.max_elements_per_group),
-			erased_locations(std::move(source.erased_locations))
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, alloc),
+			erased_locations(source.erased_locations.group_allocator_pair.min_elements_per_group, alloc)
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				, freed_erasures(8, alloc)
+			#endif
 		{
-			source.first_group = NULL;
-			source.total_number_of_elements = 0; // Nullifying the other data members is unnecessary - technically all can be removed except first_group NULL and total_number_of_elements 0, to allow for clean destructor usage
+			if (alloc == static_cast<const element_allocator_type &>(source))
+			{
+				take_memory_from(source);
+			}
+			else
+			{
+				insert(std::make_move_iterator(source.begin_iterator), std::make_move_iterator(source.end_iterator));
+
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					reset_changes();
+				#endif
+			}
 		}
 	#endif
 
@@ -1368,11 +1848,19 @@ public:
 	colony(const size_type fill_number, const element_type &element, const skipfield_type min_allocation_amount = 0, const skipfield_type max_allocation_amount = std::numeric_limits<skipfield_type>::max(), const element_allocator_type &alloc = element_allocator_type()):
 		element_allocator_type(alloc),
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group((min_allocation_amount != 0) ? min_allocation_amount : 
 			(fill_number > max_allocation_amount) ? max_allocation_amount : static_cast<skipfield_type>(fill_number)),
-		group_allocator_pair(max_allocation_amount),
-		erased_locations((min_elements_per_group < 8) ? min_elements_per_group : (min_elements_per_group >> 7) + 8)
+		group_allocator_pair(max_allocation_amount, alloc),
+		erased_locations((min_elements_per_group < 8) ? min_elements_per_group : (min_elements_per_group >> 7) + 8, alloc)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, alloc)
+		#endif
 	{
 	 	assert(std::numeric_limits<skipfield_type>::is_integer & !std::numeric_limits<skipfield_type>::is_signed);
 		assert((min_elements_per_group > 2) & (min_elements_per_group <= group_allocator_pair.max_elements_per_group));
@@ -1388,10 +1876,18 @@ public:
 	colony(const typename plf_enable_if_c<!std::numeric_limits<iterator_type>::is_integer, iterator_type>::type &first, const iterator_type &last, const skipfield_type min_allocation_amount = 8, const skipfield_type max_allocation_amount = std::numeric_limits<skipfield_type>::max(), const element_allocator_type &alloc = element_allocator_type()):
 		element_allocator_type(alloc),
 		first_group(NULL),
+		unused_groups(NULL),
+		unused_groups_capacity(0),
+		number_of_unused_groups(0),
 		total_number_of_elements(0),
+		version_counter(0),
+		generation(0),
 		min_elements_per_group(min_allocation_amount),
-		group_allocator_pair(max_allocation_amount),
-		erased_locations((min_allocation_amount < 8) ? min_allocation_amount : (min_allocation_amount >> 7) + 8)
+		group_allocator_pair(max_allocation_amount, alloc),
+		erased_locations((min_allocation_amount < 8) ? min_allocation_amount : (min_allocation_amount >> 7) + 8, alloc)
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			, freed_erasures(8, alloc)
+		#endif
 	{
 	 	assert(std::numeric_limits<skipfield_type>::is_integer & !std::numeric_limits<skipfield_type>::is_signed);
 		assert((min_elements_per_group > 2) & (min_elements_per_group <= group_allocator_pair.max_elements_per_group));
@@ -1407,12 +1903,20 @@ public:
 		colony(const std::initializer_list<element_type> &element_list, const skipfield_type min_allocation_amount = 0, const skipfield_type max_allocation_amount = std::numeric_limits<skipfield_type>::max(), const element_allocator_type &alloc = element_allocator_type()):
 			element_allocator_type(alloc),
 			first_group(NULL),
+			unused_groups(NULL),
+			unused_groups_capacity(0),
+			number_of_unused_groups(0),
 			total_number_of_elements(0),
+			version_counter(0),
+			generation(0),
 			min_elements_per_group((min_allocation_amount != 0) ? min_allocation_amount : 
 				(element_list.size() < 8) ? 8 :
 				(element_list.size() > max_allocation_amount) ? max_allocation_amount : static_cast<skipfield_type>(element_list.size())),
-			group_allocator_pair(max_allocation_amount),
-			erased_locations((min_elements_per_group < 8) ? min_elements_per_group : (min_elements_per_group >> 7) + 8)
+			group_allocator_pair(max_allocation_amount, alloc),
+			erased_locations((min_elements_per_group < 8) ? min_elements_per_group : (min_elements_per_group >> 7) + 8, alloc)
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				, freed_erasures(8, alloc)
+			#endif
 		{
 		 	assert(std::numeric_limits<skipfield_type>::is_integer & !std::numeric_limits<skipfield_type>::is_signed);
 			assert((min_elements_per_group > 2) & (min_elements_per_group <= group_allocator_pair.max_elements_per_group));
@@ -1503,7 +2007,8 @@ public:
 
 private:
 
-	void destroy_all_data()
+	// Destroys all elements without deallocating their groups. Skipped entirely for trivially-destructible types:
+	void destroy_elements()
 	{
 	#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
 		if (total_number_of_elements != 0 && !(std::is_trivially_destructible<element_type>::value))
@@ -1511,10 +2016,8 @@ private:
 		if (total_number_of_elements != 0)
 	#endif
 		{
-			total_number_of_elements = 0;
-
-			group_pointer_type previous_group;
-			element_pointer_type element_pointer = begin_iterator.element_pointer, end_pointer = first_group->last_endpoint;
+			group_pointer_type current_group = first_group;
+			element_pointer_type element_pointer = begin_iterator.element_pointer, end_pointer = current_group->last_endpoint;
 			skipfield_pointer_type skipfield_pointer = begin_iterator.skipfield_pointer;
 
 			while (true)
@@ -1527,59 +2030,105 @@ private:
 
 				if (element_pointer == end_pointer) // ie. beyond end of available data
 				{
-					previous_group = first_group;
-					first_group = first_group->next_group;
-
-					PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, previous_group);
-					PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group, 1);
-
-					if (first_group == NULL)
+					if ((current_group = current_group->next_group) == NULL)
 					{
 						return;
 					}
 
-					end_pointer = first_group->last_endpoint;
-					element_pointer = first_group->elements + *(first_group->skipfield);
-					skipfield_pointer = first_group->skipfield + *(first_group->skipfield);
+					end_pointer = current_group->last_endpoint;
+					element_pointer = current_group->elements + *(current_group->skipfield);
+					skipfield_pointer = current_group->skipfield + *(current_group->skipfield);
 				}
 			}
 		}
-		else // Avoid iteration for both empty groups and trivially-destructible types eg. POD, structs, classes with empty destructors
-		{
-			// Technically under a type-traits-supporting compiler total_number_of_elements could be non-zero at this point, but since first_group would already be NULL in the case of double-destruction, it's unnecessary to zero total_number_of_elements
-			group_pointer_type previous_group;
+	}
 
-			while (first_group != NULL)
-			{
-				previous_group = first_group;
-				first_group = first_group->next_group;
-				PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, previous_group);
-				PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group, 1);
-			}
+
+
+	void deallocate_groups(group_pointer_type current_group) PLF_COLONY_NOEXCEPT
+	{
+		group_pointer_type previous_group;
+
+		while (current_group != NULL)
+		{
+			previous_group = current_group;
+			current_group = current_group->next_group;
+			PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, previous_group);
+			PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group, 1);
 		}
 	}
 
 
 
-	void initialize(const skipfield_type first_group_size)
+	void destroy_all_data()
 	{
-		first_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, 0);
+		destroy_elements();
+		total_number_of_elements = 0;
+
+		deallocate_groups(first_group);
+		first_group = NULL;
+		deallocate_groups(unused_groups);
+		unused_groups = NULL;
+		unused_groups_capacity = 0;
+		number_of_unused_groups = 0;
+	}
+
+
+
+	// Allocates and constructs a group, or reuses the first group retained by clear(true) which holds at least minimum_size elements (and no more than the current maximum group size):
+	group_pointer_type create_group(const skipfield_type elements_per_group, group_pointer_type const previous, const skipfield_type minimum_size)
+	{
+		group_pointer_type preceding_group = NULL;
+
+		for (group_pointer_type current_group = unused_groups; current_group != NULL; current_group = current_group->next_group)
+		{
+			if (current_group->size >= minimum_size && current_group->size <= group_allocator_pair.max_elements_per_group)
+			{
+				if (preceding_group == NULL)
+				{
+					unused_groups = current_group->next_group;
+				}
+				else
+				{
+					preceding_group->next_group = current_group->next_group;
+				}
+
+				unused_groups_capacity -= current_group->size;
+				--number_of_unused_groups;
+				current_group->reset(previous);
+				current_group->version = ++version_counter;
+				return current_group;
+			}
+
+			preceding_group = current_group;
+		}
+
+		const group_pointer_type new_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, previous);
 
 		try
 		{
 			#ifdef PLF_COLONY_VARIADICS_SUPPORT
-				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, first_group_size);
-			#else
-				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(first_group_size));
+				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, new_group, group_allocator_pair, elements_per_group, previous);
+			#else // C++03 only supports copy construction
+				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, new_group, group(group_allocator_pair, elements_per_group, previous));
 			#endif
 		}
 		catch (...)
 		{
-			PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, first_group, 1);
-			first_group = NULL;
+			PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, new_group, 1);
 			throw;
 		}
 
+		new_group->version = ++version_counter;
+		return new_group;
+	}
+
+
+
+	void initialize(const skipfield_type first_group_size)
+	{
+		first_group = create_group(first_group_size, NULL, first_group_size);
+
 		begin_iterator.group_pointer = first_group;
 		begin_iterator.element_pointer = first_group->elements;
 		begin_iterator.skipfield_pointer = first_group->skipfield;
@@ -1588,9 +2137,58 @@ private:
 
 
 
-public:
+	// Constructors for insert_with():
+	struct copy_constructor
+	{
+		colony &the_colony;
+		const element_type &element;
+
+		copy_constructor(colony &source_colony, const element_type &source_element) PLF_COLONY_NOEXCEPT: the_colony(source_colony), element(source_element) {}
+
+		inline void operator () (const element_pointer_type location) const
+		{
+			PLF_COLONY_CONSTRUCT(element_allocator_type, static_cast<element_allocator_type &>(the_colony), location, element);
+		}
+	};
 
-	iterator insert(const element_type &element)
+
+
+	#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+		struct move_constructor
+		{
+			colony &the_colony;
+			element_type &element;
+
+			move_constructor(colony &source_colony, element_type &source_element) PLF_COLONY_NOEXCEPT: the_colony(source_colony), element(source_element) {}
+
+			inline void operator () (const element_pointer_type location) const
+			{
+				PLF_COLONY_CONSTRUCT(element_allocator_type, static_cast<element_allocator_type &>(the_colony), location, std::move(element));
+			}
+		};
+	#endif
+
+
+
+	// Copies the bytes of an element which colony_is_trivially_relocatable, leaving the source to be erased without destruction:
+	struct relocating_constructor
+	{
+		const element_pointer_type source;
+
+		explicit relocating_constructor(const element_pointer_type source_element) PLF_COLONY_NOEXCEPT: source(source_element) {}
+
+		inline void operator () (const element_pointer_type location) const PLF_COLONY_NOEXCEPT
+		{
+			std::memcpy(static_cast<void *>(&*location), static_cast<const void *>(&*source), sizeof(element_type)); // void * casts avoid -Wclass-memaccess for non-trivially-copyable types which have opted in
+		}
+	};
+
+
+
+	// Constructs an element in the location the next insertion takes - a previously-erased location, the back group's unused capacity or a new group - by calling constructor(location),
+	// then updates the colony to include it. If construction throws, the colony is left as it was. Shared by insert(), emplace() and transfer():
+	template <class constructor_type>
+	iterator insert_with(const constructor_type &constructor)
 	{
 		if (end_iterator.element_pointer != NULL)
 		{
@@ -1599,39 +2197,28 @@ public:
 				case 0: // ie. erased_locations is empty and end_iterator is not at end of current final group
 				{
 					const iterator return_iterator = end_iterator; /* Make copy for return before adjusting components */
-					PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer, element);
+					constructor(end_iterator.element_pointer);
 
 					++end_iterator.element_pointer; // not postfix incrementing prev statement as it would necessitate a try-catch block to reverse increment if necessary (which would decrease speed by increasing code size)
 					++end_iterator.skipfield_pointer;
 					++(end_iterator.group_pointer->last_endpoint);
 					++(end_iterator.group_pointer->number_of_elements);
+					end_iterator.group_pointer->version = ++version_counter;
+					#ifdef PLF_COLONY_CHANGE_TRACKING
+						record_insertion(end_iterator.group_pointer, return_iterator.element_pointer);
+					#endif
 					++total_number_of_elements;
 
 					return return_iterator; // return value before incrementing
 				}
 				case 1:	// ie. erased_locations is empty and end_iterator is at end of current final group - ie. colony is full - create new group
 				{
-					end_iterator.group_pointer->next_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, end_iterator.group_pointer);
+					end_iterator.group_pointer->next_group = create_group((total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer, 1); // Any retained group will do, as this becomes the back group
 					group &next_group = *(end_iterator.group_pointer->next_group);
 
 					try
 					{
-						#ifdef PLF_COLONY_VARIADICS_SUPPORT
-							PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, (total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer);
-						#else // C++03 only supports copy construction
-							PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, group((total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer));
-						#endif
-					}
-					catch (...)
-					{
-						PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, &next_group, 1);
-						end_iterator.group_pointer->next_group = NULL;
-						throw;
-					}
-
-					try
-					{
-						PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), next_group.elements, element);
+						constructor(next_group.elements);
 					}
 					catch (...)
 					{
@@ -1641,6 +2228,10 @@ public:
 						throw;
 					}
 
+					#ifdef PLF_COLONY_CHANGE_TRACKING
+						record_insertion(&next_group, next_group.elements);
+					#endif
+
 					end_iterator.group_pointer = &next_group;
 					end_iterator.element_pointer = next_group.last_endpoint;
 					end_iterator.skipfield_pointer = next_group.skipfield + 1;
@@ -1652,7 +2243,7 @@ public:
 				{
 					iterator new_location;
 					new_location.element_pointer = *erased_locations.top_element;
-					PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), new_location.element_pointer, element);
+					constructor(new_location.element_pointer);
 					erased_locations.pop();
 
 					new_location.group_pointer = end_iterator.group_pointer; // Start with last group first, as will be the largest group
@@ -1665,6 +2256,10 @@ public:
 					new_location.skipfield_pointer = new_location.group_pointer->skipfield + (new_location.element_pointer - new_location.group_pointer->elements);
 
 					++(new_location.group_pointer->number_of_elements);
+					new_location.group_pointer->version = ++version_counter;
+					#ifdef PLF_COLONY_CHANGE_TRACKING
+						record_insertion(new_location.group_pointer, new_location.element_pointer);
+					#endif
 
 					if (new_location.group_pointer == first_group && new_location.element_pointer < begin_iterator.element_pointer)
 					{ /* ie. begin_iterator was moved forwards as the result of an erasure at some point, this erased element is before the current begin, hence, set current begin iterator to this element */
@@ -1729,7 +2324,7 @@ public:
 
 			try
 			{
-				PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer++, element);
+				constructor(end_iterator.element_pointer++);
 			}
 			catch (...)
 			{
@@ -1740,349 +2335,255 @@ public:
 			++end_iterator.skipfield_pointer;
 			total_number_of_elements = 1;
 
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				record_insertion(first_group, first_group->elements);
+			#endif
+
 			return begin_iterator; // returns value before incrementation
 		}
 	}
 
 
 
-	#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-		// Note: the reason for code duplication from non-move insert, as opposed to using std::forward for both, was because most compilers didn't actually create as-optimal code in that strategy. Also, C++03 compliance...
-
-		iterator insert(element_type &&element)
-		{
-			if (end_iterator.element_pointer != NULL)
-			{
-				switch(((erased_locations.total_number_of_elements != 0) << 1) | (end_iterator.element_pointer == reinterpret_cast<element_pointer_type>(end_iterator.group_pointer->skipfield)))
-				{
-					case 0:
-					{
-						const iterator return_iterator = end_iterator; /* Make copy for return before adjusting components */
-						PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer, std::move(element));
-
-						++end_iterator.element_pointer;
-						++end_iterator.skipfield_pointer;
-						++end_iterator.group_pointer->last_endpoint;
-						++end_iterator.group_pointer->number_of_elements;
-						++total_number_of_elements;
-						return return_iterator;
-					}
-					case 1:
-					{
-						end_iterator.group_pointer->next_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, end_iterator.group_pointer);
-						group &next_group = *(end_iterator.group_pointer->next_group);
+public:
 
-						try
-						{
-							#ifdef PLF_COLONY_VARIADICS_SUPPORT
-								PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, (total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer);
-							#else
-								PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, group((total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer));
-							#endif
-						}
-						catch (...)
-						{
-							PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, &next_group, 1);
-							end_iterator.group_pointer->next_group = NULL;
-							throw;
-						}
+	inline iterator insert(const element_type &element)
+	{
+		return insert_with(copy_constructor(*this, element));
+	}
 
-						try
-						{
-							PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), next_group.elements, std::move(element));
-						}
-						catch (...)
-						{
-							PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, &next_group);
-							PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, &next_group, 1);
-							end_iterator.group_pointer->next_group = NULL;
-							throw;
-						}
 
-						end_iterator.group_pointer = &next_group;
-						end_iterator.element_pointer = next_group.last_endpoint;
-						end_iterator.skipfield_pointer = next_group.skipfield + 1;
-						++total_number_of_elements;
-	
-						return iterator(end_iterator.group_pointer, next_group.elements, next_group.skipfield); /* returns value before incrementation */
-					}
-					default:
-					{
-						iterator new_location;
-						new_location.element_pointer = *erased_locations.top_element;
-						PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), new_location.element_pointer, std::move(element));
-						erased_locations.pop();
-	
-						new_location.group_pointer = end_iterator.group_pointer; // Start with last group first, as will be the largest group
-				
-						while (new_location.element_pointer < new_location.group_pointer->elements || new_location.element_pointer >= reinterpret_cast<element_pointer_type>(new_location.group_pointer->skipfield))
-						{
-							new_location.group_pointer = new_location.group_pointer->previous_group;
-						}
-	
-						new_location.skipfield_pointer = new_location.group_pointer->skipfield + (new_location.element_pointer - new_location.group_pointer->elements);
 
-						++(new_location.group_pointer->number_of_elements);
+	#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+		inline iterator insert(element_type &&element)
+		{
+			return insert_with(move_constructor(*this, element));
+		}
+	#endif
 
-						if (new_location.group_pointer == first_group && new_location.element_pointer < begin_iterator.element_pointer)
-						{
-							begin_iterator = new_location;
-						}
 
-						++total_number_of_elements;
 
-						const skipfield_type value = *(new_location.skipfield_pointer);
-						const bool test = (new_location.skipfield_pointer == new_location.group_pointer->skipfield);
-						const unsigned char prev_skipfield = *(new_location.skipfield_pointer - !test) != value * test;
-						const unsigned char after_skipfield = *(new_location.skipfield_pointer + 1) != 0;
-	
-						switch (prev_skipfield | (after_skipfield << 1))
-						{
-							case 1:
-							{
-								*(new_location.skipfield_pointer - (value - 1)) = value - 1;
-								break;
-							}
-							case 2:
-							{
-								std::memmove(&*(new_location.skipfield_pointer + 2), &*(new_location.skipfield_pointer + 1), sizeof(skipfield_type) * (value - 2));
-								*(new_location.skipfield_pointer + 1) = value - 1;
-								break;
-							}
-							case 3:
-							{
-								const skipfield_pointer_type start_node = new_location.skipfield_pointer - (value - 1);
-								const skipfield_type update_count = *start_node - value;
-								*start_node = value - 1;
+	#ifdef PLF_COLONY_VARIADICS_SUPPORT
+		template<typename... Arguments>
+		inline iterator emplace(Arguments&&... parameters)
+		{
+			return insert_with([&](const element_pointer_type location) { PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), location, std::forward<Arguments>(parameters)...); });
+		}
+	#endif
 
-								std::memmove(&*(new_location.skipfield_pointer + 2), &*(start_node + 1), sizeof(skipfield_type) * (update_count - 1));
-								*(new_location.skipfield_pointer + 1) = update_count;
-							}
-						}
 
-						*new_location.skipfield_pointer = 0;
-						return new_location;
-					}
-				}
-			}
-			else
-			{
-				initialize(min_elements_per_group);
 
-				try
-				{
-					PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer++, std::move(element));
-				}
-				catch (...)
-				{
-					clear();
-					throw;
-				}
+private:
 
-				++end_iterator.skipfield_pointer;
-				total_number_of_elements = 1;
+	// Internal functions for insert-fill:
+	void group_create(const skipfield_type number_of_elements)
+	{
+		const group_pointer_type next_group = end_iterator.group_pointer->next_group = create_group(number_of_elements, end_iterator.group_pointer, number_of_elements);
+		end_iterator.group_pointer = next_group;
+		end_iterator.element_pointer = next_group->elements;
+	}
 
-				return begin_iterator;
-			}
-		}
-	#endif
 
 
+	void group_fill(const element_type &element, const skipfield_type number_of_elements)
+	{
+		const element_pointer_type fill_end = end_iterator.element_pointer + number_of_elements;
 
-	#ifdef PLF_COLONY_VARIADICS_SUPPORT
-		template<typename... Arguments>
-		iterator emplace(Arguments&&... parameters)
+		do
 		{
-			if (end_iterator.element_pointer != NULL)
+			try
 			{
-				switch(((erased_locations.total_number_of_elements != 0) << 1) | (end_iterator.element_pointer == reinterpret_cast<element_pointer_type>(end_iterator.group_pointer->skipfield)))
-				{
-					case 0:
-					{
-						const iterator return_iterator = end_iterator;
-						PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer, std::forward<Arguments>(parameters)...);
-
-						++end_iterator.element_pointer;
-						++end_iterator.skipfield_pointer;
-						++end_iterator.group_pointer->last_endpoint;
-						++end_iterator.group_pointer->number_of_elements;
-						++total_number_of_elements;
-						return return_iterator;
-					}
-					case 1:
-					{
-						end_iterator.group_pointer->next_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, end_iterator.group_pointer);
-						group &next_group = *(end_iterator.group_pointer->next_group);
+				PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer++, element);
+			}
+			catch (...)
+			{
+				end_iterator.group_pointer->last_endpoint = --end_iterator.element_pointer;
+				const skipfield_type temp = static_cast<const skipfield_type>(end_iterator.element_pointer - end_iterator.group_pointer->elements);
+				end_iterator.group_pointer->number_of_elements = temp;
+				end_iterator.skipfield_pointer = end_iterator.group_pointer->skipfield + temp;
+				throw;
+			}
 
-						try
-						{
-							#ifdef PLF_COLONY_VARIADICS_SUPPORT
-								PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, (total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer);
-							#else
-								PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, &next_group, group((total_number_of_elements < static_cast<size_type>(group_allocator_pair.max_elements_per_group)) ? static_cast<const skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group, end_iterator.group_pointer));
-							#endif
-						}
-						catch (...)
-						{
-							PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, &next_group, 1);
-							end_iterator.group_pointer->next_group = NULL;
-							throw;
-						}
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				record_insertion(end_iterator.group_pointer, end_iterator.element_pointer - 1);
+			#endif
+		} while (end_iterator.element_pointer != fill_end);
 
-						try
-						{
-							PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), next_group.elements, std::forward<Arguments>(parameters)...);
-						}
-						catch (...)
-						{
-							PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, &next_group);
-							PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, &next_group, 1);
-							end_iterator.group_pointer->next_group = NULL;
-							throw;
-						}
-	
-						end_iterator.group_pointer = &next_group;
-						end_iterator.element_pointer = next_group.last_endpoint;
-						end_iterator.skipfield_pointer = next_group.skipfield + 1;
-						++total_number_of_elements;
-	
-						return iterator(end_iterator.group_pointer, next_group.elements, next_group.skipfield);
-					}
-					default:
-					{
-						iterator new_location;
-						new_location.element_pointer = *erased_locations.top_element;
-						PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), new_location.element_pointer, std::forward<Arguments>(parameters)...);
-						erased_locations.pop();
+		end_iterator.group_pointer->last_endpoint = end_iterator.element_pointer;
+		end_iterator.group_pointer->number_of_elements = number_of_elements;
+	}
 
-						new_location.group_pointer = end_iterator.group_pointer;
 
-						while (new_location.element_pointer < new_location.group_pointer->elements || new_location.element_pointer >= reinterpret_cast<element_pointer_type>(new_location.group_pointer->skipfield))
-						{
-							new_location.group_pointer = new_location.group_pointer->previous_group;
-						}
 
-						new_location.skipfield_pointer = new_location.group_pointer->skipfield + (new_location.element_pointer - new_location.group_pointer->elements);
+	// Used by the copy constructors. For trivially-copyable types the source's groups are duplicated verbatim (elements and skipfield), otherwise elements are copy-inserted one at a time:
+	void copy_from_source(const colony &source)
+	{
+		#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+			if (std::is_trivially_copyable<element_type>::value && source.total_number_of_elements != 0) // This if-statement should be removed by the compiler on resolution of element_type
+			{
+				copy_groups(source);
+				return;
+			}
+		#endif
 
-						++(new_location.group_pointer->number_of_elements);
+		insert(source.begin_iterator, source.end_iterator);
 
-						if (new_location.group_pointer == first_group && new_location.element_pointer < begin_iterator.element_pointer)
-						{
-							begin_iterator = new_location;
-						}
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			reset_changes(); // A copy starts with an empty change log, as per copy_groups
+		#endif
+	}
 
-						++total_number_of_elements;
 
-						const skipfield_type value = *(new_location.skipfield_pointer);
-						const bool test = (new_location.skipfield_pointer == new_location.group_pointer->skipfield);
-						const unsigned char prev_skipfield = *(new_location.skipfield_pointer - !test) != value * test;
-						const unsigned char after_skipfield = *(new_location.skipfield_pointer + 1) != 0;
 
-						switch (prev_skipfield | (after_skipfield << 1))
-						{
-							case 1:
-							{
-								*(new_location.skipfield_pointer - (value - 1)) = value - 1;
-								break;
-							}
-							case 2:
-							{
-								std::memmove(&*(new_location.skipfield_pointer + 2), &*(new_location.skipfield_pointer + 1), sizeof(skipfield_type) * (value - 2));
-								*(new_location.skipfield_pointer + 1) = value - 1;
-								break;
-							}
-							case 3:
-							{
-								const skipfield_pointer_type start_node = new_location.skipfield_pointer - (value - 1);
-								const skipfield_type update_count = *start_node - value;
-								*start_node = value - 1;
+	#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+		void copy_groups(const colony &source)
+		{
+			typedef typename reduced_stack::stack_element_pointer_type stack_element_pointer;
 
-								std::memmove(&*(new_location.skipfield_pointer + 2), &*(start_node + 1), sizeof(skipfield_type) * (update_count - 1));
-								*(new_location.skipfield_pointer + 1) = update_count;
-							}
-						}
+			group_pointer_type source_group = source.first_group;
+			size_type number_of_erased_locations = 0;
 
-						*new_location.skipfield_pointer = 0;
-						return new_location;
-					}
-				}
+			for (group_pointer_type current_group = source_group; current_group != NULL; current_group = current_group->next_group)
+			{
+				number_of_erased_locations += static_cast<size_type>(current_group->last_endpoint - current_group->elements) - current_group->number_of_elements;
 			}
-			else
+
+			initialize(source_group->size);
+
+			try
 			{
-				initialize(min_elements_per_group);
+				stack_element_pointer erased_location = NULL;
 
-				try
+				if (number_of_erased_locations != 0)
 				{
-					PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer++, std::forward<Arguments>(parameters)...);
+					erased_locations.initialize(number_of_erased_locations + 1); // + 1 so that the branchless loop below can always write one past the last erased location
+					erased_location = erased_locations.start_element;
 				}
-				catch (...)
+
+				while (true)
 				{
-					clear();
-					throw;
-				}
+					const group_pointer_type current_group = end_iterator.group_pointer;
+					const skipfield_type number_used = static_cast<skipfield_type>(source_group->last_endpoint - source_group->elements);
+
+					// Skipfield nodes past the last used element are always zero, as are the new group's:
+					std::memcpy(static_cast<void *>(&*(current_group->elements)), static_cast<const void *>(&*(source_group->elements)), number_used * sizeof(element_type)); // void * casts avoid -Wclass-memaccess when instantiated for non-trivial types, where this code is unreachable
+					std::memcpy(&*(current_group->skipfield), &*(source_group->skipfield), number_used * sizeof(skipfield_type));
+					current_group->last_endpoint = current_group->elements + number_used;
+					current_group->number_of_elements = source_group->number_of_elements;
+					total_number_of_elements += source_group->number_of_elements;
+
+					// Rebuild erased locations from the copied skipfield. Every location is written but the write position only advances past erased ones - avoiding a mispredicted branch per element:
+					if (source_group->number_of_elements != number_used)
+					{
+						const element_pointer_type elements = current_group->elements;
+						const skipfield_pointer_type skipfield = current_group->skipfield;
 
-				++end_iterator.skipfield_pointer;
-				total_number_of_elements = 1;
+						for (skipfield_type index = 0; index != number_used; ++index)
+						{
+							PLF_COLONY_CONSTRUCT(element_pointer_allocator_type, erased_locations, erased_location, elements + index);
+							erased_location += (skipfield[index] != 0);
+						}
+					}
 
-				return begin_iterator;
+					if ((source_group = source_group->next_group) == NULL)
+					{
+						break;
+					}
+
+					group_create(source_group->size);
+				}
+
+				if (number_of_erased_locations != 0)
+				{
+					erased_locations.top_element = erased_location - 1;
+					erased_locations.total_number_of_elements = number_of_erased_locations;
+				}
 			}
+			catch (...)
+			{
+				destroy_all_data(); // Trivially-copyable types are trivially destructible, so this only deallocates groups
+				erased_locations.clear();
+				total_number_of_elements = 0;
+				throw;
+			}
+
+			end_iterator.element_pointer = end_iterator.group_pointer->last_endpoint;
+			end_iterator.skipfield_pointer = end_iterator.group_pointer->skipfield + (end_iterator.element_pointer - end_iterator.group_pointer->elements);
+			begin_iterator.element_pointer = first_group->elements + *(first_group->skipfield);
+			begin_iterator.skipfield_pointer = first_group->skipfield + *(first_group->skipfield);
 		}
 	#endif
 
 
 
-private:
-
-	// Internal functions for insert-fill:
-	void group_create(const skipfield_type number_of_elements)
+	// Reallocates all elements into new groups sized according to the current minimum and maximum group sizes. Unlike the copy constructor, this always compacts:
+	void consolidate()
 	{
-		const group_pointer_type next_group = end_iterator.group_pointer->next_group = PLF_COLONY_ALLOCATE(group_allocator_type, group_allocator_pair, 1, end_iterator.group_pointer);
+		colony temp(static_cast<const element_allocator_type &>(*this));
+		temp.min_elements_per_group = min_elements_per_group;
+		temp.group_allocator_pair.max_elements_per_group = group_allocator_pair.max_elements_per_group;
+		temp.erased_locations.group_allocator_pair.min_elements_per_group = erased_locations.group_allocator_pair.min_elements_per_group;
+		temp.insert(begin_iterator, end_iterator);
 
-		try
+		#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+			*this = std::move(temp); // Avoid generating 2nd temporary
+		#else
+			this->swap(temp);
+		#endif
+	}
+
+
+
+	#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+		// Takes over the source's groups and erased locations. This colony must not hold any memory, and it's allocator must be equal to the source's:
+		void take_memory_from(colony &source) PLF_COLONY_NOEXCEPT
 		{
-			#ifdef PLF_COLONY_VARIADICS_SUPPORT
-				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, next_group, number_of_elements, end_iterator.group_pointer);
-			#else
-				PLF_COLONY_CONSTRUCT(group_allocator_type, group_allocator_pair, next_group, group(number_of_elements, end_iterator.group_pointer));
+			end_iterator = std::move(source.end_iterator);
+			begin_iterator = std::move(source.begin_iterator);
+			first_group = std::move(source.first_group);
+			unused_groups = std::move(source.unused_groups);
+			unused_groups_capacity = source.unused_groups_capacity;
+			number_of_unused_groups = source.number_of_unused_groups;
+			total_number_of_elements = source.total_number_of_elements;
+			min_elements_per_group = source.min_elements_per_group;
+			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+
+			// Stamps issued from here on must not repeat any version held by the source's groups, and views frozen against either colony's previous groups must not be matched against these:
+			version_counter = (version_counter > source.version_counter) ? version_counter : source.version_counter;
+			generation = ((generation > source.generation) ? generation : source.generation) + 1;
+
+			erased_locations = std::move(source.erased_locations);
+
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				freed_erasures = std::move(source.freed_erasures);
 			#endif
+
+			source.first_group = NULL;
+			source.unused_groups = NULL;
+			source.unused_groups_capacity = 0;
+			source.number_of_unused_groups = 0;
+			source.total_number_of_elements = 0; // Nullifying the other data members is unnecessary - technically all can be removed except first_group NULL and total_number_of_elements 0, to allow for clean destructor usage
 		}
-		catch (...)
-		{
-			PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, next_group);
-			PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, next_group, 1);
-			end_iterator.group_pointer->next_group = NULL;
-			throw;
-		}
+	#endif
 
-		end_iterator.group_pointer = next_group;
-		end_iterator.element_pointer = next_group->elements;
-	}
 
 
+	#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+		// Copies the source's allocator into this colony and it's internal structures, for allocators which propagate on assignment. This colony must not hold any memory at this point.
+		// Overloaded on the propagation trait so that allocators which are not assignable (eg. std::pmr::polymorphic_allocator) never instantiate the assignment:
+		void propagate_allocator(const colony &source, std::true_type)
+		{
+			static_cast<element_allocator_type &>(*this) = static_cast<const element_allocator_type &>(source);
+			static_cast<group_allocator_type &>(group_allocator_pair) = static_cast<const group_allocator_type &>(source.group_allocator_pair);
+			static_cast<element_pointer_allocator_type &>(erased_locations) = static_cast<const element_pointer_allocator_type &>(source.erased_locations);
+			static_cast<typename reduced_stack::stack_group_allocator_type &>(erased_locations.group_allocator_pair) = static_cast<const typename reduced_stack::stack_group_allocator_type &>(source.erased_locations.group_allocator_pair);
+		}
 
-	void group_fill(const element_type &element, const skipfield_type number_of_elements)
-	{
-		const element_pointer_type fill_end = end_iterator.element_pointer + number_of_elements;
 
-		do
-		{
-			try
-			{
-				PLF_COLONY_CONSTRUCT(element_allocator_type, (*this), end_iterator.element_pointer++, element);
-			}
-			catch (...)
-			{
-				end_iterator.group_pointer->last_endpoint = --end_iterator.element_pointer;
-				const skipfield_type temp = static_cast<const skipfield_type>(end_iterator.element_pointer - end_iterator.group_pointer->elements);
-				end_iterator.group_pointer->number_of_elements = temp;
-				end_iterator.skipfield_pointer = end_iterator.group_pointer->skipfield + temp;
-				throw;
-			}
-		} while (end_iterator.element_pointer != fill_end);
 
-		end_iterator.group_pointer->last_endpoint = end_iterator.element_pointer;
-		end_iterator.group_pointer->number_of_elements = number_of_elements;
-	}
+		inline void propagate_allocator(const colony &, std::false_type) PLF_COLONY_NOEXCEPT
+		{}
+	#endif
 
 
 
@@ -2138,9 +2639,10 @@ public:
 			size_type capacity_available = (reinterpret_cast<element_pointer_type>(end_iterator.group_pointer->skipfield) - end_iterator.element_pointer) + erased_locations.total_number_of_elements;
 
 			// Use up erased locations and remainder of current group first:
-			while (capacity_available-- != 0 && num_elements-- != 0)
+			while (num_elements != 0 && capacity_available-- != 0)
 			{
 				insert(element);
+				--num_elements;
 			}
 
 			// If still some left over, create new groups and fill:
@@ -2161,9 +2663,9 @@ public:
 					group_fill(element, element_remainder);
 				}
 			}
-			else if (num_elements > total_number_of_elements)
+			else if (num_elements != 0)
 			{
-				group_create(static_cast<skipfield_type>(num_elements));
+				group_create((num_elements < min_elements_per_group) ? min_elements_per_group : static_cast<skipfield_type>(num_elements)); // A group smaller than the minimum could end up as a single-element non-final group, which erase() assumes cannot exist
 				group_fill(element, static_cast<skipfield_type>(num_elements));
 			}
 
@@ -2275,9 +2777,9 @@ private:
 		try
 		{
 			#ifdef PLF_COLONY_VARIADICS_SUPPORT
-				PLF_COLONY_CONSTRUCT(stack_group_allocator_type, erased_locations.group_allocator_pair, new_group, new_group_size, erased_locations.current_group);
+				PLF_COLONY_CONSTRUCT(stack_group_allocator_type, erased_locations.group_allocator_pair, new_group, static_cast<const element_pointer_allocator_type &>(erased_locations), new_group_size, erased_locations.current_group);
 			#else
-				PLF_COLONY_CONSTRUCT(stack_group_allocator_type, erased_locations.group_allocator_pair, new_group, typename reduced_stack::group(new_group_size, erased_locations.current_group));
+				PLF_COLONY_CONSTRUCT(stack_group_allocator_type, erased_locations.group_allocator_pair, new_group, typename reduced_stack::group(erased_locations, new_group_size, erased_locations.current_group));
 			#endif
 		}
 		catch (...)
@@ -2469,7 +2971,59 @@ private:
 				break;
 			}
 		}
-	}
+	}
+
+
+
+	#ifdef PLF_COLONY_CHANGE_TRACKING
+		// Change log: a slot's 'inserted' bit means the slot has gained an element since the last reset_changes(), it's 'erased' bit means the element which occupied the slot at the last reset_changes() has been erased.
+		// Both bits set means the original element was replaced. Erasing an element inserted since the last reset simply clears the inserted bit again.
+
+		static inline void record_insertion(const group_pointer_type the_group, const element_pointer_type the_element) PLF_COLONY_NOEXCEPT
+		{
+			const size_type index = static_cast<size_type>(the_element - the_group->elements);
+			the_group->change_bits[index / CHAR_BIT] |= static_cast<unsigned char>(1U << (index % CHAR_BIT));
+		}
+
+
+
+		static inline void record_erasure(const group_pointer_type the_group, const element_pointer_type the_element) PLF_COLONY_NOEXCEPT
+		{
+			const size_type index = static_cast<size_type>(the_element - the_group->elements), plane_size = group::change_plane_size(the_group->size);
+			const unsigned char bit = static_cast<unsigned char>(1U << (index % CHAR_BIT));
+			const uchar_pointer_type inserted = the_group->change_bits + (index / CHAR_BIT);
+
+			if (*inserted & bit)
+			{
+				*inserted &= static_cast<unsigned char>(~bit);
+			}
+			else
+			{
+				*(inserted + plane_size) |= bit; // erased plane
+			}
+
+			*(inserted + (plane_size * 2)) &= static_cast<unsigned char>(~bit); // modified plane
+		}
+
+
+
+		// Called before a group is deallocated - moves the group's erased entries into freed_erasures. Any slot which still has a zero skipfield node is treated as being erased as part of the group's removal:
+		void save_group_erasures(const group_pointer_type the_group)
+		{
+			const size_type plane_size = group::change_plane_size(the_group->size), number_used = static_cast<size_type>(the_group->last_endpoint - the_group->elements);
+			const uchar_pointer_type inserted = the_group->change_bits, erased = inserted + plane_size;
+
+			for (size_type index = 0; index != the_group->size; ++index)
+			{
+				const unsigned char bit = static_cast<unsigned char>(1U << (index % CHAR_BIT));
+
+				if ((erased[index / CHAR_BIT] & bit) || (index < number_used && the_group->skipfield[index] == 0 && !(inserted[index / CHAR_BIT] & bit)))
+				{
+					freed_erasures.push(the_group->elements + index);
+				}
+			}
+		}
+	#endif
 
 
 
@@ -2484,10 +3038,22 @@ private:
 
 
 
-public:
+private:
 
-	// must return iterator in case the group which the iterator is within becomes empty after the erasure and is thereby removed from the colony chain:
-	iterator erase(const const_iterator the_iterator)
+	// Whether erasure must run element destructors - not for trivially-destructible types (resolved at compile time), nor for elements which transfer() has relocated:
+	static inline PLF_COLONY_FORCE_INLINE bool must_destroy(const bool relocated) PLF_COLONY_NOEXCEPT
+	{
+		#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+			return !relocated && !(std::is_trivially_destructible<element_type>::value);
+		#else
+			return !relocated;
+		#endif
+	}
+
+
+
+	// relocated is true when transfer() has copied the element's bytes into another colony, in which case the element must not be destroyed:
+	iterator erase_element(const const_iterator the_iterator, const bool relocated)
 	{
 		assert(!empty());
 		const group_pointer_type the_group_pointer = the_iterator.group_pointer;
@@ -2495,19 +3061,22 @@ public:
 		assert(the_iterator.element_pointer != the_group_pointer->last_endpoint); // ie. not == end()
 		assert(*(the_iterator.skipfield_pointer) == 0); // ie. element pointed to by iterator has not been erased previously
 
-		#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-			if (!(std::is_trivially_destructible<element_type>::value)) // This if-statement should be removed by the compiler on resolution of element_type. For some optimizing compilers this step won't be necessary (for MSVC 2013 it makes a difference)
-		#endif
+		if (must_destroy(relocated))
 		{
 			PLF_COLONY_DESTROY(element_allocator_type, (*this), the_iterator.element_pointer); // Destruct element
 		}
 
 		--total_number_of_elements;
+		the_group_pointer->version = ++version_counter;
 
 		if (the_group_pointer->number_of_elements-- != 1) // ie. non-empty group at this point in time, don't consolidate - optimization note: GCC optimizes postfix + 1 comparison better than prefix + 1 comparison in many cases.
 		{
 			erased_locations.push(the_iterator.element_pointer);
 
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				record_erasure(the_group_pointer, the_iterator.element_pointer);
+			#endif
+
 			// Code logic for following section:
 			// ---------------------------------
 			// If current skipfield node has no erased node on either side, continue as usual
@@ -2608,6 +3177,10 @@ public:
 		{
 			case 0: // ie. the_group_pointer == first_group && the_group_pointer->next_group == NULL; only group in colony
 			{
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					record_erasure(the_group_pointer, the_iterator.element_pointer);
+				#endif
+
 				// Reset skipfield and erased_locations:
 				std::memset(&*(the_group_pointer->skipfield), 0, sizeof(skipfield_type) * the_group_pointer->size); // &* to avoid problems with non-trivial pointers - size + 1 to allow for computationally-faster operator ++ and other operations - extra field is unused but checked - not having it will result in out-of-bounds checks
 				erased_locations.clear();
@@ -2627,6 +3200,10 @@ public:
 				update_subsequent_group_numbers(first_group);
 				consolidate_erased_locations(the_group_pointer); // There must be erased_locations for an empty non-final group, no emptiness check is necessary
 
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					save_group_erasures(the_group_pointer);
+				#endif
+
 				PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, the_group_pointer);
 				PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, the_group_pointer, 1);
 
@@ -2646,6 +3223,10 @@ public:
 
 				consolidate_erased_locations(the_group_pointer); // There must be erased_locations for an empty non-final group, no emptiness check is necessary
 
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					save_group_erasures(the_group_pointer);
+				#endif
+
 				PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, the_group_pointer);
 				PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, the_group_pointer, 1);
 
@@ -2659,6 +3240,10 @@ public:
 					consolidate_erased_locations(the_group_pointer);
 				}
 
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					save_group_erasures(the_group_pointer);
+				#endif
+
 				the_group_pointer->previous_group->next_group = NULL;
 				end_iterator.group_pointer = the_group_pointer->previous_group; // end iterator only needs to be changed if this is the final group in the chain
 				end_iterator.element_pointer = reinterpret_cast<element_pointer_type>(end_iterator.group_pointer->skipfield);
@@ -2674,7 +3259,7 @@ public:
 
 
 
-	void erase(const const_iterator iterator1, const const_iterator iterator2)
+	void erase_range(const const_iterator iterator1, const const_iterator iterator2, const bool relocated)
 	{
 		assert(iterator1 != iterator2);
 		assert(iterator1 < iterator2);
@@ -2691,15 +3276,17 @@ public:
 				// Destroy elements first:
 				do
 				{
-					#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-						if (!(std::is_trivially_destructible<element_type>::value))
-					#endif
+					if (must_destroy(relocated))
 					{
 						PLF_COLONY_DESTROY(element_allocator_type, (*this), current.element_pointer); // Destruct element
 					}
 
         			erased_locations.push(current.element_pointer);
 
+					#ifdef PLF_COLONY_CHANGE_TRACKING
+						record_erasure(current.group_pointer, current.element_pointer);
+					#endif
+
 					++current.skipfield_pointer;
 					current.element_pointer += 1 + *current.skipfield_pointer;
 					current.skipfield_pointer += *current.skipfield_pointer;
@@ -2707,6 +3294,7 @@ public:
 				} while (current.skipfield_pointer != end);
 
 				current.group_pointer->number_of_elements -= number_of_group_erasures;
+				current.group_pointer->version = ++version_counter;
 				total_number_of_elements -= number_of_group_erasures;
 
 				// Now update skipfield:
@@ -2747,9 +3335,11 @@ public:
 
 			while (current.group_pointer != iterator2.group_pointer)
 			{
-				#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-					if (!(std::is_trivially_destructible<element_type>::value)) // This should be removed by the compiler
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					save_group_erasures(current.group_pointer); // Must be called before the group's elements are destroyed, as live elements are identified by the skipfield
 				#endif
+
+				if (must_destroy(relocated))
 				{
 					current.element_pointer = current.group_pointer->elements + *(current.group_pointer->skipfield);
 					current.skipfield_pointer = current.group_pointer->skipfield + *(current.group_pointer->skipfield);
@@ -2814,15 +3404,17 @@ public:
 
 			do
 			{
-				#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-					if (!(std::is_trivially_destructible<element_type>::value)) // This should be removed by the compiler
-				#endif
+				if (must_destroy(relocated))
 				{
 					PLF_COLONY_DESTROY(element_allocator_type, (*this), current_element);
 				}
 
 				erased_locations.push(current_element);
 
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					record_erasure(current.group_pointer, current_element);
+				#endif
+
 				++current_skipfield;
 				current_element += 1 + *current_skipfield;
 				current_skipfield += *current_skipfield;
@@ -2831,6 +3423,7 @@ public:
 
 			total_number_of_elements -= number_of_group_erasures;
 			current.group_pointer->number_of_elements -= number_of_group_erasures;
+			current.group_pointer->version = ++version_counter;
 
 			// Update skipfield:
 			skipfield_type node_value = *(current.skipfield_pointer - (current.group_pointer->skipfield != current.skipfield_pointer)); // Find value of left-hand node - if current node is at start of skipfield, we check the current node instead, which will always be zero.
@@ -2867,9 +3460,11 @@ public:
 		}
 		else // ie. full group erasure
 		{
-			#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
-				if (!(std::is_trivially_destructible<element_type>::value)) // This should be removed by the compiler
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				save_group_erasures(current.group_pointer);
 			#endif
+
+			if (must_destroy(relocated))
 			{	
 				while(current.element_pointer != iterator2.element_pointer)
 				{
@@ -2907,6 +3502,95 @@ public:
 
 
 
+public:
+
+	// must return iterator in case the group which the iterator is within becomes empty after the erasure and is thereby removed from the colony chain:
+	inline iterator erase(const const_iterator the_iterator)
+	{
+		return erase_element(the_iterator, false);
+	}
+
+
+
+	inline void erase(const const_iterator iterator1, const const_iterator iterator2)
+	{
+		erase_range(iterator1, iterator2, false);
+	}
+
+
+
+	// Transfer - moves an element into another colony and erases it from this one, returning it's location in the destination.
+	// Elements which are colony_is_trivially_relocatable have their bytes copied into the destination and are erased without destruction, so no constructor or destructor code is run.
+	// Other types are move-inserted then erased:
+	iterator transfer(const iterator the_iterator, colony &destination)
+	{
+		assert(&destination != this);
+		assert(the_iterator != end_iterator);
+
+		if (colony_is_trivially_relocatable<element_type>::value) // This if-statement should be removed by the compiler on resolution of element_type
+		{
+			const iterator new_location = destination.insert_with(relocating_constructor(the_iterator.element_pointer));
+			erase_element(the_iterator, true);
+			return new_location;
+		}
+
+		#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+			const iterator new_location = destination.insert(std::move(*the_iterator));
+		#else
+			const iterator new_location = destination.insert(*the_iterator);
+		#endif
+
+		erase(the_iterator);
+		return new_location;
+	}
+
+
+
+	// Range transfer - moves all elements in [first, last) into another colony (relocating them as above where possible), then erases them from this colony with a single range-erase
+	// (which deallocates wholly-transferred groups without per-element skipfield updates). Returns the location of the first transferred element in the destination, or destination.end() if the range is empty:
+	iterator transfer(const iterator first, const iterator last, colony &destination)
+	{
+		assert(&destination != this);
+
+		if (first == last)
+		{
+			return destination.end_iterator;
+		}
+
+		if (colony_is_trivially_relocatable<element_type>::value)
+		{
+			const iterator new_location = destination.insert_with(relocating_constructor(first.element_pointer));
+			iterator current = first;
+
+			try
+			{
+				while (++current != last)
+				{
+					destination.insert_with(relocating_constructor(current.element_pointer));
+				}
+			}
+			catch (...) // Only allocation of a destination group can throw - the elements relocated so far now belong to the destination
+			{
+				erase_range(first, current, true);
+				throw;
+			}
+
+			erase_range(first, last, true);
+			return new_location;
+		}
+
+		#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
+			const iterator new_location = destination.insert(std::make_move_iterator(first), std::make_move_iterator(last));
+		#else
+			const iterator new_location = destination.insert(first, last);
+		#endif
+
+		erase(first, last);
+		return new_location;
+	}
+
+
+
 	inline PLF_COLONY_FORCE_INLINE bool empty() const PLF_COLONY_NOEXCEPT
 	{
 		return total_number_of_elements == 0;
@@ -2923,14 +3607,18 @@ public:
 
 	inline size_type max_size() const PLF_COLONY_NOEXCEPT
 	{
-		return element_allocator_type::max_size();
+		#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+			return std::allocator_traits<element_allocator_type>::max_size(*this);
+		#else
+			return element_allocator_type::max_size();
+		#endif
 	}
 
 
 
 	inline size_type capacity() const PLF_COLONY_NOEXCEPT
 	{
-		return (first_group == NULL) ? 0 : (total_number_of_elements + static_cast<size_type>(erased_locations.total_number_of_elements) +
+		return (first_group == NULL) ? unused_groups_capacity : (unused_groups_capacity + total_number_of_elements + static_cast<size_type>(erased_locations.total_number_of_elements) +
 			static_cast<size_type>(reinterpret_cast<element_pointer_type>(end_iterator.group_pointer->skipfield) - end_iterator.element_pointer));
 	}
 
@@ -2938,11 +3626,13 @@ public:
 
 	size_type approximate_memory_use() const
 	{
+		const size_type number_of_groups = number_of_unused_groups + ((end_iterator.group_pointer == NULL) ? 0 : end_iterator.group_pointer->group_number + 1);
+
 		return static_cast<size_type>(
 			sizeof(*this) + // sizeof colony basic structure
 			(erased_locations.approximate_memory_use()) +  // sizeof erased_locations stack (stack structure sizeof included in colony basic structure sizeof so negated from result)
 			(capacity() * (sizeof(value_type) + sizeof(skipfield_type))) + // sizeof current colony data capacity + skipfields
-			((end_iterator.group_pointer == NULL) ? 0 : ((end_iterator.group_pointer->group_number + 1) * (sizeof(group) + sizeof(skipfield_type))))); // if colony not empty, add the memory usage of the group structures themselves, adding the extra skipfield entry
+			(number_of_groups * (sizeof(group) + sizeof(skipfield_type)))); // add the memory usage of the group structures themselves (including retained groups), adding the extra skipfield entry
 	}
 
 
@@ -2959,13 +3649,7 @@ public:
 
 		if (first_group != NULL && (first_group->size < min_allocation_amount || end_iterator.group_pointer->size > max_allocation_amount))
 		{
-			colony temp(*this);
-
-			#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-				*this = std::move(temp); // Avoid generating 2nd temporary
-			#else
-				this->swap(temp);
-			#endif
+			consolidate();
 		}
 	}
 
@@ -3006,10 +3690,37 @@ public:
 
 
 
-	void clear()
+	// If keep_capacity is true, groups are retained and reused by subsequent insertions rather than deallocated (eg. for per-frame scratch colonies).
+	// For trivially-destructible types this is O(1) (bar change tracking), as elements are not visited and retained groups are only reset once reused:
+	void clear(const bool keep_capacity = false)
 	{
-		destroy_all_data();
-		erased_locations.clear();
+		#ifdef PLF_COLONY_CHANGE_TRACKING
+			for (group_pointer_type current_group = first_group; current_group != NULL; current_group = current_group->next_group)
+			{
+				save_group_erasures(current_group);
+			}
+		#endif
+
+		if (keep_capacity)
+		{
+			if (first_group != NULL)
+			{
+				unused_groups_capacity = capacity(); // The retained groups' capacity is all of it
+				number_of_unused_groups += end_iterator.group_pointer->group_number + 1;
+				destroy_elements();
+				end_iterator.group_pointer->next_group = unused_groups;
+				unused_groups = first_group;
+				first_group = NULL;
+			}
+
+			erased_locations.reset();
+		}
+		else
+		{
+			destroy_all_data();
+			erased_locations.clear();
+		}
+
 		total_number_of_elements = 0;
 		begin_iterator.group_pointer = NULL;
 		begin_iterator.element_pointer = NULL;
@@ -3023,40 +3734,52 @@ public:
 	{
 		assert (&source != this);
 
-		destroy_all_data();
-		colony temp(source);
+		clear();
 
-		#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-			*this = std::move(temp); // Avoid generating 2nd temporary
-		#else
-			this->swap(temp);
+		#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+			propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_copy_assignment());
 		#endif
 
+		min_elements_per_group = source.min_elements_per_group;
+		group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+		erased_locations.group_allocator_pair.min_elements_per_group = source.erased_locations.group_allocator_pair.min_elements_per_group;
+
+		copy_from_source(source);
 		return *this;
 	}
 
 
 
 	#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-		// Move assignment
+		// Move assignment - if the allocators are unequal and do not propagate, the source's memory cannot be taken over and elements are moved individually:
 		colony & operator = (colony &&source)
 		{
 			assert (&source != this);
 
-			destroy_all_data();
+			#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+				if (!std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment::value && static_cast<const element_allocator_type &>(*this) != static_cast<const element_allocator_type &>(source))
+				{
+					clear();
+					min_elements_per_group = source.min_elements_per_group;
+					group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+					insert(std::make_move_iterator(source.begin_iterator), std::make_move_iterator(source.end_iterator));
 
-			// Move source values across:
-			end_iterator = std::move(source.end_iterator);
-			begin_iterator = std::move(source.begin_iterator);
-			first_group = std::move(source.first_group);
-			total_number_of_elements = source.total_number_of_elements;
-			min_elements_per_group = source.min_elements_per_group;
-			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+					#ifdef PLF_COLONY_CHANGE_TRACKING
+						reset_changes();
+					#endif
 
-			erased_locations = std::move(source.erased_locations);
+					return *this;
+				}
+			#endif
 
-			source.first_group = NULL;
-			source.total_number_of_elements = 0; // Nullifying the other data members is unnecessary - technically all can be removed except first_group NULL and total_number_of_elements 0, to allow for clean destructor usage
+			destroy_all_data();
+			erased_locations.clear();
+
+			#ifdef PLF_COLONY_ALLOCATOR_TRAITS_SUPPORT
+				propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment());
+			#endif
+
+			take_memory_from(source);
 			return *this;
 		}
 	#endif
@@ -3096,13 +3819,13 @@ public:
 
 	void shrink_to_fit()
 	{
-		if ((first_group == NULL) | (total_number_of_elements == capacity()))
+		if (total_number_of_elements == 0) // Edge case - also releases any groups retained by clear(true)
 		{
+			clear();
 			return;
 		}
-		else if (total_number_of_elements == 0) // Edge case
+		else if (total_number_of_elements == capacity())
 		{
-			clear();
 			return;
 		}
 
@@ -3110,13 +3833,7 @@ public:
 		min_elements_per_group = (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? static_cast<skipfield_type>(total_number_of_elements) : group_allocator_pair.max_elements_per_group;
 		min_elements_per_group = (min_elements_per_group < 3) ? 3 : min_elements_per_group;
 
-		colony temp(*this);
-
-		#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-			*this = std::move(temp); // Avoid generating 2nd temporary
-		#else
-			this->swap(temp);
-		#endif
+		consolidate();
 
 		min_elements_per_group = original_min_elements;
 	}
@@ -3140,6 +3857,10 @@ public:
 		{
 			if (first_group != NULL) // Edge case - empty colony but first group is initialized
 			{
+				#ifdef PLF_COLONY_CHANGE_TRACKING
+					save_group_erasures(first_group);
+				#endif
+
 				PLF_COLONY_DESTROY(group_allocator_type, group_allocator_pair, first_group);
 				PLF_COLONY_DEALLOCATE(group_allocator_type, group_allocator_pair, first_group, 1);
 			} // else: Empty colony, no inserts as yet, time to allocate
@@ -3157,13 +3878,7 @@ public:
 			const skipfield_type original_min_elements = min_elements_per_group;
 			min_elements_per_group = reserve_amount;
 
-			colony temp(*this);
-
-			#ifdef PLF_COLONY_MOVE_SEMANTICS_SUPPORT
-				*this = std::move(temp); // Avoid generating 2nd temporary
-			#else
-				this->swap(temp);
-			#endif
+			consolidate();
 
 			min_elements_per_group = original_min_elements;
 		}
@@ -3179,13 +3894,17 @@ public:
 			*this = std::move(temp);
 		#else
 			iterator				swap_end_iterator = end_iterator, swap_begin_iterator = begin_iterator;
-			group_pointer_type		swap_first_group = first_group;
+			group_pointer_type		swap_first_group = first_group, swap_unused_groups = unused_groups;
+			size_type				swap_unused_groups_capacity = unused_groups_capacity, swap_number_of_unused_groups = number_of_unused_groups;
 			size_type				swap_total_number_of_elements = total_number_of_elements;
 			skipfield_type 			swap_min_elements_per_group = min_elements_per_group, swap_max_elements_per_group = group_allocator_pair.max_elements_per_group;
 
 			end_iterator = source.end_iterator;
 			begin_iterator = source.begin_iterator;
 			first_group = source.first_group;
+			unused_groups = source.unused_groups;
+			unused_groups_capacity = source.unused_groups_capacity;
+			number_of_unused_groups = source.number_of_unused_groups;
 			total_number_of_elements = source.total_number_of_elements;
 			min_elements_per_group = source.min_elements_per_group;
 			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
@@ -3193,11 +3912,21 @@ public:
 			source.end_iterator = swap_end_iterator;
 			source.begin_iterator = swap_begin_iterator;
 			source.first_group = swap_first_group;
+			source.unused_groups = swap_unused_groups;
+			source.unused_groups_capacity = swap_unused_groups_capacity;
+			source.number_of_unused_groups = swap_number_of_unused_groups;
 			source.total_number_of_elements = swap_total_number_of_elements;
 			source.min_elements_per_group = swap_min_elements_per_group;
 			source.group_allocator_pair.max_elements_per_group = swap_max_elements_per_group;
 
+			version_counter = source.version_counter = (version_counter > source.version_counter) ? version_counter : source.version_counter;
+			generation = source.generation = ((generation > source.generation) ? generation : source.generation) + 1; // See take_memory_from()
+
 			erased_locations.swap(source.erased_locations);
+
+			#ifdef PLF_COLONY_CHANGE_TRACKING
+				freed_erasures.swap(source.freed_erasures);
+			#endif
 		#endif
 	}
 
@@ -3905,10 +4634,194 @@ public:
 	}
 
 
+	// Fill a frozen_view with pointers to all elements, in iteration order. If the view was last frozen against this colony, only groups which have had insertions or erasures since then are re-walked:
+	void freeze(frozen_view &view) const
+	{
+		typedef typename frozen_view::dense_pointer_type dense_pointer;
+		typedef typename frozen_view::segment segment;
+
+		if (view.frozen_colony != this || view.frozen_generation != generation)
+		{
+			view.clear();
+		}
+
+		view.reserve_back_buffers(total_number_of_elements, (first_group == NULL) ? 0 : end_iterator.group_pointer->group_number + 1);
+
+		const dense_pointer old_pointers = view.pointers, new_pointers = view.back_pointers;
+		size_type number_of_pointers = 0, number_of_segments = 0, old_segment_index = 0;
+
+		for (group_pointer_type current_group = first_group; current_group != NULL; current_group = current_group->next_group)
+		{
+			segment &new_segment = view.back_segments[number_of_segments++];
+			new_segment.group_pointer = current_group;
+			new_segment.first_index = number_of_pointers;
+			new_segment.version = current_group->version;
+
+			// Groups are only ever removed from the chain or appended to it, so groups from the previous snapshot appear in the same relative order - search forward from the last match:
+			size_type search_index = old_segment_index;
+
+			while (search_index != view.number_of_segments && view.segments[search_index].group_pointer != current_group)
+			{
+				++search_index;
+			}
+
+			// Versions are unique within a generation of the colony, so a matching version means the group has not changed since this view last saw it:
+			if (search_index != view.number_of_segments && view.segments[search_index].version == current_group->version)
+			{
+				const size_type old_begin = view.segments[search_index].first_index;
+				const size_type old_end = (search_index + 1 == view.number_of_segments) ? view.number_of_pointers : view.segments[search_index + 1].first_index;
+				assert(old_end - old_begin == static_cast<size_type>(current_group->number_of_elements));
+
+				if (old_end != old_begin)
+				{
+					#ifdef PLF_COLONY_TYPE_TRAITS_SUPPORT
+						if (std::is_trivially_copyable<element_pointer_type>::value)
+						{
+							std::memcpy(&*(new_pointers + number_of_pointers), &*(old_pointers + old_begin), (old_end - old_begin) * sizeof(element_pointer_type)); // &* to avoid problems with non-trivial pointers that are trivially-copyable
+						}
+						else
+					#endif
+					{
+						std::uninitialized_copy(old_pointers + old_begin, old_pointers + old_end, new_pointers + number_of_pointers);
+					}
+				}
+
+				number_of_pointers += old_end - old_begin;
+				old_segment_index = search_index + 1;
+				continue;
+			}
+
+			// Group has changed (or was not found in the previous snapshot) - re-walk it's skipfield:
+			const element_pointer_type end_pointer = current_group->last_endpoint;
+			element_pointer_type element_pointer = current_group->elements + *(current_group->skipfield);
+			skipfield_pointer_type skipfield_pointer = current_group->skipfield + *(current_group->skipfield);
+
+			while (element_pointer != end_pointer)
+			{
+				PLF_COLONY_CONSTRUCT(element_pointer_allocator_type, static_cast<element_pointer_allocator_type &>(view), new_pointers + number_of_pointers++, element_pointer);
+				++skipfield_pointer;
+				element_pointer += 1 + *skipfield_pointer;
+				skipfield_pointer += *skipfield_pointer;
+			}
+		}
+
+		// Swap buffers:
+		view.destroy_pointers(old_pointers, view.number_of_pointers);
+		view.back_pointers = old_pointers;
+		view.pointers = new_pointers;
+		view.number_of_pointers = number_of_pointers;
+
+		const typename frozen_view::segment_pointer_type old_segments = view.segments;
+		view.segments = view.back_segments;
+		view.back_segments = old_segments;
+		view.number_of_segments = number_of_segments;
+
+		view.frozen_colony = this;
+		view.frozen_generation = generation;
+	}
+
+
+
+	#ifdef PLF_COLONY_CHANGE_TRACKING
+		enum change_type
+		{
+			change_inserted = 1,
+			change_erased = 2,
+			change_modified = 4
+		};
+
+
+
+		// Elements modified in-place (via an iterator) must be flagged manually. Has no effect on elements inserted since the last reset_changes(), as these are already reported:
+		inline void mark_modified(const const_iterator &the_iterator) PLF_COLONY_NOEXCEPT
+		{
+			assert(the_iterator.group_pointer != NULL);
+			assert(*(the_iterator.skipfield_pointer) == 0); // ie. not an erased element
+
+			const group_pointer_type the_group = the_iterator.group_pointer;
+			const size_type index = static_cast<size_type>(the_iterator.element_pointer - the_group->elements);
+			const unsigned char bit = static_cast<unsigned char>(1U << (index % CHAR_BIT));
+			const uchar_pointer_type inserted = the_group->change_bits + (index / CHAR_BIT);
+
+			if (!(*inserted & bit))
+			{
+				*(inserted + (group::change_plane_size(the_group->size) * 2)) |= bit;
+			}
+		}
+
+
+
+		// Calls function(element_pointer, change_flags) for every slot which has changed since the last reset_changes(), where change_flags is a combination of change_type values.
+		// The element pointer may only be dereferenced if change_inserted or change_modified is set - erased slots are reported by address only, for identification.
+		// Erasures from groups which have since been deallocated are reported first, as a group allocated since may occupy the same addresses - any element reported at such an address is newer,
+		// so applying changes in the order reported (eg. to a replica) never removes a live element.
+		// Note: clear() reports all elements as erased, but operations which reallocate the colony (copy/move assignment, shrink_to_fit, change_group_sizes, reserve on a non-empty colony) do not preserve the log.
+		template <class function_type>
+		void for_each_change(function_type function) const
+		{
+			if (freed_erasures.total_number_of_elements != 0)
+			{
+				for (typename reduced_stack::stack_group_pointer_type current_group = freed_erasures.first_group; ; current_group = current_group->next_group)
+				{
+					const typename reduced_stack::stack_element_pointer_type past_end = (current_group == freed_erasures.current_group) ? freed_erasures.top_element + 1 : current_group->end + 1;
+
+					for (typename reduced_stack::stack_element_pointer_type current_element = current_group->elements; current_element != past_end; ++current_element)
+					{
+						function(*current_element, static_cast<unsigned char>(change_erased));
+					}
+
+					if (current_group == freed_erasures.current_group)
+					{
+						break;
+					}
+				}
+			}
+
+			for (group_pointer_type current_group = first_group; current_group != NULL; current_group = current_group->next_group)
+			{
+				const size_type plane_size = group::change_plane_size(current_group->size);
+				const uchar_pointer_type inserted = current_group->change_bits, erased = inserted + plane_size, modified = erased + plane_size;
+
+				for (size_type byte_index = 0; byte_index != plane_size; ++byte_index)
+				{
+					unsigned int bits = inserted[byte_index] | erased[byte_index] | modified[byte_index];
+
+					while (bits != 0) // Only visit set bits
+					{
+						unsigned int bit_index = 0;
+
+						while (!(bits & (1U << bit_index)))
+						{
+							++bit_index;
+						}
+
+						const unsigned char change_flags = static_cast<unsigned char>(((inserted[byte_index] >> bit_index) & 1U) | (((erased[byte_index] >> bit_index) & 1U) << 1) | (((modified[byte_index] >> bit_index) & 1U) << 2));
+						function(current_group->elements + ((byte_index * CHAR_BIT) + bit_index), change_flags);
+						bits &= bits - 1; // Clear lowest set bit
+					}
+				}
+			}
+		}
+
+
+
+		void reset_changes() PLF_COLONY_NOEXCEPT
+		{
+			for (group_pointer_type current_group = first_group; current_group != NULL; current_group = current_group->next_group)
+			{
+				std::memset(&*(current_group->change_bits), 0, 3 * group::change_plane_size(current_group->size));
+			}
+
+			freed_erasures.clear();
+		}
+	#endif
+
+
+
 
     inline allocator_type get_allocator() const PLF_COLONY_NOEXCEPT
     {
-		return element_allocator_type();
+		return *this;
 	}
 
 };	// colony
@@ -0,0 +1,631 @@
+#ifndef PLF_CONCURRENT_STACK_H
+#define PLF_CONCURRENT_STACK_H
+
+// Concurrent variants of plf::stack, retaining it's chained-group memory layout (groups of elements, each double the capacity of the last up to a maximum, linked to their neighbours).
+// spsc_stack: one producer thread pushes while one consumer thread pops. Lock-free - both sides operate on a single atomic top word.
+// mpsc_stack: any number of producer threads push through their own producer handles, each filling a private group which is linked onto the stack when full or flushed. One consumer thread pops.
+// Both require C++11 (std::atomic), and raw (non-fancy) allocator pointers.
+
+#include <atomic>
+#include <cassert>	// assert
+#include <cstddef>	// std::size_t
+#include <limits>	// std::numeric_limits
+#include <memory>	// std::allocator, std::allocator_traits
+#include <new>
+#include <type_traits>
+#include <utility>	// std::move, std::forward
+
+
+namespace plf
+{
+
+
+// Single-producer, single-consumer stack.
+// The top of the stack is one atomic word holding the number of elements (shifted left by one) and a 'pop in progress' flag in the lowest bit. The producer constructs each element in the
+// first free slot and then publishes it by incrementing the count. The consumer sets the flag, takes the top element, and clears the flag while decrementing the count.
+// If the producer pushed while a pop was in progress, the consumer closes the gap left by the popped element by moving the newer elements down before releasing the flag;
+// if the consumer popped while a push was in progress, the producer moves it's element down to the new top. Hence element_type must be nothrow-move-constructible.
+// Elements are popped in LIFO order. Groups are never deallocated before destruction, so that neither side can observe a freed group.
+template <class element_type, class element_allocator_type = std::allocator<element_type> > class spsc_stack : private element_allocator_type  // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	typedef element_type																value_type;
+	typedef element_allocator_type														allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::size_type		size_type;
+	typedef element_type &																reference;
+	typedef const element_type &														const_reference;
+
+private:
+	struct group; // Forward declaration for typedefs below
+
+	typedef typename std::allocator_traits<element_allocator_type>::template rebind_alloc<group> group_allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::pointer 	element_pointer_type;
+
+	static_assert(std::is_pointer<element_pointer_type>::value, "spsc_stack requires an allocator with raw pointers, as group pointers are atomic");
+	static_assert(std::is_nothrow_move_constructible<element_type>::value, "spsc_stack moves elements between slots while both threads are active, and cannot recover from a throwing move");
+
+	struct group
+	{
+		const element_pointer_type		elements;
+		std::atomic<group *>			next_group; // Written by the producer when it allocates the next group, read by the consumer when it closes a gap across a group boundary
+		group * const					previous_group;
+		const size_type					first_index; // Index in the stack of elements[0]
+		const size_type					size;
+
+		group(const element_pointer_type group_elements, group * const previous, const size_type index, const size_type elements_per_group) noexcept:
+			elements(group_elements),
+			next_group(nullptr),
+			previous_group(previous),
+			first_index(index),
+			size(elements_per_group)
+		{}
+	};
+
+
+	static const size_type pop_in_progress = 1;
+
+	group *									first_group; // Written by the producer before it's first push is published
+	size_type								min_elements_per_group, max_elements_per_group;
+	struct ebco_pair : group_allocator_type // Packaging the group allocator with the producer's state, for empty-base-class optimisation
+	{
+		group *producer_group; // Cached group containing the producer's last slot - only accessed by the producer
+		explicit ebco_pair(const element_allocator_type &alloc) : group_allocator_type(alloc), producer_group(nullptr) {};
+	}										group_allocator_pair;
+
+	alignas(64) std::atomic<size_type>		top_word; // Number of elements << 1, | pop_in_progress
+	alignas(64) group *						consumer_group; // Cached group containing the consumer's last slot - only accessed by the consumer
+
+
+public:
+
+	explicit spsc_stack(const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		first_group(nullptr),
+		min_elements_per_group((sizeof(element_type) * 8 > sizeof(group) * 2) ? 8 : ((sizeof(group) * 2) / sizeof(element_type)) + 1),
+		max_elements_per_group(std::numeric_limits<size_type>::max() / 4),
+		group_allocator_pair(alloc),
+		top_word(0),
+		consumer_group(nullptr)
+	{}
+
+
+
+	explicit spsc_stack(const size_type min_allocation_amount, const size_type max_allocation_amount = (std::numeric_limits<size_type>::max() / 4), const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		first_group(nullptr),
+		min_elements_per_group(min_allocation_amount),
+		max_elements_per_group(max_allocation_amount),
+		group_allocator_pair(alloc),
+		top_word(0),
+		consumer_group(nullptr)
+	{
+		assert(min_elements_per_group > 2);
+		assert(min_elements_per_group <= max_elements_per_group);
+		assert(max_elements_per_group <= std::numeric_limits<size_type>::max() / 4); // The element count is stored shifted left by one, and groups double the capacity of the stack
+	}
+
+
+
+	spsc_stack(const spsc_stack &) = delete;
+	spsc_stack & operator = (const spsc_stack &) = delete;
+
+
+
+	// Not thread-safe - both threads must have finished with the stack:
+	~spsc_stack() noexcept
+	{
+		size_type remaining = top_word.load(std::memory_order_acquire) >> 1;
+
+		for (group *current_group = first_group; current_group != nullptr;)
+		{
+			if (!std::is_trivially_destructible<element_type>::value)
+			{
+				const size_type used = (remaining < current_group->size) ? remaining : current_group->size;
+
+				for (element_pointer_type element_pointer = current_group->elements; element_pointer != current_group->elements + used; ++element_pointer)
+				{
+					std::allocator_traits<element_allocator_type>::destroy(*this, element_pointer);
+				}
+
+				remaining -= used;
+			}
+
+			group * const next_group = current_group->next_group.load(std::memory_order_relaxed);
+			std::allocator_traits<element_allocator_type>::deallocate(*this, current_group->elements, current_group->size);
+			std::allocator_traits<group_allocator_type>::destroy(group_allocator_pair, current_group);
+			std::allocator_traits<group_allocator_type>::deallocate(group_allocator_pair, current_group, 1);
+			current_group = next_group;
+		}
+	}
+
+
+
+	// Producer only:
+	template <typename... arguments>
+	void emplace(arguments &&... parameters)
+	{
+		size_type word = top_word.load(std::memory_order_acquire);
+		element_pointer_type slot = producer_slot(word >> 1);
+
+		std::allocator_traits<element_allocator_type>::construct(*this, slot, std::forward<arguments>(parameters)...); // If this throws, nothing has been published
+
+		while (!top_word.compare_exchange_weak(word, word + 2, std::memory_order_release, std::memory_order_acquire))
+		{
+			// The consumer has changed the word - if it popped, the first free slot is now lower:
+			const element_pointer_type new_slot = producer_slot(word >> 1);
+
+			if (new_slot != slot)
+			{
+				std::allocator_traits<element_allocator_type>::construct(*this, new_slot, std::move(*slot));
+				std::allocator_traits<element_allocator_type>::destroy(*this, slot);
+				slot = new_slot;
+			}
+		}
+	}
+
+
+
+	void push(const element_type &element)
+	{
+		emplace(element);
+	}
+
+
+
+	void push(element_type &&element)
+	{
+		emplace(std::move(element));
+	}
+
+
+
+	// Consumer only. Moves the top element into destination and returns true, or returns false if the stack is empty:
+	bool try_pop(element_type &destination)
+	{
+		size_type word = top_word.load(std::memory_order_acquire);
+
+		do
+		{
+			if ((word >> 1) == 0)
+			{
+				return false;
+			}
+		} while (!top_word.compare_exchange_weak(word, word | pop_in_progress, std::memory_order_acquire, std::memory_order_acquire));
+
+		size_type gap = (word >> 1) - 1;
+		element_pointer_type slot = consumer_slot(gap);
+
+		destination = std::move(*slot);
+		std::allocator_traits<element_allocator_type>::destroy(*this, slot);
+
+		word = ((gap + 1) << 1) | pop_in_progress;
+
+		while (!top_word.compare_exchange_weak(word, gap << 1, std::memory_order_release, std::memory_order_acquire))
+		{
+			if ((word >> 1) != gap + 1) // The producer has pushed above the gap - move the element above it down:
+			{
+				const element_pointer_type above = consumer_slot(gap + 1);
+				std::allocator_traits<element_allocator_type>::construct(*this, slot, std::move(*above));
+				std::allocator_traits<element_allocator_type>::destroy(*this, above);
+				slot = above;
+				++gap;
+			}
+
+			word = ((gap + 1) << 1) | pop_in_progress;
+		}
+
+		return true;
+	}
+
+
+
+	// Both are only a snapshot when the other thread is active:
+	bool empty() const noexcept
+	{
+		return (top_word.load(std::memory_order_acquire) >> 1) == 0;
+	}
+
+
+
+	size_type size() const noexcept
+	{
+		return top_word.load(std::memory_order_acquire) >> 1;
+	}
+
+
+
+	allocator_type get_allocator() const noexcept
+	{
+		return *this;
+	}
+
+
+
+private:
+
+	element_pointer_type producer_slot(const size_type index)
+	{
+		group *&current_group = group_allocator_pair.producer_group;
+
+		if (current_group == nullptr)
+		{
+			first_group = current_group = create_group(nullptr);
+		}
+
+		while (index < current_group->first_index)
+		{
+			current_group = current_group->previous_group;
+		}
+
+		while (index >= current_group->first_index + current_group->size)
+		{
+			group *next_group = current_group->next_group.load(std::memory_order_relaxed);
+
+			if (next_group == nullptr)
+			{
+				next_group = create_group(current_group);
+				current_group->next_group.store(next_group, std::memory_order_release);
+			}
+
+			current_group = next_group;
+		}
+
+		return current_group->elements + (index - current_group->first_index);
+	}
+
+
+
+	// Only called for indexes which the consumer has seen published, so the groups containing them are visible to it:
+	element_pointer_type consumer_slot(const size_type index) noexcept
+	{
+		if (consumer_group == nullptr)
+		{
+			consumer_group = first_group;
+		}
+
+		while (index < consumer_group->first_index)
+		{
+			consumer_group = consumer_group->previous_group;
+		}
+
+		while (index >= consumer_group->first_index + consumer_group->size)
+		{
+			consumer_group = consumer_group->next_group.load(std::memory_order_acquire);
+		}
+
+		return consumer_group->elements + (index - consumer_group->first_index);
+	}
+
+
+
+	group * create_group(group * const previous)
+	{
+		const size_type first_index = (previous == nullptr) ? 0 : previous->first_index + previous->size;
+		const size_type elements_per_group = (previous == nullptr) ? min_elements_per_group : (first_index < max_elements_per_group) ? first_index : max_elements_per_group; // Double the capacity, as per plf::stack
+		const element_pointer_type elements = std::allocator_traits<element_allocator_type>::allocate(*this, elements_per_group);
+		group *new_group;
+
+		try
+		{
+			new_group = std::allocator_traits<group_allocator_type>::allocate(group_allocator_pair, 1);
+		}
+		catch (...)
+		{
+			std::allocator_traits<element_allocator_type>::deallocate(*this, elements, elements_per_group);
+			throw;
+		}
+
+		std::allocator_traits<group_allocator_type>::construct(group_allocator_pair, new_group, elements, previous, first_index, elements_per_group);
+		return new_group;
+	}
+};
+
+
+
+
+// Multi-producer, single-consumer stack.
+// Each producer thread pushes through it's own producer handle, which fills a private group without synchronisation. A group is linked onto the stack (with a single compare-exchange)
+// when it is full, when flush() is called, or when the handle is destroyed - so elements become visible to the consumer a group at a time. This batching is part of the contract: a push
+// alone never makes an element visible, so a producer which stops pushing part-way through a group (eg. to wait for the consumer's response) must call flush() first, or the consumer
+// may never see those elements. Publishing each push instead would let the consumer pop from a group while it's producer constructs into it, needing spsc_stack's gap protocol per group.
+// The consumer pops from the most recently linked group first, taking newly-linked groups from the stack on each pop, and deallocates groups once they are emptied.
+template <class element_type, class element_allocator_type = std::allocator<element_type> > class mpsc_stack : private element_allocator_type  // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	typedef element_type																value_type;
+	typedef element_allocator_type														allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::size_type		size_type;
+	typedef element_type &																reference;
+	typedef const element_type &														const_reference;
+
+private:
+	struct group; // Forward declaration for typedefs below
+
+	typedef typename std::allocator_traits<element_allocator_type>::template rebind_alloc<group> group_allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::pointer 	element_pointer_type;
+
+	static_assert(std::is_pointer<element_pointer_type>::value, "mpsc_stack requires an allocator with raw pointers, as group pointers are atomic");
+
+	struct group
+	{
+		const element_pointer_type		elements;
+		group *							next_group; // The next-older group once linked
+		size_type						number_of_elements;
+		const size_type					size;
+
+		group(const element_pointer_type group_elements, const size_type elements_per_group) noexcept:
+			elements(group_elements),
+			next_group(nullptr),
+			number_of_elements(0),
+			size(elements_per_group)
+		{}
+	};
+
+
+	size_type								min_elements_per_group, max_elements_per_group;
+	group_allocator_type					group_allocator;
+	alignas(64) std::atomic<group *>		linked_groups; // Groups linked by producers and not yet taken by the consumer, newest first
+	alignas(64) group *						consumer_group; // Groups taken by the consumer, newest (currently popped) first - only accessed by the consumer
+
+
+public:
+
+	// Handle through which one thread pushes to the stack. Not thread-safe itself - each producer thread needs it's own:
+	class producer
+	{
+	public:
+		explicit producer(mpsc_stack &destination) noexcept:
+			stack(&destination),
+			current_group(nullptr),
+			next_group_size(destination.min_elements_per_group)
+		{}
+
+
+
+		producer(producer &&source) noexcept:
+			stack(source.stack),
+			current_group(source.current_group),
+			next_group_size(source.next_group_size)
+		{
+			source.current_group = nullptr;
+		}
+
+
+
+		producer(const producer &) = delete;
+		producer & operator = (const producer &) = delete;
+
+
+
+		~producer()
+		{
+			flush();
+		}
+
+
+
+		template <typename... arguments>
+		void emplace(arguments &&... parameters)
+		{
+			if (current_group == nullptr || current_group->number_of_elements == current_group->size)
+			{
+				flush();
+				current_group = stack->create_group(next_group_size);
+				next_group_size = (next_group_size < stack->max_elements_per_group / 2) ? next_group_size * 2 : stack->max_elements_per_group;
+			}
+
+			std::allocator_traits<element_allocator_type>::construct(*stack, current_group->elements + current_group->number_of_elements, std::forward<arguments>(parameters)...);
+			++(current_group->number_of_elements);
+		}
+
+
+
+		void push(const element_type &element)
+		{
+			emplace(element);
+		}
+
+
+
+		void push(element_type &&element)
+		{
+			emplace(std::move(element));
+		}
+
+
+
+		// Makes all elements pushed through this handle so far visible to the consumer - until then, only elements in groups which filled up are visible.
+		// Subsequent pushes go to a new group:
+		void flush() noexcept
+		{
+			if (current_group == nullptr)
+			{
+				return;
+			}
+
+			if (current_group->number_of_elements == 0)
+			{
+				stack->destroy_group(current_group);
+			}
+			else
+			{
+				stack->link_group(current_group);
+			}
+
+			current_group = nullptr;
+		}
+
+	private:
+		mpsc_stack *	stack;
+		group *			current_group;
+		size_type		next_group_size;
+	};
+
+
+
+	explicit mpsc_stack(const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		min_elements_per_group((sizeof(element_type) * 8 > sizeof(group) * 2) ? 8 : ((sizeof(group) * 2) / sizeof(element_type)) + 1),
+		max_elements_per_group(8192),
+		group_allocator(alloc),
+		linked_groups(nullptr),
+		consumer_group(nullptr)
+	{}
+
+
+
+	explicit mpsc_stack(const size_type min_allocation_amount, const size_type max_allocation_amount = 8192, const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		min_elements_per_group(min_allocation_amount),
+		max_elements_per_group(max_allocation_amount),
+		group_allocator(alloc),
+		linked_groups(nullptr),
+		consumer_group(nullptr)
+	{
+		assert(min_elements_per_group > 0);
+		assert(min_elements_per_group <= max_elements_per_group);
+	}
+
+
+
+	mpsc_stack(const mpsc_stack &) = delete;
+	mpsc_stack & operator = (const mpsc_stack &) = delete;
+
+
+
+	// Not thread-safe - all producer handles must have been destroyed, and the consumer finished with the stack:
+	~mpsc_stack() noexcept
+	{
+		take_linked_groups();
+
+		while (consumer_group != nullptr)
+		{
+			group * const next_group = consumer_group->next_group;
+			destroy_group(consumer_group);
+			consumer_group = next_group;
+		}
+	}
+
+
+
+	// Consumer only. Moves the top element of the most recently linked group into destination and returns true, or returns false if no linked group has elements:
+	bool try_pop(element_type &destination)
+	{
+		if (linked_groups.load(std::memory_order_relaxed) != nullptr)
+		{
+			take_linked_groups();
+		}
+
+		if (consumer_group == nullptr)
+		{
+			return false;
+		}
+
+		const element_pointer_type top = consumer_group->elements + --(consumer_group->number_of_elements);
+		destination = std::move(*top);
+		std::allocator_traits<element_allocator_type>::destroy(*this, top);
+
+		if (consumer_group->number_of_elements == 0)
+		{
+			group * const next_group = consumer_group->next_group;
+			destroy_group(consumer_group);
+			consumer_group = next_group;
+		}
+
+		return true;
+	}
+
+
+
+	// Consumer only - elements in groups not yet linked by their producers are not counted:
+	bool empty() const noexcept
+	{
+		return consumer_group == nullptr && linked_groups.load(std::memory_order_acquire) == nullptr;
+	}
+
+
+
+	allocator_type get_allocator() const noexcept
+	{
+		return *this;
+	}
+
+
+
+private:
+
+	group * create_group(const size_type elements_per_group)
+	{
+		const element_pointer_type elements = std::allocator_traits<element_allocator_type>::allocate(*this, elements_per_group);
+		group *new_group;
+
+		try
+		{
+			new_group = std::allocator_traits<group_allocator_type>::allocate(group_allocator, 1);
+		}
+		catch (...)
+		{
+			std::allocator_traits<element_allocator_type>::deallocate(*this, elements, elements_per_group);
+			throw;
+		}
+
+		std::allocator_traits<group_allocator_type>::construct(group_allocator, new_group, elements, elements_per_group);
+		return new_group;
+	}
+
+
+
+	void destroy_group(group * const the_group) noexcept
+	{
+		if (!std::is_trivially_destructible<element_type>::value)
+		{
+			for (element_pointer_type element_pointer = the_group->elements; element_pointer != the_group->elements + the_group->number_of_elements; ++element_pointer)
+			{
+				std::allocator_traits<element_allocator_type>::destroy(*this, element_pointer);
+			}
+		}
+
+		std::allocator_traits<element_allocator_type>::deallocate(*this, the_group->elements, the_group->size);
+		std::allocator_traits<group_allocator_type>::destroy(group_allocator, the_group);
+		std::allocator_traits<group_allocator_type>::deallocate(group_allocator, the_group, 1);
+	}
+
+
+
+	void link_group(group * const the_group) noexcept
+	{
+		the_group->next_group = linked_groups.load(std::memory_order_relaxed);
+
+		while (!linked_groups.compare_exchange_weak(the_group->next_group, the_group, std::memory_order_release, std::memory_order_relaxed))
+		{}
+	}
+
+
+
+	// Takes every linked group in one exchange (so there is no ABA problem with a single consumer) and places them above the groups already taken:
+	void take_linked_groups() noexcept
+	{
+		group * const newest = linked_groups.exchange(nullptr, std::memory_order_acquire);
+
+		if (newest == nullptr)
+		{
+			return;
+		}
+
+		group *oldest = newest;
+
+		while (oldest->next_group != nullptr)
+		{
+			oldest = oldest->next_group;
+		}
+
+		oldest->next_group = consumer_group;
+		consumer_group = newest;
+	}
+};
+
+
+} // plf namespace
+
+
+#endif // PLF_CONCURRENT_STACK_H
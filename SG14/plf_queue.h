@@ -0,0 +1,1174 @@
+// Copyright (c) 2016, Matthew Bentley (mattreecebentley@gmail.com) www.plflib.org
+
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgement in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+
+
+#ifndef PLF_QUEUE_H
+#define PLF_QUEUE_H
+
+
+
+// Compiler-specific defines used by queue:
+#if defined(_MSC_VER)
+	#define PLF_QUEUE_FORCE_INLINE __forceinline
+
+	#if _MSC_VER < 1600
+		#define PLF_QUEUE_NOEXCEPT throw()
+		#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator)
+	#elif _MSC_VER == 1600
+		#define PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		#define PLF_QUEUE_NOEXCEPT throw()
+		#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator)
+	#elif _MSC_VER == 1700
+		#define PLF_QUEUE_TYPE_TRAITS_SUPPORT
+		#define PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		#define PLF_QUEUE_NOEXCEPT throw()
+		#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator)
+	#elif _MSC_VER == 1800
+		#define PLF_QUEUE_TYPE_TRAITS_SUPPORT
+		#define PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_QUEUE_VARIADICS_SUPPORT
+		#define PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		#define PLF_QUEUE_NOEXCEPT throw()
+		#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator)
+	#elif _MSC_VER >= 1900
+		#define PLF_QUEUE_TYPE_TRAITS_SUPPORT
+		#define PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_QUEUE_VARIADICS_SUPPORT
+		#define PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		#define PLF_QUEUE_NOEXCEPT noexcept
+		#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator) noexcept(std::allocator_traits<the_allocator>::propagate_on_container_swap::value)
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L
+	#define PLF_QUEUE_FORCE_INLINE // note: GCC creates faster code without forcing inline
+
+	#if defined(__GNUC__) && !defined(__clang__) // If compiler is GCC/G++
+		#if __GNUC__ >= 5 // GCC v4.9 and below do not support std::is_trivially_copyable
+			#define PLF_QUEUE_TYPE_TRAITS_SUPPORT
+		#endif
+	#else // Assume type traits support for non-GCC compilers
+		#define PLF_QUEUE_TYPE_TRAITS_SUPPORT
+	#endif
+
+	#define PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+	#define PLF_QUEUE_VARIADICS_SUPPORT // Variadics, in this context, means both variadic templates and variadic macros are supported
+	#define PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+	#define PLF_QUEUE_NOEXCEPT noexcept
+	#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator) noexcept(std::allocator_traits<the_allocator>::propagate_on_container_swap::value)
+#else
+	#define PLF_QUEUE_FORCE_INLINE
+	#define PLF_QUEUE_NOEXCEPT throw()
+	#define PLF_QUEUE_NOEXCEPT_SWAP(the_allocator)
+#endif
+
+
+#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+	#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+		#define PLF_QUEUE_CONSTRUCT(the_allocator, allocator_instance, location, ...) std::allocator_traits<the_allocator>::construct(allocator_instance, location, __VA_ARGS__)
+	#else
+		#define PLF_QUEUE_CONSTRUCT(the_allocator, allocator_instance, location, data) std::allocator_traits<the_allocator>::construct(allocator_instance, location, data)
+	#endif
+
+	#define PLF_QUEUE_DESTROY(the_allocator, allocator_instance, location) 			std::allocator_traits<the_allocator>::destroy(allocator_instance, location)
+	#define PLF_QUEUE_ALLOCATE(the_allocator, allocator_instance, size, hint) 		std::allocator_traits<the_allocator>::allocate(allocator_instance, size, hint)
+ 	#define PLF_QUEUE_ALLOCATE_INITIALIZATION(the_allocator, size, hint) 			std::allocator_traits<the_allocator>::allocate(*this, size, hint)
+	#define PLF_QUEUE_DEALLOCATE(the_allocator, allocator_instance, location, size) std::allocator_traits<the_allocator>::deallocate(allocator_instance, location, size)
+#else
+	#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+		#define PLF_QUEUE_CONSTRUCT(the_allocator, allocator_instance, location, ...) 	allocator_instance.construct(location, __VA_ARGS__)
+	#else
+		#define PLF_QUEUE_CONSTRUCT(the_allocator, allocator_instance, location, data) 	allocator_instance.construct(location, data)
+	#endif
+
+	#define PLF_QUEUE_DESTROY(the_allocator, allocator_instance, location) 				allocator_instance.destroy(location)
+	#define PLF_QUEUE_ALLOCATE(the_allocator, allocator_instance, size, hint) 			allocator_instance.allocate(size, hint)
+	#define PLF_QUEUE_ALLOCATE_INITIALIZATION(the_allocator, size, hint) 				the_allocator::allocate(size, hint)
+	#define PLF_QUEUE_DEALLOCATE(the_allocator, allocator_instance, location, size) 	allocator_instance.deallocate(location, size)
+#endif
+
+
+
+
+
+#include <cassert>	// assert
+#include <iterator> // std::forward_iterator_tag
+#include <limits>  // std::numeric_limits
+#include <memory>	// std::allocator
+
+#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+	#include <utility> // std::move
+#endif
+
+#if defined(PLF_QUEUE_TYPE_TRAITS_SUPPORT) || defined(PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT)
+	#include <type_traits> // std::is_trivially_destructible, std::true_type
+#endif
+
+
+
+
+namespace plf
+{
+
+
+// A FIFO container using plf::stack's chained-group design: elements are pushed at the back of the newest group and popped from the front of the oldest, groups grow with the size
+// of the queue up to max_elements_per_group, and elements are never reallocated. A group drained by pops is unlinked from the front and reused for later pushes at the back,
+// unless it is smaller than the group currently being pushed to, in which case it is deallocated.
+template <class element_type, class element_allocator_type = std::allocator<element_type> > class queue : private element_allocator_type  // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	// Standard container typedefs:
+	typedef element_type																value_type;
+	typedef element_allocator_type														allocator_type;
+
+	#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		typedef typename std::allocator_traits<element_allocator_type>::size_type		size_type;
+		typedef element_type &															reference;
+		typedef const element_type &													const_reference;
+		typedef typename std::allocator_traits<element_allocator_type>::pointer 		pointer;
+		typedef typename std::allocator_traits<element_allocator_type>::const_pointer	const_pointer;
+		typedef typename std::allocator_traits<element_allocator_type>::difference_type	difference_type;
+	#else
+		typedef typename element_allocator_type::size_type			size_type;
+		typedef typename element_allocator_type::difference_type	difference_type;
+		typedef typename element_allocator_type::reference			reference;
+		typedef typename element_allocator_type::const_reference	const_reference;
+		typedef typename element_allocator_type::pointer			pointer;
+		typedef typename element_allocator_type::const_pointer		const_pointer;
+	#endif
+
+private:
+	struct group; // Forward declaration for typedefs below
+
+	#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		typedef typename std::allocator_traits<element_allocator_type>::template rebind_alloc<group> group_allocator_type;
+		typedef typename std::allocator_traits<group_allocator_type>::pointer		group_pointer_type;
+		typedef typename std::allocator_traits<element_allocator_type>::pointer 	element_pointer_type;
+	#else
+		typedef typename element_allocator_type::template rebind<group>::other	group_allocator_type;
+		typedef typename group_allocator_type::pointer							group_pointer_type;
+		typedef typename element_allocator_type::pointer						element_pointer_type;
+	#endif
+
+	struct group : private element_allocator_type // Empty base class optimisation - inheriting allocator functions
+	{
+		const element_pointer_type		elements;
+		group_pointer_type				next_group; // Groups are only ever traversed from front to back, so no previous_group is needed
+		const element_pointer_type		end; // End is the actual end element of the group, not one-past the end element, as in stack
+
+
+		#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+			group(const group_allocator_type &alloc, const size_type elements_per_group, const element_pointer_type hint = NULL):
+				element_allocator_type(alloc),
+				elements(PLF_QUEUE_ALLOCATE_INITIALIZATION(element_allocator_type, elements_per_group, hint)),
+				next_group(NULL),
+				end(elements + elements_per_group - 1)
+			{}
+
+		#else
+			// As in stack, element_allocator_type::construct only supports copy construction in C++03, so the block is allocated in the "copy" constructor below and the size passed through next_group.
+			// There is no spare member to pass the allocation hint through, so it is not used:
+			group(const group_allocator_type &alloc, const size_type elements_per_group, const element_pointer_type = NULL):
+				element_allocator_type(alloc),
+				elements(NULL),
+				next_group(reinterpret_cast<group_pointer_type>(elements_per_group)),
+				end(NULL)
+			{}
+
+
+			// Not a real copy constructor ie. actually a move constructor. Only used for allocator.construct in C++03 for reasons stated above:
+			group(const group &source) PLF_QUEUE_NOEXCEPT:
+				element_allocator_type(source),
+				elements(PLF_QUEUE_ALLOCATE_INITIALIZATION(element_allocator_type, reinterpret_cast<size_type>(source.next_group), 0)),
+				next_group(NULL),
+				end(elements + reinterpret_cast<size_type>(source.next_group) - 1)
+			{}
+		#endif
+
+
+		~group() PLF_QUEUE_NOEXCEPT
+		{
+			PLF_QUEUE_DEALLOCATE(element_allocator_type, (*this), elements, (end - elements) + 1); // Size is calculated from end and elements
+		}
+	};
+
+
+	group_pointer_type		first_group, current_group; // The group holding the front element, and the group being pushed to. Unused groups, ready for reuse, follow current_group
+	element_pointer_type	front_element, front_end, back_element, end_element; // front_end and end_element are the end elements of first_group and current_group respectively
+	size_type				total_number_of_elements, min_elements_per_group;
+	struct ebco_pair : group_allocator_type // Packaging the group allocator with least-used member variable, for empty-base-class optimisation
+	{
+		size_type max_elements_per_group;
+		ebco_pair(const size_type max_elements, const element_allocator_type &alloc) : group_allocator_type(alloc), max_elements_per_group(max_elements) {};
+	}						group_allocator_pair;
+
+
+public:
+
+	// Read-only forward iterator, traversing from the front of the queue to the back. Invalidated by any push, pop or other modification of the queue:
+	class const_iterator
+	{
+	private:
+		group_pointer_type		group_pointer;
+		element_pointer_type	element_pointer;
+		group_pointer_type		last_group; // The queue's current group - groups past it are unused, so incrementing past it's end goes to end() rather than into the next group
+
+		friend class queue;
+
+		const_iterator(const group_pointer_type group, const element_pointer_type element, const group_pointer_type last) PLF_QUEUE_NOEXCEPT:
+			group_pointer(group),
+			element_pointer(element),
+			last_group(last)
+		{}
+
+	public:
+		typedef std::forward_iterator_tag 			iterator_category;
+		typedef typename queue::value_type 			value_type;
+		typedef typename queue::difference_type 	difference_type;
+		typedef typename queue::const_pointer		pointer;
+		typedef typename queue::const_reference		reference;
+
+
+		const_iterator() PLF_QUEUE_NOEXCEPT:
+			group_pointer(NULL),
+			element_pointer(NULL),
+			last_group(NULL)
+		{}
+
+
+
+		// As in stack, the group is compared as well as the element, as end() is one-past the current group's elements - which can be the address of another group's first element:
+		inline bool operator == (const const_iterator &rh) const PLF_QUEUE_NOEXCEPT
+		{
+			return element_pointer == rh.element_pointer && group_pointer == rh.group_pointer;
+		}
+
+
+
+		inline bool operator != (const const_iterator &rh) const PLF_QUEUE_NOEXCEPT
+		{
+			return !(*this == rh);
+		}
+
+
+
+		inline PLF_QUEUE_FORCE_INLINE reference operator * () const PLF_QUEUE_NOEXCEPT
+		{
+			return *element_pointer;
+		}
+
+
+
+		inline PLF_QUEUE_FORCE_INLINE pointer operator -> () const PLF_QUEUE_NOEXCEPT
+		{
+			return element_pointer;
+		}
+
+
+
+		inline PLF_QUEUE_FORCE_INLINE const_iterator & operator ++ () PLF_QUEUE_NOEXCEPT
+		{
+			if (element_pointer == group_pointer->end && group_pointer != last_group)
+			{
+				group_pointer = group_pointer->next_group;
+				element_pointer = group_pointer->elements;
+			}
+			else
+			{
+				++element_pointer;
+			}
+
+			return *this;
+		}
+
+
+
+		inline const_iterator operator ++ (int) PLF_QUEUE_NOEXCEPT
+		{
+			const const_iterator copy(*this);
+			++*this;
+			return copy;
+		}
+	};
+
+
+
+	explicit queue(const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		first_group(NULL),
+		current_group(NULL),
+		front_element(NULL),
+		front_end(NULL),
+		back_element(NULL),
+		end_element(NULL),
+		total_number_of_elements(0),
+		min_elements_per_group((sizeof(element_type) * 8 > (sizeof(*this) + sizeof(group)) * 2) ? 8 : (((sizeof(*this) + sizeof(group)) * 2) / sizeof(element_type)) + 1),
+		group_allocator_pair(std::numeric_limits<size_type>::max() / 2, alloc)
+	{
+		assert(min_elements_per_group > 2);
+		assert(min_elements_per_group <= group_allocator_pair.max_elements_per_group);
+	}
+
+
+
+	explicit queue(const size_type min_allocation_amount, const size_type max_allocation_amount = (std::numeric_limits<size_type>::max() / 2), const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		first_group(NULL),
+		current_group(NULL),
+		front_element(NULL),
+		front_end(NULL),
+		back_element(NULL),
+		end_element(NULL),
+		total_number_of_elements(0),
+		min_elements_per_group(min_allocation_amount),
+		group_allocator_pair(max_allocation_amount, alloc)
+	{
+		assert(min_elements_per_group > 2);
+		assert(min_elements_per_group <= group_allocator_pair.max_elements_per_group);
+		assert(group_allocator_pair.max_elements_per_group <= std::numeric_limits<size_type>::max() / 2);
+	}
+
+
+private:
+
+	// Copies the source's elements in front-to-back order, into a single group where they fit:
+	void copy_from_source(const queue &source)
+	{
+		assert(&source != this);
+
+		if (source.total_number_of_elements == 0)
+		{
+			return;
+		}
+
+		const size_type original_min_elements = min_elements_per_group;
+		min_elements_per_group = (source.total_number_of_elements < group_allocator_pair.max_elements_per_group) ? source.total_number_of_elements : group_allocator_pair.max_elements_per_group;
+		min_elements_per_group = (min_elements_per_group < 3) ? 3 : min_elements_per_group;
+		initialize();
+		min_elements_per_group = original_min_elements;
+
+		for (const_iterator current = source.begin(); current != source.end(); ++current)
+		{
+			push(*current);
+		}
+	}
+
+
+
+	// Resets this queue's members to the state of an empty queue with no groups, without deallocating anything:
+	void reset_members() PLF_QUEUE_NOEXCEPT
+	{
+		first_group = current_group = NULL;
+		front_element = front_end = back_element = end_element = NULL;
+		total_number_of_elements = 0;
+	}
+
+
+
+	#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		// Takes over the source's groups. This queue must not hold any memory, and it's allocator must be equal to the source's:
+		void take_memory_from(queue &source) PLF_QUEUE_NOEXCEPT
+		{
+			first_group = source.first_group;
+			current_group = source.current_group;
+			front_element = source.front_element;
+			front_end = source.front_end;
+			back_element = source.back_element;
+			end_element = source.end_element;
+			total_number_of_elements = source.total_number_of_elements;
+			min_elements_per_group = source.min_elements_per_group;
+			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+			source.reset_members();
+		}
+
+
+
+		// Used when the source's memory belongs to an unequal allocator. Elements are moved in front-to-back order so that the queue order is preserved:
+		void move_elements_from(queue &source)
+		{
+			if (source.total_number_of_elements == 0)
+			{
+				return;
+			}
+
+			for (const_iterator current = source.begin(); current != source.end(); ++current)
+			{
+				push(std::move(*const_cast<element_type *>(&*current)));
+			}
+		}
+	#endif
+
+
+
+	#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+		// Copies the source's allocator, for allocators which propagate on assignment. This queue must not hold any memory at this point:
+		void propagate_allocator(const queue &source, std::true_type)
+		{
+			static_cast<element_allocator_type &>(*this) = static_cast<const element_allocator_type &>(source);
+			static_cast<group_allocator_type &>(group_allocator_pair) = static_cast<const group_allocator_type &>(source.group_allocator_pair);
+		}
+
+
+
+		inline void propagate_allocator(const queue &, std::false_type) PLF_QUEUE_NOEXCEPT
+		{}
+	#endif
+
+
+public:
+
+
+	queue(const queue &source):
+		#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+			element_allocator_type(std::allocator_traits<element_allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			element_allocator_type(source),
+		#endif
+		first_group(NULL),
+		current_group(NULL),
+		front_element(NULL),
+		front_end(NULL),
+		back_element(NULL),
+		end_element(NULL),
+		total_number_of_elements(0),
+		min_elements_per_group(source.min_elements_per_group),
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, *this)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	queue(const queue &source, const allocator_type &alloc):
+		element_allocator_type(alloc),
+		first_group(NULL),
+		current_group(NULL),
+		front_element(NULL),
+		front_end(NULL),
+		back_element(NULL),
+		end_element(NULL),
+		total_number_of_elements(0),
+		min_elements_per_group(source.min_elements_per_group),
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, *this)
+	{
+		copy_from_source(source);
+	}
+
+
+
+	#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		// move constructor
+		queue(queue &&source) PLF_QUEUE_NOEXCEPT:
+			element_allocator_type(std::move(static_cast<element_allocator_type &>(source))),
+			first_group(source.first_group),
+			current_group(source.current_group),
+			front_element(source.front_element),
+			front_end(source.front_end),
+			back_element(source.back_element),
+			end_element(source.end_element),
+			total_number_of_elements(source.total_number_of_elements),
+			min_elements_per_group(source.min_elements_per_group),
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, source)
+		{
+			source.reset_members();
+		}
+
+
+		// allocator-extended move constructor - the source's memory can only be taken over if it's allocator is equal to the supplied one, otherwise elements are moved individually:
+		queue(queue &&source, const allocator_type &alloc):
+			element_allocator_type(alloc),
+			first_group(NULL),
+			current_group(NULL),
+			front_element(NULL),
+			front_end(NULL),
+			back_element(NULL),
+			end_element(NULL),
+			total_number_of_elements(0),
+			min_elements_per_group(source.min_elements_per_group),
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, alloc)
+		{
+			if (alloc == static_cast<const element_allocator_type &>(source))
+			{
+				take_memory_from(source);
+			}
+			else
+			{
+				move_elements_from(source);
+			}
+		}
+	#endif
+
+
+
+	~queue()
+	{
+		destroy_all_data();
+	}
+
+
+
+private:
+
+	void deallocate_group(const group_pointer_type the_group) PLF_QUEUE_NOEXCEPT
+	{
+		PLF_QUEUE_DESTROY(group_allocator_type, group_allocator_pair, the_group);
+		PLF_QUEUE_DEALLOCATE(group_allocator_type, group_allocator_pair, the_group, 1);
+	}
+
+
+
+	void destroy_all_data() PLF_QUEUE_NOEXCEPT
+	{
+		#ifdef PLF_QUEUE_TYPE_TRAITS_SUPPORT
+			if (total_number_of_elements != 0 && !(std::is_trivially_destructible<element_type>::value)) // Avoid iteration for trivially-destructible types eg. POD, structs, classes with empty destructor
+		#else // If compiler doesn't support traits, iterate regardless - trivial destructors will not be called, hopefully compiler will optimise this loop out for POD types
+			if (total_number_of_elements != 0)
+		#endif
+		{
+			const const_iterator end_iterator = end();
+
+			for (const_iterator current = begin(); current != end_iterator; ++current)
+			{
+				PLF_QUEUE_DESTROY(element_allocator_type, (*this), current.element_pointer);
+			}
+		}
+
+		while (first_group != NULL)
+		{
+			const group_pointer_type next_group = first_group->next_group;
+			deallocate_group(first_group);
+			first_group = next_group;
+		}
+
+		reset_members();
+	}
+
+
+
+	// Creates the first group, leaving the queue empty - back_element is one-before the group's first element:
+	void initialize()
+	{
+		first_group = current_group = PLF_QUEUE_ALLOCATE(group_allocator_type, group_allocator_pair, 1, 0);
+
+		try
+		{
+			#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+				PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group_allocator_pair, min_elements_per_group);
+			#else
+				PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(group_allocator_pair, min_elements_per_group));
+			#endif
+		}
+		catch (...)
+		{
+			PLF_QUEUE_DEALLOCATE(group_allocator_type, group_allocator_pair, first_group, 1);
+			first_group = current_group = NULL;
+			throw;
+		}
+
+		front_element = first_group->elements;
+		back_element = front_element - 1;
+		front_end = end_element = first_group->end;
+	}
+
+
+
+	// Called by push when back_element has reached the end of current_group, or there are no groups. Moves on to the next group, reusing an unused group if there is one,
+	// and leaves back_element one-before it's first element:
+	void advance_back_group()
+	{
+		if (current_group == NULL)
+		{
+			initialize();
+			return;
+		}
+
+		if (current_group->next_group == NULL)
+		{
+			size_type new_group_size = (total_number_of_elements < min_elements_per_group) ? min_elements_per_group : total_number_of_elements;
+			new_group_size = (new_group_size < group_allocator_pair.max_elements_per_group) ? new_group_size : group_allocator_pair.max_elements_per_group;
+			current_group->next_group = PLF_QUEUE_ALLOCATE(group_allocator_type, group_allocator_pair, 1, current_group);
+
+			try
+			{
+				#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+					PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group_allocator_pair, new_group_size, current_group->elements);
+				#else
+					PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group(group_allocator_pair, new_group_size, current_group->elements));
+				#endif
+			}
+			catch (...)
+			{
+				PLF_QUEUE_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group->next_group, 1);
+				current_group->next_group = NULL;
+				throw;
+			}
+		}
+
+		current_group = current_group->next_group;
+		back_element = current_group->elements - 1;
+		end_element = current_group->end;
+	}
+
+
+
+	// Called by push when constructing an element fails, after back_element has been decremented. If push had moved on to a new group, moves back to the previous one, leaving the new group
+	// unused after it. Groups are singly-linked, so the previous group is found by walking from the front, but this only happens on an exception:
+	void retreat_from_empty_group() PLF_QUEUE_NOEXCEPT
+	{
+		if (back_element + 1 != current_group->elements || current_group == first_group)
+		{
+			return;
+		}
+
+		group_pointer_type previous_group = first_group;
+
+		while (previous_group->next_group != current_group)
+		{
+			previous_group = previous_group->next_group;
+		}
+
+		current_group = previous_group;
+		back_element = end_element = current_group->end;
+	}
+
+
+
+	// Called by pop when the front group has been drained. The group is unlinked from the front, and either moved to just after current_group for reuse, or deallocated if it is smaller than
+	// current_group - this way the small groups created while the queue grew are not cycled through indefinitely once it has reached it's working size:
+	void retire_front_group() PLF_QUEUE_NOEXCEPT
+	{
+		const group_pointer_type drained_group = first_group;
+		first_group = first_group->next_group;
+		front_element = first_group->elements;
+		front_end = first_group->end;
+
+		if ((drained_group->end - drained_group->elements) >= (current_group->end - current_group->elements))
+		{
+			drained_group->next_group = current_group->next_group;
+			current_group->next_group = drained_group;
+		}
+		else
+		{
+			deallocate_group(drained_group);
+		}
+	}
+
+
+public:
+
+	void push(const element_type &the_element)
+	{
+		if (back_element == end_element) // ie. current group is full, or there are no groups (both NULL)
+		{
+			advance_back_group();
+		}
+
+		try
+		{
+			PLF_QUEUE_CONSTRUCT(element_allocator_type, (*this), ++back_element, the_element);
+		}
+		catch (...)
+		{
+			--back_element;
+			retreat_from_empty_group();
+			throw;
+		}
+
+		++total_number_of_elements;
+	}
+
+
+
+	#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		void push(element_type &&the_element)
+		{
+			if (back_element == end_element)
+			{
+				advance_back_group();
+			}
+
+			try
+			{
+				PLF_QUEUE_CONSTRUCT(element_allocator_type, (*this), ++back_element, std::move(the_element));
+			}
+			catch (...)
+			{
+				--back_element;
+				retreat_from_empty_group();
+				throw;
+			}
+
+			++total_number_of_elements;
+		}
+	#endif
+
+
+
+	#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+		template<typename... Arguments>
+		void emplace(Arguments&&... parameters)
+		{
+			if (back_element == end_element)
+			{
+				advance_back_group();
+			}
+
+			try
+			{
+				PLF_QUEUE_CONSTRUCT(element_allocator_type, (*this), ++back_element, std::forward<Arguments>(parameters)...);
+			}
+			catch (...)
+			{
+				--back_element;
+				retreat_from_empty_group();
+				throw;
+			}
+
+			++total_number_of_elements;
+		}
+	#endif
+
+
+
+	void pop() PLF_QUEUE_NOEXCEPT
+	{
+		assert(!empty());
+
+		PLF_QUEUE_DESTROY(element_allocator_type, (*this), front_element);
+
+		if (--total_number_of_elements != 0 && front_element != front_end) // ie. the regular case, where the next element is in the same group
+		{
+			++front_element;
+		}
+		else if (total_number_of_elements != 0)
+		{
+			retire_front_group();
+		}
+		else
+		{
+			// Queue is now empty, so the last element was in current_group - start over from the beginning of it:
+			assert(first_group == current_group);
+			front_element = first_group->elements;
+			back_element = front_element - 1;
+			front_end = first_group->end;
+		}
+	}
+
+
+
+	inline PLF_QUEUE_FORCE_INLINE reference front() const PLF_QUEUE_NOEXCEPT
+	{
+		assert(!empty());
+		return *front_element;
+	}
+
+
+
+	inline PLF_QUEUE_FORCE_INLINE reference back() const PLF_QUEUE_NOEXCEPT
+	{
+		assert(!empty());
+		return *back_element;
+	}
+
+
+
+	// Iteration is from the front of the queue to the back:
+	inline const_iterator begin() const PLF_QUEUE_NOEXCEPT
+	{
+		return (first_group == NULL) ? const_iterator() : const_iterator(first_group, front_element, current_group);
+	}
+
+
+
+	inline const_iterator end() const PLF_QUEUE_NOEXCEPT
+	{
+		return (current_group == NULL) ? const_iterator() : const_iterator(current_group, back_element + 1, current_group);
+	}
+
+
+
+	inline const_iterator cbegin() const PLF_QUEUE_NOEXCEPT
+	{
+		return begin();
+	}
+
+
+
+	inline const_iterator cend() const PLF_QUEUE_NOEXCEPT
+	{
+		return end();
+	}
+
+
+
+	inline queue & operator = (const queue &source)
+	{
+		assert(&source != this);
+
+		clear();
+
+		#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+			propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_copy_assignment());
+		#endif
+
+		min_elements_per_group = source.min_elements_per_group;
+		group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+		copy_from_source(source);
+
+		return *this;
+	}
+
+
+
+	#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+		// Move assignment - if the allocators are unequal and do not propagate, the source's memory cannot be taken over and elements are moved individually:
+		queue & operator = (queue &&source)
+		{
+			assert (&source != this);
+
+			#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+				if (!std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment::value && static_cast<const element_allocator_type &>(*this) != static_cast<const element_allocator_type &>(source))
+				{
+					clear();
+					min_elements_per_group = source.min_elements_per_group;
+					group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+					move_elements_from(source);
+					return *this;
+				}
+			#endif
+
+			destroy_all_data();
+
+			#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+				propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment());
+			#endif
+
+			take_memory_from(source);
+			return *this;
+		}
+	#endif
+
+
+
+	inline PLF_QUEUE_FORCE_INLINE bool empty() const PLF_QUEUE_NOEXCEPT
+	{
+		return total_number_of_elements == 0;
+	}
+
+
+
+	inline PLF_QUEUE_FORCE_INLINE size_type size() const PLF_QUEUE_NOEXCEPT
+	{
+		return total_number_of_elements;
+	}
+
+
+
+	inline size_type max_size() const PLF_QUEUE_NOEXCEPT
+	{
+		#ifdef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+			return std::allocator_traits<element_allocator_type>::max_size(*this);
+		#else
+			return element_allocator_type::max_size();
+		#endif
+	}
+
+
+
+	// Total number of element slots in all groups, including the already-popped slots at the start of the front group:
+	size_type capacity() const PLF_QUEUE_NOEXCEPT
+	{
+		size_type total_size = 0;
+
+		for (group_pointer_type temp_group = first_group; temp_group != NULL; temp_group = temp_group->next_group)
+		{
+			total_size += static_cast<size_type>((temp_group->end + 1) - temp_group->elements);
+		}
+
+		return total_size;
+	}
+
+
+
+	size_type approximate_memory_use() const PLF_QUEUE_NOEXCEPT
+	{
+		size_type memory_use = sizeof(*this);
+
+		for (group_pointer_type temp_group = first_group; temp_group != NULL; temp_group = temp_group->next_group)
+		{
+			memory_use += static_cast<size_type>((((temp_group->end + 1) - temp_group->elements) * sizeof(value_type)) + sizeof(group));
+		}
+
+		return memory_use;
+	}
+
+
+
+	void change_group_sizes(const size_type min_allocation_amount, const size_type max_allocation_amount)
+	{
+		assert(min_allocation_amount > 2);
+		assert(min_allocation_amount <= max_allocation_amount);
+		assert(max_allocation_amount <= std::numeric_limits<size_type>::max() / 2);
+
+		min_elements_per_group = min_allocation_amount;
+		group_allocator_pair.max_elements_per_group = max_allocation_amount;
+		trim_trailing_groups();
+
+		for (group_pointer_type temp_group = first_group; temp_group != NULL; temp_group = temp_group->next_group)
+		{
+			if (static_cast<size_type>((temp_group->end + 1) - temp_group->elements) > max_allocation_amount)
+			{
+				queue temp(*this, get_allocator()); // Allocator-extended copy, so that the temporary's memory is taken over by the move assignment below
+
+				#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+					*this = std::move(temp); // Avoid generating 2nd temporary
+				#else
+					this->swap(temp);
+				#endif
+
+				return;
+			}
+		}
+	}
+
+
+
+	inline void change_minimum_group_size(const size_type min_allocation_amount)
+	{
+		change_group_sizes(min_allocation_amount, group_allocator_pair.max_elements_per_group);
+	}
+
+
+
+	inline void change_maximum_group_size(const size_type max_allocation_amount)
+	{
+		change_group_sizes(min_elements_per_group, max_allocation_amount);
+	}
+
+
+
+	void clear() PLF_QUEUE_NOEXCEPT
+	{
+		destroy_all_data();
+	}
+
+
+
+	bool operator == (const queue &rh) const PLF_QUEUE_NOEXCEPT
+	{
+		assert (this != &rh);
+
+		if (total_number_of_elements != rh.total_number_of_elements)
+		{
+			return false;
+		}
+
+		const const_iterator end_iterator = end();
+
+		for (const_iterator this_current = begin(), rh_current = rh.begin(); this_current != end_iterator; ++this_current, ++rh_current)
+		{
+			if (*this_current != *rh_current)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+
+	inline bool operator != (const queue &rh) const PLF_QUEUE_NOEXCEPT
+	{
+		return !(*this == rh);
+	}
+
+
+
+	// Remove the unused groups after current_group (drained groups kept for reuse, and groups reserved in advance):
+	void trim_trailing_groups() PLF_QUEUE_NOEXCEPT
+	{
+		if (current_group == NULL)
+		{
+			return;
+		}
+
+		group_pointer_type temp_group = current_group->next_group;
+		current_group->next_group = NULL;
+
+		while (temp_group != NULL)
+		{
+			const group_pointer_type next_group = temp_group->next_group;
+			deallocate_group(temp_group);
+			temp_group = next_group;
+		}
+	}
+
+
+
+	void shrink_to_fit()
+	{
+		if (first_group == NULL || total_number_of_elements == capacity())
+		{
+			return;
+		}
+		else if (total_number_of_elements == 0) // Edge case
+		{
+			clear();
+			return;
+		}
+
+		queue temp(*this, get_allocator()); // Allocator-extended copy, which holds the elements in a single group where they fit
+
+		#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+			*this = std::move(temp); // Avoid generating 2nd temporary
+		#else
+			this->swap(temp);
+		#endif
+	}
+
+
+
+	// Unlike stack::reserve, existing elements are never reallocated - as pushes go to the back, the additional capacity is appended as unused groups after current_group:
+	void reserve(size_type reserve_amount)
+	{
+		assert(reserve_amount > 2);
+
+		if (reserve_amount > max_size())
+		{
+			reserve_amount = max_size();
+		}
+
+		if (first_group == NULL) // If this is a newly-created queue, no pushes yet
+		{
+			const size_type original_min_elements = min_elements_per_group;
+			min_elements_per_group = (reserve_amount < group_allocator_pair.max_elements_per_group) ? reserve_amount : group_allocator_pair.max_elements_per_group;
+			initialize();
+			min_elements_per_group = original_min_elements;
+		}
+
+		// Free slots are those after back_element in current_group, plus the unused groups:
+		size_type available = static_cast<size_type>(end_element - back_element);
+		group_pointer_type last_group = current_group;
+
+		while (last_group->next_group != NULL)
+		{
+			last_group = last_group->next_group;
+			available += static_cast<size_type>((last_group->end + 1) - last_group->elements);
+		}
+
+		while (total_number_of_elements + available < reserve_amount)
+		{
+			size_type new_group_size = reserve_amount - (total_number_of_elements + available);
+			new_group_size = (new_group_size < min_elements_per_group) ? min_elements_per_group : new_group_size;
+			new_group_size = (new_group_size < group_allocator_pair.max_elements_per_group) ? new_group_size : group_allocator_pair.max_elements_per_group;
+			last_group->next_group = PLF_QUEUE_ALLOCATE(group_allocator_type, group_allocator_pair, 1, last_group);
+
+			try
+			{
+				#ifdef PLF_QUEUE_VARIADICS_SUPPORT
+					PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, last_group->next_group, group_allocator_pair, new_group_size, last_group->elements);
+				#else
+					PLF_QUEUE_CONSTRUCT(group_allocator_type, group_allocator_pair, last_group->next_group, group(group_allocator_pair, new_group_size, last_group->elements));
+				#endif
+			}
+			catch (...)
+			{
+				PLF_QUEUE_DEALLOCATE(group_allocator_type, group_allocator_pair, last_group->next_group, 1);
+				last_group->next_group = NULL;
+				throw;
+			}
+
+			last_group = last_group->next_group;
+			available += new_group_size;
+		}
+	}
+
+
+
+	void swap(queue &source) PLF_QUEUE_NOEXCEPT_SWAP(allocator_type)
+	{
+		#ifdef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+			queue temp(std::move(source));
+			source = std::move(*this);
+			*this = std::move(temp);
+		#else
+			group_pointer_type		swap_first_group = first_group, swap_current_group = current_group;
+			element_pointer_type	swap_front_element = front_element, swap_front_end = front_end, swap_back_element = back_element, swap_end_element = end_element;
+			size_type				swap_total_number_of_elements = total_number_of_elements, swap_min_elements_per_group = min_elements_per_group, swap_max_elements_per_group = group_allocator_pair.max_elements_per_group;
+
+			first_group = source.first_group;
+			current_group = source.current_group;
+			front_element = source.front_element;
+			front_end = source.front_end;
+			back_element = source.back_element;
+			end_element = source.end_element;
+			total_number_of_elements = source.total_number_of_elements;
+			min_elements_per_group = source.min_elements_per_group;
+			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+
+			source.first_group = swap_first_group;
+			source.current_group = swap_current_group;
+			source.front_element = swap_front_element;
+			source.front_end = swap_front_end;
+			source.back_element = swap_back_element;
+			source.end_element = swap_end_element;
+			source.total_number_of_elements = swap_total_number_of_elements;
+			source.min_elements_per_group = swap_min_elements_per_group;
+			source.group_allocator_pair.max_elements_per_group = swap_max_elements_per_group;
+		#endif
+	}
+
+
+
+	inline allocator_type get_allocator() const PLF_QUEUE_NOEXCEPT
+	{
+		return *this;
+	}
+
+}; // queue
+
+
+
+template <class element_type, class element_allocator_type>
+inline void swap (queue<element_type, element_allocator_type> &a, queue<element_type, element_allocator_type> &b) PLF_QUEUE_NOEXCEPT_SWAP(element_allocator_type)
+{
+	a.swap(b);
+}
+
+
+
+
+} // plf namespace
+
+
+#undef PLF_QUEUE_FORCE_INLINE
+#undef PLF_QUEUE_TYPE_TRAITS_SUPPORT
+#undef PLF_QUEUE_ALLOCATOR_TRAITS_SUPPORT
+#undef PLF_QUEUE_VARIADICS_SUPPORT
+#undef PLF_QUEUE_MOVE_SEMANTICS_SUPPORT
+#undef PLF_QUEUE_NOEXCEPT
+#undef PLF_QUEUE_NOEXCEPT_SWAP
+
+#undef PLF_QUEUE_CONSTRUCT
+#undef PLF_QUEUE_DESTROY
+#undef PLF_QUEUE_ALLOCATE
+#undef PLF_QUEUE_ALLOCATE_INITIALIZATION
+#undef PLF_QUEUE_DEALLOCATE
+
+
+#endif // PLF_QUEUE_H
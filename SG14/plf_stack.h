@@ -105,7 +105,9 @@
 
 
 
+#include <cstring>	// memcpy
 #include <cassert>	// assert
+#include <iterator> // std::iterator_traits, std::distance
 #include <limits>  // std::numeric_limits
 #include <memory>	// std::uninitialized_copy, std::allocator
 
@@ -113,8 +115,8 @@
 	#include <utility> // std::move
 #endif
 
-#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
-	#include <type_traits> // std::is_trivially_destructible
+#if defined(PLF_STACK_TYPE_TRAITS_SUPPORT) || defined(PLF_STACK_ALLOCATOR_TRAITS_SUPPORT)
+	#include <type_traits> // std::is_trivially_destructible, std::true_type
 #endif
 
 
@@ -137,14 +139,25 @@ public:
 		typedef const element_type &													const_reference;
 		typedef typename std::allocator_traits<element_allocator_type>::pointer 		pointer;
 		typedef typename std::allocator_traits<element_allocator_type>::const_pointer	const_pointer;
+		typedef typename std::allocator_traits<element_allocator_type>::difference_type	difference_type;
 	#else
 		typedef typename element_allocator_type::size_type			size_type;
+		typedef typename element_allocator_type::difference_type	difference_type;
 		typedef typename element_allocator_type::reference			reference;
 		typedef typename element_allocator_type::const_reference	const_reference;
 		typedef typename element_allocator_type::pointer			pointer;
 		typedef typename element_allocator_type::const_pointer		const_pointer;
 	#endif
 
+	// When unused trailing groups (left behind as the stack shrinks) are deallocated - see set_trim_policy():
+	enum trim_policy
+	{
+		trim_never,				// Only by trim_trailing_groups() or shrink_to_fit() - the default
+		trim_immediately,		// As soon as a pop leaves a group
+		trim_after_idle_pops,	// Once threshold pops have occurred since a pop last left a group
+		trim_above_bytes		// As soon as a pop leaves a group, keeping only those nearest trailing groups whose combined memory use is within threshold bytes
+	};
+
 private:
 	struct group; // Forward declaration for typedefs below
 
@@ -166,7 +179,8 @@ private:
 
 
 		#ifdef PLF_STACK_VARIADICS_SUPPORT
-			group(const size_type elements_per_group, group_pointer_type const previous = NULL):
+			group(const group_allocator_type &alloc, const size_type elements_per_group, group_pointer_type const previous = NULL):
+				element_allocator_type(alloc),
 				elements(PLF_STACK_ALLOCATE_INITIALIZATION(element_allocator_type, elements_per_group, (previous == NULL) ? 0 : previous->elements)),
 				next_group(NULL),
 				previous_group(previous),
@@ -175,7 +189,8 @@ private:
 
 		#else
 			// This is a hack around the fact that element_allocator_type::construct only supports copy construction in C++03 and copy elision does not occur on the vast majority of compilers in this circumstance. And to avoid running out of memory (and performance loss) from allocating the same block twice, we're allocating in this constructor and moving data in the copy constructor.
-			group(const size_type elements_per_group, group_pointer_type const previous = NULL):
+			group(const group_allocator_type &alloc, const size_type elements_per_group, group_pointer_type const previous = NULL):
+				element_allocator_type(alloc),
 				elements(NULL),
 				next_group(reinterpret_cast<group_pointer_type>(elements_per_group)),
 				previous_group(previous),
@@ -208,12 +223,166 @@ private:
 	struct ebco_pair : group_allocator_type // Packaging the group allocator with least-used member variable, for empty-base-class optimisation
 	{
 		size_type max_elements_per_group;
-		ebco_pair(const size_type max_elements) : max_elements_per_group(max_elements) {};
+		ebco_pair(const size_type max_elements, const element_allocator_type &alloc) : group_allocator_type(alloc), max_elements_per_group(max_elements) {};
 	}						group_allocator_pair;
+	struct trim_settings
+	{
+		trim_policy policy;
+		size_type threshold;
+		trim_settings() : policy(trim_never), threshold(0) {};
+	}						trim_setting;
+	size_type				idle_pops_remaining; // Counts down to trimming under trim_after_idle_pops, zero when no count is in progress
 
 
 public:
 
+	// Position returned by mark() and consumed by rewind(). A default-constructed marker is equivalent to the mark of an empty stack:
+	class marker
+	{
+	private:
+		group_pointer_type		group_pointer;
+		element_pointer_type	top_pointer;
+		size_type				number_of_elements;
+
+		friend class stack;
+
+		marker(const group_pointer_type group, const element_pointer_type top, const size_type size) PLF_STACK_NOEXCEPT:
+			group_pointer(group),
+			top_pointer(top),
+			number_of_elements(size)
+		{}
+
+	public:
+		marker() PLF_STACK_NOEXCEPT:
+			group_pointer(NULL),
+			top_pointer(NULL),
+			number_of_elements(0)
+		{}
+
+		inline size_type size() const PLF_STACK_NOEXCEPT
+		{
+			return number_of_elements;
+		}
+	};
+
+
+
+	// Read-only bidirectional iterator, traversing from the bottom of the stack to the top. Invalidated by any push, pop or other modification of the stack:
+	class const_iterator
+	{
+	private:
+		group_pointer_type		group_pointer;
+		element_pointer_type	element_pointer;
+		group_pointer_type		last_group; // The stack's current group - trailing groups past it are unused, so incrementing past it's end goes to end() rather than into the next group
+
+		friend class stack;
+
+		const_iterator(const group_pointer_type group, const element_pointer_type element, const group_pointer_type last) PLF_STACK_NOEXCEPT:
+			group_pointer(group),
+			element_pointer(element),
+			last_group(last)
+		{}
+
+	public:
+		typedef std::bidirectional_iterator_tag 	iterator_category;
+		typedef typename stack::value_type 			value_type;
+		typedef typename stack::difference_type 	difference_type;
+		typedef typename stack::const_pointer		pointer;
+		typedef typename stack::const_reference		reference;
+
+
+		const_iterator() PLF_STACK_NOEXCEPT:
+			group_pointer(NULL),
+			element_pointer(NULL),
+			last_group(NULL)
+		{}
+
+
+
+		// The group is compared as well as the element, as end() is one-past the current group's elements - which can be the address of another group's first element:
+		inline bool operator == (const const_iterator &rh) const PLF_STACK_NOEXCEPT
+		{
+			return element_pointer == rh.element_pointer && group_pointer == rh.group_pointer;
+		}
+
+
+
+		inline bool operator != (const const_iterator &rh) const PLF_STACK_NOEXCEPT
+		{
+			return !(*this == rh);
+		}
+
+
+
+		inline PLF_STACK_FORCE_INLINE reference operator * () const PLF_STACK_NOEXCEPT
+		{
+			return *element_pointer;
+		}
+
+
+
+		inline PLF_STACK_FORCE_INLINE pointer operator -> () const PLF_STACK_NOEXCEPT
+		{
+			return element_pointer;
+		}
+
+
+
+		inline PLF_STACK_FORCE_INLINE const_iterator & operator ++ () PLF_STACK_NOEXCEPT
+		{
+			if (element_pointer == group_pointer->end && group_pointer != last_group)
+			{
+				group_pointer = group_pointer->next_group;
+				element_pointer = group_pointer->elements;
+			}
+			else
+			{
+				++element_pointer;
+			}
+
+			return *this;
+		}
+
+
+
+		inline const_iterator operator ++ (int) PLF_STACK_NOEXCEPT
+		{
+			const const_iterator copy(*this);
+			++*this;
+			return copy;
+		}
+
+
+
+		inline PLF_STACK_FORCE_INLINE const_iterator & operator -- () PLF_STACK_NOEXCEPT
+		{
+			if (element_pointer == group_pointer->elements)
+			{
+				group_pointer = group_pointer->previous_group;
+				element_pointer = group_pointer->end;
+			}
+			else
+			{
+				--element_pointer;
+			}
+
+			return *this;
+		}
+
+
+
+		inline const_iterator operator -- (int) PLF_STACK_NOEXCEPT
+		{
+			const const_iterator copy(*this);
+			--*this;
+			return copy;
+		}
+	};
+
+	typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+
+
 	explicit stack(const element_allocator_type &alloc = element_allocator_type()):
 		element_allocator_type(alloc),
 		current_group(NULL),
@@ -223,7 +392,8 @@ public:
 		end_element(NULL),
 		total_number_of_elements(0),
 		min_elements_per_group((sizeof(element_type) * 8 > (sizeof(*this) + sizeof(group)) * 2) ? 8 : (((sizeof(*this) + sizeof(group)) * 2) / sizeof(element_type)) + 1),
-		group_allocator_pair(std::numeric_limits<size_type>::max() / 2)
+		group_allocator_pair(std::numeric_limits<size_type>::max() / 2, alloc),
+		idle_pops_remaining(0)
 	{
 		assert(min_elements_per_group > 2);
 		assert(min_elements_per_group <= group_allocator_pair.max_elements_per_group);
@@ -240,7 +410,8 @@ public:
 		end_element(NULL),
 		total_number_of_elements(0),
 		min_elements_per_group(min_allocation_amount),
-		group_allocator_pair(max_allocation_amount)
+		group_allocator_pair(max_allocation_amount, alloc),
+		idle_pops_remaining(0)
 	{
 		assert(min_elements_per_group > 2);
 		assert(min_elements_per_group <= group_allocator_pair.max_elements_per_group);
@@ -307,11 +478,79 @@ private:
 	}	
 
 
+
+	#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
+		// Takes over the source's groups. This stack must not hold any memory, and it's allocator must be equal to the source's:
+		void take_memory_from(stack &source) PLF_STACK_NOEXCEPT
+		{
+			current_group = std::move(source.current_group);
+			first_group = std::move(source.first_group);
+			top_element = std::move(source.top_element);
+			start_element = std::move(source.start_element);
+			end_element = std::move(source.end_element);
+			total_number_of_elements = source.total_number_of_elements;
+			min_elements_per_group = source.min_elements_per_group;
+			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+			trim_setting = source.trim_setting;
+			idle_pops_remaining = source.idle_pops_remaining;
+
+			// Nullify source object's contents - only first_group and total_number_of_elements required to be altered for destructor to work on it:
+			source.first_group = NULL;
+			source.total_number_of_elements = 0;
+		}
+
+
+
+		// Used when the source's memory belongs to an unequal allocator. Elements are moved in bottom-to-top order so that the stack order is preserved:
+		void move_elements_from(stack &source)
+		{
+			if (source.total_number_of_elements == 0)
+			{
+				return;
+			}
+
+			for (group_pointer_type current_move_group = source.first_group; current_move_group != source.current_group; current_move_group = current_move_group->next_group)
+			{
+				for (element_pointer_type element_to_move = current_move_group->elements; element_to_move != current_move_group->end + 1; ++element_to_move)
+				{
+					push(std::move(*element_to_move));
+				}
+			}
+
+			for (element_pointer_type element_to_move = source.start_element; element_to_move != source.top_element + 1; ++element_to_move)
+			{
+				push(std::move(*element_to_move));
+			}
+		}
+	#endif
+
+
+
+	#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+		// Copies the source's allocator, for allocators which propagate on assignment. This stack must not hold any memory at this point.
+		// Overloaded on the propagation trait so that allocators which are not assignable (eg. std::pmr::polymorphic_allocator) never instantiate the assignment:
+		void propagate_allocator(const stack &source, std::true_type)
+		{
+			static_cast<element_allocator_type &>(*this) = static_cast<const element_allocator_type &>(source);
+			static_cast<group_allocator_type &>(group_allocator_pair) = static_cast<const group_allocator_type &>(source.group_allocator_pair);
+		}
+
+
+
+		inline void propagate_allocator(const stack &, std::false_type) PLF_STACK_NOEXCEPT
+		{}
+	#endif
+
+
 public:
 
 
 	stack(const stack &source):
-		element_allocator_type(source),
+		#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+			element_allocator_type(std::allocator_traits<element_allocator_type>::select_on_container_copy_construction(source)),
+		#else
+			element_allocator_type(source),
+		#endif
 		current_group(NULL),
 		first_group(NULL),
 		top_element(NULL),
@@ -319,7 +558,9 @@ public:
 		end_element(NULL),
 		total_number_of_elements(source.total_number_of_elements),
 		min_elements_per_group(source.min_elements_per_group),
-		group_allocator_pair(source.group_allocator_pair.max_elements_per_group)
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, *this),
+		trim_setting(source.trim_setting),
+		idle_pops_remaining(0)
 	{
 		copy_from_source(source);
 	}
@@ -335,7 +576,9 @@ public:
 		end_element(NULL),
 		total_number_of_elements(source.total_number_of_elements),
 		min_elements_per_group(source.min_elements_per_group),
-		group_allocator_pair(source.group_allocator_pair.max_elements_per_group)
+		group_allocator_pair(source.group_allocator_pair.max_elements_per_group, *this),
+		trim_setting(source.trim_setting),
+		idle_pops_remaining(0)
 	{
 		copy_from_source(source);
 	}
@@ -345,7 +588,7 @@ public:
 	#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
 		// move constructor
 		stack(stack &&source) PLF_STACK_NOEXCEPT:
-			element_allocator_type(source),
+			element_allocator_type(std::move(static_cast<element_allocator_type &>(source))),
 			current_group(std::move(source.current_group)),
 			first_group(std::move(source.first_group)),
 			top_element(std::move(source.top_element)),
@@ -353,7 +596,9 @@ public:
 			end_element(std::move(source.end_element)),
 			total_number_of_elements(source.total_number_of_elements),
 			min_elements_per_group(source.min_elements_per_group),
-			group_allocator_pair(source.group_allocator_pair.max_elements_per_group)
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, source),
+			trim_setting(source.trim_setting),
+			idle_pops_remaining(source.idle_pops_remaining)
 		{
 			// Nullify source object's contents - only first_group and total_number_of_elements required for destructor:
 			source.first_group = NULL;
@@ -361,21 +606,28 @@ public:
 		}
 
 
-		// allocator-extended move constructor
+		// allocator-extended move constructor - the source's memory can only be taken over if it's allocator is equal to the supplied one, otherwise elements are moved individually:
 		stack(stack &&source, const allocator_type &alloc):
 			element_allocator_type(alloc),
-			current_group(std::move(source.current_group)),
-			first_group(std::move(source.first_group)),
-			top_element(std::move(source.top_element)),
-			start_element(std::move(source.start_element)),
-			end_element(std::move(source.end_element)),
-			total_number_of_elements(source.total_number_of_elements),
+			current_group(NULL),
+			first_group(NULL),
+			top_element(NULL),
+			start_element(NULL),
+			end_element(NULL),
+			total_number_of_elements(0),
 			min_elements_per_group(source.min_elements_per_group),
-			group_allocator_pair(source.group_allocator_pair.max_elements_per_group)
+			group_allocator_pair(source.group_allocator_pair.max_elements_per_group, alloc),
+			trim_setting(source.trim_setting),
+			idle_pops_remaining(0)
 		{
-			// Nullify source object's contents - only first_group and total_number_of_elements required for destructor:
-			source.first_group = NULL;
-			source.total_number_of_elements = 0;
+			if (alloc == static_cast<const element_allocator_type &>(source))
+			{
+				take_memory_from(source);
+			}
+			else
+			{
+				move_elements_from(source);
+			}
 		}
 	#endif
 	
@@ -390,80 +642,421 @@ public:
 
 private:
 
-	void destroy_all_data()
-	{
-		#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
-			if (total_number_of_elements != 0 && !(std::is_trivially_destructible<element_type>::value)) // Avoid iteration for trivially-destructible types eg. POD, structs, classes with ermpty destructor
-		#else // If compiler doesn't support traits, iterate regardless - trivial destructors will not be called, hopefully compiler will optimise this loop out for POD types
-			if (total_number_of_elements != 0)
-		#endif
+	void destroy_all_data()
+	{
+		#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
+			if (total_number_of_elements != 0 && !(std::is_trivially_destructible<element_type>::value)) // Avoid iteration for trivially-destructible types eg. POD, structs, classes with ermpty destructor
+		#else // If compiler doesn't support traits, iterate regardless - trivial destructors will not be called, hopefully compiler will optimise this loop out for POD types
+			if (total_number_of_elements != 0)
+		#endif
+		{
+			group_pointer_type previous_group;
+			element_pointer_type past_end;
+
+			while (first_group != current_group)
+			{
+				past_end = first_group->end + 1;
+
+				for (element_pointer_type element_pointer = first_group->elements; element_pointer != past_end; ++element_pointer)
+				{
+					PLF_STACK_DESTROY(element_allocator_type, (*this), element_pointer);
+				}
+
+				previous_group = first_group;
+				first_group = first_group->next_group;
+
+				PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, previous_group);
+				PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group, 1);
+			}
+
+			// Special case for current group:
+			past_end = top_element + 1;
+
+			for (element_pointer_type element_pointer = start_element; element_pointer != past_end; ++element_pointer)
+			{
+				PLF_STACK_DESTROY(element_allocator_type, (*this), element_pointer);
+			}
+
+			first_group = first_group->next_group;
+			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, current_group);
+			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group, 1);
+		}
+
+		total_number_of_elements = 0;
+
+		while (first_group != NULL)
+		{
+			current_group = first_group;
+			first_group = first_group->next_group;
+			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, current_group);
+			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group, 1);
+		}
+	}
+
+
+	void initialize()
+	{
+		first_group = current_group = PLF_STACK_ALLOCATE(group_allocator_type, group_allocator_pair, 1, 0);
+
+		// Initialize:
+		try
+		{
+			#ifdef PLF_STACK_VARIADICS_SUPPORT
+				PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group_allocator_pair, min_elements_per_group);
+			#else
+				PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(group_allocator_pair, min_elements_per_group));
+			#endif
+		}
+		catch (...)
+		{
+			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, first_group, 1);
+			first_group = current_group = NULL;
+			throw;
+		}
+
+		top_element = start_element = first_group->elements;
+		end_element = first_group->end;
+	}
+
+
+	// Used by range-push to prevent calls with two integers mistakenly resolving to it:
+	template <bool condition, class T = void>
+	struct plf_enable_if_c
+	{
+		typedef T type;
+	};
+
+	template <class T>
+	struct plf_enable_if_c<false, T>
+	{};
+
+
+
+	// Moves on to the next group, creating it if there are no trailing groups. New groups are sized as per push, or larger to fit the remaining elements of a bulk push.
+	// top_element is left one-before the group's first element - the caller must either construct into the group or call retreat_from_empty_group():
+	void advance_group(const size_type remaining)
+	{
+		if (current_group->next_group == NULL)
+		{
+			size_type new_group_size = (total_number_of_elements < remaining) ? remaining : total_number_of_elements;
+			new_group_size = (new_group_size < group_allocator_pair.max_elements_per_group) ? new_group_size : group_allocator_pair.max_elements_per_group;
+			current_group->next_group = PLF_STACK_ALLOCATE(group_allocator_type, group_allocator_pair, 1, current_group);
+
+			try
+			{
+				#ifdef PLF_STACK_VARIADICS_SUPPORT
+					PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group_allocator_pair, new_group_size, current_group);
+				#else
+					PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group(group_allocator_pair, new_group_size, current_group));
+				#endif
+			}
+			catch (...)
+			{
+				PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group->next_group, 1);
+				current_group->next_group = NULL;
+				throw;
+			}
+		}
+
+		current_group = current_group->next_group;
+		start_element = current_group->elements;
+		top_element = start_element - 1;
+		end_element = current_group->end;
+	}
+
+
+
+	inline void retreat_from_empty_group() PLF_STACK_NOEXCEPT
+	{
+		if (top_element < start_element && total_number_of_elements != 0) // ie. advance_group() was called but nothing was constructed in the new group
+		{
+			current_group = current_group->previous_group;
+			start_element = current_group->elements;
+			end_element = top_element = current_group->end;
+		}
+	}
+
+
+
+	// Applies the trim policy when a pop has moved current_group back to the previous group:
+	void left_group() PLF_STACK_NOEXCEPT
+	{
+		switch (trim_setting.policy)
+		{
+			case trim_never:
+				return;
+			case trim_immediately:
+				trim_trailing_groups();
+				return;
+			case trim_after_idle_pops:
+				if ((idle_pops_remaining = trim_setting.threshold) == 0)
+				{
+					trim_trailing_groups();
+				}
+
+				return;
+			case trim_above_bytes:
+				trim_trailing_groups_above(trim_setting.threshold);
+				return;
+		}
+	}
+
+
+
+	// Deallocates the trailing groups after last_retained_group:
+	void deallocate_trailing_groups(const group_pointer_type last_retained_group) PLF_STACK_NOEXCEPT
+	{
+		group_pointer_type temp_group = last_retained_group->next_group, temp_group2;
+		last_retained_group->next_group = NULL; // Set to NULL regardless of whether it is already NULL (avoids branching). Cuts off rest of groups from this group.
+
+		while (temp_group != NULL)
+		{
+			temp_group2 = temp_group;
+			temp_group = temp_group->next_group;
+			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, temp_group2);
+			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, temp_group2, 1);
+		}
+	}
+
+
+
+	// Retains the nearest trailing groups whose combined memory use is within retained_bytes, and deallocates the rest:
+	void trim_trailing_groups_above(const size_type retained_bytes) PLF_STACK_NOEXCEPT
+	{
+		size_type trailing_bytes = 0;
+		group_pointer_type last_retained_group = current_group;
+
+		while (last_retained_group->next_group != NULL)
+		{
+			const group_pointer_type next_group = last_retained_group->next_group;
+			trailing_bytes += static_cast<size_type>((((next_group->end + 1) - next_group->elements) * sizeof(value_type)) + sizeof(group));
+
+			if (trailing_bytes > retained_bytes)
+			{
+				break;
+			}
+
+			last_retained_group = next_group;
+		}
+
+		deallocate_trailing_groups(last_retained_group);
+	}
+
+
+
+	// Destroys the top 'number_to_pop' elements, retreating to earlier groups as necessary. Trailing groups are retained, as per pop:
+	void pop_elements(size_type number_to_pop) PLF_STACK_NOEXCEPT
+	{
+		while (true)
+		{
+			const size_type number_in_group = static_cast<size_type>((top_element - start_element) + 1);
+			const bool last_group = (number_to_pop < number_in_group || current_group == first_group); // Emptying the first group leaves top_element at start_element - 1, as pop does
+			const element_pointer_type new_top = (last_group) ? top_element - number_to_pop : start_element - 1;
+
+			#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
+				if (!(std::is_trivially_destructible<element_type>::value))
+			#endif
+			{
+				for (element_pointer_type element_pointer = top_element; element_pointer != new_top; --element_pointer)
+				{
+					PLF_STACK_DESTROY(element_allocator_type, (*this), element_pointer);
+				}
+			}
+
+			if (last_group)
+			{
+				top_element = new_top;
+				total_number_of_elements -= number_to_pop;
+
+				if (idle_pops_remaining != 0) // trim_after_idle_pops only
+				{
+					if (idle_pops_remaining <= number_to_pop)
+					{
+						trim_trailing_groups();
+					}
+					else
+					{
+						idle_pops_remaining -= number_to_pop;
+					}
+				}
+
+				return;
+			}
+
+			number_to_pop -= number_in_group;
+			total_number_of_elements -= number_in_group;
+			current_group = current_group->previous_group;
+			start_element = current_group->elements;
+			end_element = top_element = current_group->end;
+			left_group();
+		}
+	}
+
+
+
+	// Bulk construction and output of a contiguous run of elements within a group. Overloaded so that pointers to element_type can use memcpy for trivially-copyable types.
+	// construct_elements either constructs all elements or none, and returns the advanced source iterator:
+	template <class iterator_type>
+	iterator_type construct_elements(const element_pointer_type destination, iterator_type source, const size_type number_to_construct)
+	{
+		const element_pointer_type past_end = destination + number_to_construct;
+		element_pointer_type current_location = destination;
+
+		try
+		{
+			while (current_location != past_end)
+			{
+				PLF_STACK_CONSTRUCT(element_allocator_type, (*this), current_location, *source);
+				++current_location;
+				++source;
+			}
+		}
+		catch (...)
+		{
+			while (current_location != destination)
+			{
+				PLF_STACK_DESTROY(element_allocator_type, (*this), --current_location);
+			}
+
+			throw;
+		}
+
+		return source;
+	}
+
+
+
+	template <class output_iterator_type>
+	output_iterator_type output_elements(element_pointer_type source, const element_pointer_type past_end, output_iterator_type destination)
+	{
+		for (; source != past_end; ++source, ++destination)
+		{
+			#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
+				*destination = std::move(*source);
+			#else
+				*destination = *source;
+			#endif
+		}
+
+		return destination;
+	}
+
+
+
+	#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
+		inline const element_type * construct_elements(const element_pointer_type destination, const element_type *source, const size_type number_to_construct)
+		{
+			if (std::is_trivially_copyable<element_type>::value) // This if-statement should be removed by the compiler on resolution of element_type
+			{
+				std::memcpy(static_cast<void *>(&*destination), static_cast<const void *>(source), number_to_construct * sizeof(element_type)); // void * casts avoid -Wclass-memaccess when instantiated for non-trivial types, where this code is unreachable
+				return source + number_to_construct;
+			}
+
+			return construct_elements<const element_type *>(destination, source, number_to_construct);
+		}
+
+
+
+		inline element_type * construct_elements(const element_pointer_type destination, element_type *source, const size_type number_to_construct)
+		{
+			if (std::is_trivially_copyable<element_type>::value)
+			{
+				std::memcpy(static_cast<void *>(&*destination), static_cast<const void *>(source), number_to_construct * sizeof(element_type));
+				return source + number_to_construct;
+			}
+
+			return construct_elements<element_type *>(destination, source, number_to_construct);
+		}
+
+
+
+		inline element_type * output_elements(const element_pointer_type source, const element_pointer_type past_end, element_type *destination)
+		{
+			if (std::is_trivially_copyable<element_type>::value)
+			{
+				std::memcpy(static_cast<void *>(destination), static_cast<const void *>(&*source), static_cast<size_type>(past_end - source) * sizeof(element_type));
+				return destination + (past_end - source);
+			}
+
+			return output_elements<element_type *>(source, past_end, destination);
+		}
+	#endif
+
+
+
+	// Range-push for forward iterators, where the number of elements is known in advance and groups can be filled a chunk at a time:
+	template <class iterator_type>
+	void push_range(iterator_type first, const iterator_type last, std::forward_iterator_tag)
+	{
+		size_type remaining = static_cast<size_type>(std::distance(first, last));
+
+		if (remaining == 0)
+		{
+			return;
+		}
+
+		if (top_element == NULL)
 		{
-			group_pointer_type previous_group;
-			element_pointer_type past_end;
+			initialize();
+			--top_element; // ie. the same state as a stack which has had all elements popped
+		}
 
-			while (first_group != current_group)
-			{
-				past_end = first_group->end + 1;
+		const size_type original_number_of_elements = total_number_of_elements;
 
-				for (element_pointer_type element_pointer = first_group->elements; element_pointer != past_end; ++element_pointer)
+		try
+		{
+			while (true)
+			{
+				if (top_element == end_element)
 				{
-					PLF_STACK_DESTROY(element_allocator_type, (*this), element_pointer);
+					advance_group(remaining);
 				}
 
-				previous_group = first_group;
-				first_group = first_group->next_group;
-
-				PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, previous_group);
-				PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, previous_group, 1);
-			}
+				const size_type space = static_cast<size_type>(end_element - top_element);
+				const size_type number_to_construct = (remaining < space) ? remaining : space;
 
-			// Special case for current group:
-			past_end = top_element + 1;
+				first = construct_elements(top_element + 1, first, number_to_construct);
+				top_element += number_to_construct;
+				total_number_of_elements += number_to_construct;
 
-			for (element_pointer_type element_pointer = start_element; element_pointer != past_end; ++element_pointer)
-			{
-				PLF_STACK_DESTROY(element_allocator_type, (*this), element_pointer);
+				if ((remaining -= number_to_construct) == 0)
+				{
+					return;
+				}
 			}
-
-			first_group = first_group->next_group;
-			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, current_group);
-			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group, 1);
 		}
-
-		total_number_of_elements = 0;
-
-		while (first_group != NULL)
+		catch (...)
 		{
-			current_group = first_group;
-			first_group = first_group->next_group;
-			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, current_group);
-			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, current_group, 1);
+			retreat_from_empty_group();
+			pop_elements(total_number_of_elements - original_number_of_elements);
+			throw;
 		}
 	}
 
 
-	void initialize()
+
+	// Single-pass input iterators cannot be measured beforehand, so are pushed one at a time:
+	template <class iterator_type>
+	void push_range(iterator_type first, const iterator_type last, std::input_iterator_tag)
 	{
-		first_group = current_group = PLF_STACK_ALLOCATE(group_allocator_type, group_allocator_pair, 1, 0);
+		const size_type original_number_of_elements = total_number_of_elements;
 
-		// Initialize:
 		try
 		{
-			#ifdef PLF_STACK_VARIADICS_SUPPORT
-				PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, min_elements_per_group);
-			#else
-				PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, first_group, group(min_elements_per_group));
-			#endif
+			for (; first != last; ++first)
+			{
+				push(*first);
+			}
 		}
 		catch (...)
 		{
-			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, first_group, 1);
-			first_group = current_group = NULL;
+			if (total_number_of_elements != original_number_of_elements)
+			{
+				pop_elements(total_number_of_elements - original_number_of_elements);
+			}
+
 			throw;
 		}
-
-		top_element = start_element = first_group->elements;
-		end_element = first_group->end;
 	}
 
 
@@ -497,9 +1090,9 @@ public:
 					try
 					{
 						#ifdef PLF_STACK_VARIADICS_SUPPORT
-							PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
+							PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
 						#else
-							PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group((total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
+							PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group(group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
 						#endif
 					}
 					catch (...)
@@ -581,9 +1174,9 @@ public:
 						try
 						{ 
 							#ifdef PLF_STACK_VARIADICS_SUPPORT
-								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
+								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
 							#else
-								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group((total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
+								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group(group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
 							#endif
 						} 
 						catch (...) 
@@ -666,9 +1259,9 @@ public:
 						try
 						{ 
 							#ifdef PLF_STACK_VARIADICS_SUPPORT
-								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
+								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group);
 							#else
-								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group((total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
+								PLF_STACK_CONSTRUCT(group_allocator_type, group_allocator_pair, current_group->next_group, group(group_allocator_pair, (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? total_number_of_elements : group_allocator_pair.max_elements_per_group, current_group));
 							#endif
 						} 
 						catch (...) 
@@ -721,6 +1314,156 @@ public:
 
 
 
+	// Range push - elements are pushed in iteration order, so *(last - 1) becomes the top element. Groups are filled a chunk at a time for forward iterators, using memcpy when pushing from a pointer range of a trivially-copyable type.
+	// If an exception is thrown the elements pushed so far by this call are popped again:
+	template <class iterator_type>
+	inline void push(const typename plf_enable_if_c<!std::numeric_limits<iterator_type>::is_integer, iterator_type>::type first, const iterator_type last)
+	{
+		push_range(first, last, typename std::iterator_traits<iterator_type>::iterator_category());
+	}
+
+
+
+	// Fill push - pushes number_to_push copies of the_element, a group-chunk at a time:
+	void push_n(size_type number_to_push, const element_type &the_element)
+	{
+		if (number_to_push == 0)
+		{
+			return;
+		}
+
+		if (top_element == NULL)
+		{
+			initialize();
+			--top_element;
+		}
+
+		const size_type original_number_of_elements = total_number_of_elements;
+
+		try
+		{
+			while (true)
+			{
+				if (top_element == end_element)
+				{
+					advance_group(number_to_push);
+				}
+
+				const size_type space = static_cast<size_type>(end_element - top_element);
+				const size_type number_to_construct = (number_to_push < space) ? number_to_push : space;
+				const element_pointer_type past_end = top_element + number_to_construct + 1;
+
+				#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
+					if (std::is_trivially_copyable<element_type>::value) // This if-statement should be removed by the compiler on resolution of element_type
+					{
+						std::uninitialized_fill(&*(top_element + 1), &*past_end, the_element);
+						top_element += number_to_construct;
+						total_number_of_elements += number_to_construct;
+					}
+					else
+				#endif
+				{
+					while (top_element + 1 != past_end) // total_number_of_elements is kept current so that the elements constructed so far are popped if an exception is thrown
+					{
+						PLF_STACK_CONSTRUCT(element_allocator_type, (*this), top_element + 1, the_element);
+						++top_element;
+						++total_number_of_elements;
+					}
+				}
+
+				if ((number_to_push -= number_to_construct) == 0)
+				{
+					return;
+				}
+			}
+		}
+		catch (...)
+		{
+			retreat_from_empty_group();
+			pop_elements(total_number_of_elements - original_number_of_elements);
+			throw;
+		}
+	}
+
+
+
+	// Iteration is from the bottom of the stack to the top, reverse iteration from the top down:
+	inline const_iterator begin() const PLF_STACK_NOEXCEPT
+	{
+		return (total_number_of_elements == 0) ? end() : const_iterator(first_group, first_group->elements, current_group);
+	}
+
+
+
+	inline const_iterator end() const PLF_STACK_NOEXCEPT
+	{
+		return (top_element == NULL) ? const_iterator() : const_iterator(current_group, top_element + 1, current_group);
+	}
+
+
+
+	inline const_iterator cbegin() const PLF_STACK_NOEXCEPT
+	{
+		return begin();
+	}
+
+
+
+	inline const_iterator cend() const PLF_STACK_NOEXCEPT
+	{
+		return end();
+	}
+
+
+
+	inline const_reverse_iterator rbegin() const PLF_STACK_NOEXCEPT
+	{
+		return const_reverse_iterator(end());
+	}
+
+
+
+	inline const_reverse_iterator rend() const PLF_STACK_NOEXCEPT
+	{
+		return const_reverse_iterator(begin());
+	}
+
+
+
+	inline const_reverse_iterator crbegin() const PLF_STACK_NOEXCEPT
+	{
+		return rbegin();
+	}
+
+
+
+	inline const_reverse_iterator crend() const PLF_STACK_NOEXCEPT
+	{
+		return rend();
+	}
+
+
+
+	// Calls function(first, last) for the contiguous range of elements [first, last) held in each group, from the bottom of the stack to the top. Allows inspection or serialization without copying:
+	template <class function_type>
+	function_type for_each_block(function_type function) const
+	{
+		if (total_number_of_elements == 0)
+		{
+			return function;
+		}
+
+		for (group_pointer_type current = first_group; current != current_group; current = current->next_group)
+		{
+			function(static_cast<const element_type *>(&*(current->elements)), static_cast<const element_type *>(&*(current->end)) + 1);
+		}
+
+		function(static_cast<const element_type *>(&*start_element), static_cast<const element_type *>(&*top_element) + 1);
+		return function;
+	}
+
+
+
 	inline PLF_STACK_FORCE_INLINE reference top() const PLF_STACK_NOEXCEPT
 	{
 		assert(!empty());
@@ -744,12 +1487,105 @@ public:
 		if (total_number_of_elements-- == 1 || top_element != start_element) // If total_number_of_elements is now 0 after decrement, this essentially moves top_element back to it's initial position (start_element - 1). But otherwise, this is just a regular pop
 		{
 			--top_element;
+
+			if (idle_pops_remaining != 0 && --idle_pops_remaining == 0) // trim_after_idle_pops only
+			{
+				trim_trailing_groups();
+			}
 		}
 		else
 		{ // ie. is start element, but not first group in stack (if it were, total_number_of_elements would be 0 after decrement)
 			current_group = current_group->previous_group;
 			start_element = current_group->elements;
 			end_element = top_element = current_group->end;
+			left_group();
+		}
+	}
+
+
+
+	// Pops the top number_to_pop elements, moving them to destination in the order they were pushed (ie. bottom-to-top), so that push(first, last) over the output restores them.
+	// Elements are output a group-chunk at a time, using memcpy when the destination is a pointer and the type is trivially-copyable. Returns the destination iterator past the last element written.
+	// If writing to the destination throws, no elements are popped, though some may have been moved from:
+	template <class output_iterator_type>
+	output_iterator_type pop_n(const size_type number_to_pop, output_iterator_type destination)
+	{
+		assert(number_to_pop <= total_number_of_elements);
+
+		if (number_to_pop == 0)
+		{
+			return destination;
+		}
+
+		// Find the group containing the lowest element to be popped:
+		group_pointer_type output_group = current_group;
+		size_type number_below = number_to_pop, number_in_group = static_cast<size_type>((top_element - start_element) + 1);
+
+		while (number_below > number_in_group)
+		{
+			number_below -= number_in_group;
+			output_group = output_group->previous_group;
+			number_in_group = static_cast<size_type>((output_group->end - output_group->elements) + 1);
+		}
+
+		element_pointer_type output_start = output_group->elements + (number_in_group - number_below);
+
+		while (output_group != current_group)
+		{
+			destination = output_elements(output_start, output_group->end + 1, destination);
+			output_group = output_group->next_group;
+			output_start = output_group->elements;
+		}
+
+		destination = output_elements(output_start, top_element + 1, destination);
+		pop_elements(number_to_pop);
+		return destination;
+	}
+
+
+
+	// Records the current top of the stack, so that everything pushed after this point can be discarded in one step by rewind():
+	inline marker mark() const PLF_STACK_NOEXCEPT
+	{
+		return marker(current_group, top_element, total_number_of_elements);
+	}
+
+
+
+	// Destroys all elements pushed since the marker was taken. Groups are retained for reuse, as with pop. For trivially-destructible types this is O(1).
+	// The stack must not have been popped below the marker's size since it was taken, nor had it's groups reallocated or freed (by clear, shrink_to_fit, reserve, change_group_sizes, trim_trailing_groups, assignment or swap):
+	void rewind(const marker &position) PLF_STACK_NOEXCEPT
+	{
+		assert(position.number_of_elements <= total_number_of_elements);
+
+		if (position.group_pointer == NULL) // ie. marker of a stack with no groups - rewind to empty, as pop leaves it
+		{
+			if (first_group != NULL)
+			{
+				rewind(marker(first_group, first_group->elements - 1, 0));
+			}
+
+			return;
+		}
+
+		#ifdef PLF_STACK_TYPE_TRAITS_SUPPORT
+			if (!(std::is_trivially_destructible<element_type>::value)) // This if-statement should be removed by the compiler on resolution of element_type
+		#endif
+		{
+			pop_elements(total_number_of_elements - position.number_of_elements);
+		}
+
+		const bool leaves_group = (current_group != position.group_pointer);
+
+		current_group = position.group_pointer;
+		start_element = current_group->elements;
+		end_element = current_group->end;
+		top_element = position.top_pointer;
+		total_number_of_elements = position.number_of_elements;
+
+		if (leaves_group)
+		{
+			left_group();
 		}
 	}
 
@@ -759,41 +1595,48 @@ public:
 	{
 		assert(&source != this);
 
-		destroy_all_data();
-		stack temp(source);
+		clear();
 
-		#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
-			*this = std::move(temp); // Avoid generating 2nd temporary
-		#else
-			this->swap(temp);
+		#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+			propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_copy_assignment());
 		#endif
 
+		total_number_of_elements = source.total_number_of_elements;
+		min_elements_per_group = source.min_elements_per_group;
+		group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+		trim_setting = source.trim_setting;
+		copy_from_source(source);
+
 		return *this;
 	}
 
 
 
 	#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
-		// Move assignment
+		// Move assignment - if the allocators are unequal and do not propagate, the source's memory cannot be taken over and elements are moved individually:
 		stack & operator = (stack &&source)
 		{
 			assert (&source != this);
 
-			destroy_all_data();
+			#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+				if (!std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment::value && static_cast<const element_allocator_type &>(*this) != static_cast<const element_allocator_type &>(source))
+				{
+					clear();
+					min_elements_per_group = source.min_elements_per_group;
+					group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+					trim_setting = source.trim_setting;
+					move_elements_from(source);
+					return *this;
+				}
+			#endif
 
-			current_group = std::move(source.current_group);
-			first_group = std::move(source.first_group);
-			top_element = std::move(source.top_element);
-			start_element = std::move(source.start_element);
-			end_element = std::move(source.end_element);
-			total_number_of_elements = source.total_number_of_elements;
-			min_elements_per_group = source.min_elements_per_group;
-			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+			destroy_all_data();
 
-			// Nullify source object's contents - only first_group and total_number_of_elements required to be altered for destructor to work on it:
-			source.first_group = NULL;
-			source.total_number_of_elements = 0;
+			#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+				propagate_allocator(source, typename std::allocator_traits<element_allocator_type>::propagate_on_container_move_assignment());
+			#endif
 
+			take_memory_from(source);
 			return *this;
 		}
 	#endif
@@ -816,7 +1659,11 @@ public:
 
 	inline size_type max_size() const PLF_STACK_NOEXCEPT
 	{
-		return element_allocator_type::max_size();
+		#ifdef PLF_STACK_ALLOCATOR_TRAITS_SUPPORT
+			return std::allocator_traits<element_allocator_type>::max_size(*this);
+		#else
+			return element_allocator_type::max_size();
+		#endif
 	}
 
 
@@ -865,7 +1712,7 @@ public:
 
 		if (first_group != NULL && (static_cast<size_type>((first_group->end + 1) - first_group->elements) < min_allocation_amount || static_cast<size_type>((current_group->end + 1) - current_group->elements) > max_allocation_amount))
 		{
-			stack temp(*this);
+			stack temp(*this, get_allocator()); // Allocator-extended copy, so that the temporary's memory is taken over by the move assignment below
 
 			#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
 				*this = std::move(temp); // Avoid generating 2nd temporary
@@ -894,7 +1741,9 @@ public:
 	void clear()
 	{
 		destroy_all_data();
+		current_group = NULL;
 		total_number_of_elements = 0;
+		idle_pops_remaining = 0;
 		top_element = NULL;
 		start_element = NULL;
 		end_element = NULL;
@@ -956,25 +1805,48 @@ public:
 	// Remove trailing stack groups (not removed in general 'pop' usage for performance reasons)
 	void trim_trailing_groups() PLF_STACK_NOEXCEPT
 	{
+		idle_pops_remaining = 0;
+
 		if (current_group == NULL)
 		{
 			return;
 		}
 
-		group_pointer_type temp_group = current_group->next_group, temp_group2;
-		current_group->next_group = NULL; // Set to NULL regardless of whether it is already NULL (avoids branching). Cuts off rest of groups from this group.
+		deallocate_trailing_groups(current_group);
+	}
+
 
-		while (temp_group != NULL)
+
+	// Sets when trailing groups - those left unused as the stack shrinks, and retained so that regrowth does not reallocate - are deallocated. threshold is a number of pops for
+	// trim_after_idle_pops and a number of bytes for trim_above_bytes, and is otherwise ignored. Trailing groups present when the policy is set are trimmed according to it:
+	void set_trim_policy(const trim_policy policy, const size_type threshold = 0) PLF_STACK_NOEXCEPT
+	{
+		trim_setting.policy = policy;
+		trim_setting.threshold = threshold;
+		idle_pops_remaining = 0;
+
+		if (current_group != NULL && current_group->next_group != NULL)
 		{
-			temp_group2 = temp_group;
-			temp_group = temp_group->next_group;
-			PLF_STACK_DESTROY(group_allocator_type, group_allocator_pair, temp_group2);
-			PLF_STACK_DEALLOCATE(group_allocator_type, group_allocator_pair, temp_group2, 1);
+			left_group();
 		}
 	}
 
 
 
+	inline trim_policy get_trim_policy() const PLF_STACK_NOEXCEPT
+	{
+		return trim_setting.policy;
+	}
+
+
+
+	inline size_type get_trim_threshold() const PLF_STACK_NOEXCEPT
+	{
+		return trim_setting.threshold;
+	}
+
+
+
 	void shrink_to_fit()
 	{
 		if (first_group == NULL || total_number_of_elements == capacity())
@@ -991,7 +1863,7 @@ public:
 		min_elements_per_group = (total_number_of_elements < group_allocator_pair.max_elements_per_group) ? static_cast<unsigned short>(total_number_of_elements) : group_allocator_pair.max_elements_per_group;
 		min_elements_per_group = (min_elements_per_group < 3) ? 3 : min_elements_per_group;
 
-		stack temp(*this);
+		stack temp(*this, get_allocator()); // Allocator-extended copy, so that the temporary's memory is taken over by the move assignment below
 
 		#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
 			*this = std::move(temp); // Avoid generating 2nd temporary
@@ -1034,7 +1906,7 @@ public:
 			const size_type original_min_elements = min_elements_per_group;
 			min_elements_per_group = reserve_amount;
 
-			stack temp(*this);
+			stack temp(*this, get_allocator()); // Allocator-extended copy, so that the temporary's memory is taken over by the move assignment below
 
 			#ifdef PLF_STACK_MOVE_SEMANTICS_SUPPORT
 				*this = std::move(temp); // Avoid generating 2nd temporary
@@ -1057,7 +1929,8 @@ public:
 		#else
 			group_pointer_type		swap_current_group = current_group, swap_first_group = first_group;
 			element_pointer_type	swap_top_element = top_element, swap_start_element = start_element, swap_end_element = end_element;
-			size_type				swap_total_number_of_elements = total_number_of_elements, swap_min_elements_per_group = min_elements_per_group, swap_max_elements_per_group = group_allocator_pair.max_elements_per_group;
+			size_type				swap_total_number_of_elements = total_number_of_elements, swap_min_elements_per_group = min_elements_per_group, swap_max_elements_per_group = group_allocator_pair.max_elements_per_group, swap_idle_pops_remaining = idle_pops_remaining;
+			trim_settings			swap_trim_setting = trim_setting;
 
 			current_group = source.current_group;
 			first_group = source.first_group;
@@ -1067,6 +1940,8 @@ public:
 			total_number_of_elements = source.total_number_of_elements;
 			min_elements_per_group = source.min_elements_per_group;
 			group_allocator_pair.max_elements_per_group = source.group_allocator_pair.max_elements_per_group;
+			trim_setting = source.trim_setting;
+			idle_pops_remaining = source.idle_pops_remaining;
 			
 			source.current_group = swap_current_group;
 			source.first_group = swap_first_group;
@@ -1076,13 +1951,15 @@ public:
 			source.total_number_of_elements = swap_total_number_of_elements;
 			source.min_elements_per_group = swap_min_elements_per_group;
 			source.group_allocator_pair.max_elements_per_group = swap_max_elements_per_group;
+			source.trim_setting = swap_trim_setting;
+			source.idle_pops_remaining = swap_idle_pops_remaining;
 		#endif
 	}	
 
 
     inline allocator_type get_allocator() const PLF_STACK_NOEXCEPT
     {
-		return element_allocator_type();
+		return *this;
 	}
 
 }; // stack
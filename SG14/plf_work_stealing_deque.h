@@ -0,0 +1,649 @@
+#ifndef PLF_WORK_STEALING_DEQUE_H
+#define PLF_WORK_STEALING_DEQUE_H
+
+// work_stealing_deque: a Chase-Lev work-stealing deque (Chase & Lev 2005, with the C11 memory orderings of Le et al. 2013) laid out in plf::stack's chained groups rather than a
+// circular array. The owning thread pushes and pops at the bottom while any number of thieves steal from the top. Growth links a new group onto the chain instead of copying the
+// live elements into a larger array, and groups the thieves have moved past are recycled onto the bottom of the chain rather than deallocated.
+// work_stealing_pool: a fork-join thread pool with one deque per worker. Tasks spawned from a worker go onto it's own deque, idle workers steal, and waiting threads execute tasks until their task group completes.
+// Both require C++11 (std::atomic, std::thread), and raw (non-fancy) allocator pointers.
+
+#include <atomic>
+#include <cassert>	// assert
+#include <condition_variable>
+#include <cstddef>	// std::size_t, std::ptrdiff_t
+#include <cstdint>	// std::int64_t
+#include <deque>
+#include <limits>	// std::numeric_limits
+#include <memory>	// std::allocator, std::allocator_traits, std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>	// std::move, std::forward
+#include <vector>
+
+
+namespace plf
+{
+
+
+// Elements are stored in groups of atomic slots. Each group covers a contiguous range of the deque's (64-bit, never-wrapping) indices, starting at it's first_index.
+// Thieves find the group containing the top index by walking forward from top_group, a hint which only the owner updates (so that it can never move backwards).
+// When the owner runs out of room it moves to the next group in the chain; if there is none it recycles the oldest group if all thieves have moved past it, otherwise allocates.
+// A thief holding a stale group pointer may read a recycled group, but the group's first_index shows the mismatch, and the top index has moved on so it's steal would fail regardless.
+// element_type must be trivially copyable, as a thief may read a slot while the owner overwrites it (the thief's steal then fails) - typically it is a pointer to a task.
+template <class element_type, class element_allocator_type = std::allocator<element_type> > class work_stealing_deque : private element_allocator_type  // Empty base class optimisation - inheriting allocator functions
+{
+public:
+	typedef element_type																value_type;
+	typedef element_allocator_type														allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::size_type		size_type;
+
+private:
+	struct group; // Forward declaration for typedefs below
+
+	typedef std::atomic<element_type>																slot_type;
+	typedef std::int64_t																			index_type;
+	typedef typename std::allocator_traits<element_allocator_type>::template rebind_alloc<group>		group_allocator_type;
+	typedef typename std::allocator_traits<element_allocator_type>::template rebind_alloc<slot_type>	slot_allocator_type;
+
+	static_assert(std::is_pointer<typename std::allocator_traits<group_allocator_type>::pointer>::value, "work_stealing_deque requires an allocator with raw pointers, as group pointers are atomic");
+	static_assert(std::is_trivially_copyable<element_type>::value, "work_stealing_deque requires a trivially-copyable element_type, as thieves read slots concurrently with the owner");
+
+	struct group
+	{
+		slot_type * const				elements;
+		std::atomic<group *>			next_group; // Read by thieves walking forward from top_group
+		group *							previous_group; // Only accessed by the owner
+		std::atomic<index_type>			first_index; // Deque index of elements[0] - changed when the group is recycled
+		const size_type					size;
+
+		group(slot_type * const group_elements, group * const previous, const index_type index, const size_type elements_per_group) noexcept:
+			elements(group_elements),
+			next_group(nullptr),
+			previous_group(previous),
+			first_index(index),
+			size(elements_per_group)
+		{}
+	};
+
+
+	group *									first_group; // Oldest group in the chain - only accessed by the owner
+	group *									bottom_group; // Group containing the bottom index, ie. first_index <= bottom <= first_index + size - only accessed by the owner
+	size_type								min_elements_per_group, max_elements_per_group;
+	group_allocator_type					group_allocator;
+
+	// Padding rather than alignas(64) keeps the thieves' and owner's indices on separate cache lines without making the deque over-aligned, so that it can be allocated with new prior to C++17:
+	char									top_padding[64];
+	std::atomic<index_type>					top; // Index of the oldest element, incremented by successful steals (and by the owner when it takes the last element)
+	std::atomic<group *>					top_group; // Group at or before the one containing top - written by the owner, read by thieves
+	char									bottom_padding[64];
+	std::atomic<index_type>					bottom; // Index one past the newest element - written by the owner
+	char									end_padding[64];
+
+
+public:
+
+	explicit work_stealing_deque(const element_allocator_type &alloc = element_allocator_type()):
+		work_stealing_deque(64, 8192, alloc)
+	{}
+
+
+
+	explicit work_stealing_deque(const size_type min_allocation_amount, const size_type max_allocation_amount = 8192, const element_allocator_type &alloc = element_allocator_type()):
+		element_allocator_type(alloc),
+		first_group(nullptr),
+		bottom_group(nullptr),
+		min_elements_per_group(min_allocation_amount),
+		max_elements_per_group(max_allocation_amount),
+		group_allocator(alloc),
+		top(0),
+		top_group(nullptr),
+		bottom(0)
+	{
+		assert(min_elements_per_group > 2);
+		assert(min_elements_per_group <= max_elements_per_group);
+		assert(max_elements_per_group <= static_cast<size_type>(std::numeric_limits<index_type>::max() / 2));
+
+		first_group = bottom_group = create_group(min_elements_per_group, nullptr, 0);
+		top_group.store(first_group, std::memory_order_relaxed);
+	}
+
+
+
+	work_stealing_deque(const work_stealing_deque &) = delete;
+	work_stealing_deque & operator = (const work_stealing_deque &) = delete;
+
+
+
+	// Not thread-safe - all thieves must have finished with the deque. Remaining elements are discarded (they are trivially destructible):
+	~work_stealing_deque() noexcept
+	{
+		slot_allocator_type slot_allocator(*this);
+
+		for (group *current_group = first_group; current_group != nullptr;)
+		{
+			group * const next_group = current_group->next_group.load(std::memory_order_relaxed);
+			std::allocator_traits<slot_allocator_type>::deallocate(slot_allocator, current_group->elements, current_group->size);
+			std::allocator_traits<group_allocator_type>::destroy(group_allocator, current_group);
+			std::allocator_traits<group_allocator_type>::deallocate(group_allocator, current_group, 1);
+			current_group = next_group;
+		}
+	}
+
+
+
+	// Owner only:
+	void push(const element_type &element)
+	{
+		const index_type bottom_index = bottom.load(std::memory_order_relaxed);
+
+		if (bottom_index == bottom_group->first_index.load(std::memory_order_relaxed) + static_cast<index_type>(bottom_group->size))
+		{
+			advance_bottom_group(bottom_index);
+		}
+
+		bottom_group->elements[bottom_index - bottom_group->first_index.load(std::memory_order_relaxed)].store(element, std::memory_order_relaxed);
+		bottom.store(bottom_index + 1, std::memory_order_release); // Publishes the element, and any group linked or recycled above
+	}
+
+
+
+	// Owner only. Takes the newest element into destination and returns true, or returns false if the deque is empty (including when a thief took the last element first):
+	bool pop(element_type &destination) noexcept
+	{
+		const index_type bottom_index = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(bottom_index, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst); // The bottom decrement must be visible to thieves before top is read, so that at most one of the owner and a thief takes the last element
+		index_type top_index = top.load(std::memory_order_relaxed);
+
+		if (top_index > bottom_index)
+		{
+			bottom.store(bottom_index + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (bottom_index < bottom_group->first_index.load(std::memory_order_relaxed)) // The element is at the end of the previous group, which cannot have been recycled as top is at or below it
+		{
+			bottom_group = bottom_group->previous_group;
+		}
+
+		const element_type element = bottom_group->elements[bottom_index - bottom_group->first_index.load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+
+		if (top_index == bottom_index) // Last element - race the thieves for it
+		{
+			const bool taken = top.compare_exchange_strong(top_index, top_index + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(bottom_index + 1, std::memory_order_relaxed);
+
+			if (!taken)
+			{
+				return false;
+			}
+		}
+
+		destination = element;
+		return true;
+	}
+
+
+
+	// Any thread. Takes the oldest element into destination and returns true, or returns false if the deque is empty or another thread took the element first:
+	bool steal(element_type &destination) noexcept
+	{
+		index_type top_index = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const index_type bottom_index = bottom.load(std::memory_order_acquire);
+
+		if (top_index >= bottom_index)
+		{
+			return false;
+		}
+
+		group *current_group = top_group.load(std::memory_order_acquire);
+		index_type first_index;
+
+		while (true)
+		{
+			first_index = current_group->first_index.load(std::memory_order_acquire);
+
+			if (top_index < first_index) // top_group has moved past top_index, or the group was recycled - either way top has moved on
+			{
+				return false;
+			}
+			else if (top_index < first_index + static_cast<index_type>(current_group->size))
+			{
+				break;
+			}
+
+			current_group = current_group->next_group.load(std::memory_order_acquire);
+
+			if (current_group == nullptr) // Walked off a recycled group
+			{
+				return false;
+			}
+		}
+
+		const element_type element = current_group->elements[top_index - first_index].load(std::memory_order_relaxed);
+
+		if (!top.compare_exchange_strong(top_index, top_index + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		destination = element;
+		return true;
+	}
+
+
+
+	// Approximate when called concurrently with other operations:
+	bool empty() const noexcept
+	{
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+
+
+
+	size_type size() const noexcept
+	{
+		const index_type number_of_elements = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+		return (number_of_elements < 0) ? 0 : static_cast<size_type>(number_of_elements);
+	}
+
+
+
+	allocator_type get_allocator() const noexcept
+	{
+		return *this;
+	}
+
+
+private:
+
+	group * create_group(const size_type elements_per_group, group * const previous, const index_type index)
+	{
+		slot_allocator_type slot_allocator(*this);
+		slot_type * const elements = std::allocator_traits<slot_allocator_type>::allocate(slot_allocator, elements_per_group);
+		group *new_group;
+
+		try
+		{
+			new_group = std::allocator_traits<group_allocator_type>::allocate(group_allocator, 1);
+		}
+		catch (...)
+		{
+			std::allocator_traits<slot_allocator_type>::deallocate(slot_allocator, elements, elements_per_group);
+			throw;
+		}
+
+		for (slot_type *slot = elements; slot != elements + elements_per_group; ++slot)
+		{
+			std::allocator_traits<slot_allocator_type>::construct(slot_allocator, slot); // noexcept
+		}
+
+		std::allocator_traits<group_allocator_type>::construct(group_allocator, new_group, elements, previous, index, elements_per_group); // noexcept
+		return new_group;
+	}
+
+
+
+	// Called by push when the bottom group is full. Also brings top_group up to date, which is what allows groups before it to be recycled:
+	void advance_bottom_group(const index_type bottom_index)
+	{
+		const index_type top_index = top.load(std::memory_order_acquire);
+		group *new_top_group = top_group.load(std::memory_order_relaxed);
+
+		while (new_top_group != bottom_group && top_index >= new_top_group->first_index.load(std::memory_order_relaxed) + static_cast<index_type>(new_top_group->size))
+		{
+			new_top_group = new_top_group->next_group.load(std::memory_order_relaxed);
+		}
+
+		top_group.store(new_top_group, std::memory_order_release);
+
+		group *next_group = bottom_group->next_group.load(std::memory_order_relaxed);
+
+		if (next_group == nullptr)
+		{
+			if (first_group != new_top_group) // Every index in first_group is below top - recycle it, whatever it's size, so that memory use is bounded by the peak number of live elements
+			{
+				next_group = first_group;
+				first_group = next_group->next_group.load(std::memory_order_relaxed);
+				first_group->previous_group = nullptr;
+				next_group->next_group.store(nullptr, std::memory_order_relaxed);
+				next_group->previous_group = bottom_group;
+				next_group->first_index.store(bottom_index, std::memory_order_release);
+			}
+			else // Size new groups to the number of live elements, as plf::stack sizes them to it's total:
+			{
+				const index_type number_of_elements = bottom_index - top_index;
+				const size_type new_group_size = (number_of_elements < static_cast<index_type>(min_elements_per_group)) ? min_elements_per_group : (number_of_elements > static_cast<index_type>(max_elements_per_group)) ? max_elements_per_group : static_cast<size_type>(number_of_elements);
+				next_group = create_group(new_group_size, bottom_group, bottom_index);
+			}
+
+			bottom_group->next_group.store(next_group, std::memory_order_release);
+		}
+
+		bottom_group = next_group;
+	}
+};
+
+
+
+// Base class for the tasks run by work_stealing_pool:
+class pool_task
+{
+public:
+	class task_group *group;
+
+	virtual void execute() = 0;
+	virtual ~pool_task() {}
+};
+
+
+
+// Counts the outstanding tasks spawned into it. work_stealing_pool::wait() returns once all have run:
+class task_group
+{
+public:
+	std::atomic<std::size_t> pending;
+
+	task_group() noexcept : pending(0) {}
+
+	task_group(const task_group &) = delete;
+	task_group & operator = (const task_group &) = delete;
+};
+
+
+
+// Fork-join thread pool. Each worker owns a task_deque_type (an owner push/pop and any-thread steal interface, as work_stealing_deque<pool_task *> provides).
+// Tasks spawned from a worker thread go onto that worker's deque; tasks spawned from other threads go onto a shared injection queue. Workers run their own newest task first,
+// then injected tasks, then steal the oldest task of another worker. wait() executes tasks until the group completes, so it may be called from within tasks. Tasks must not throw.
+template <class task_deque_type = work_stealing_deque<pool_task *> > class work_stealing_pool
+{
+private:
+	template <class function_type>
+	class function_task : public pool_task
+	{
+	public:
+		function_type function;
+
+		explicit function_task(function_type &&task_function) : function(std::move(task_function)) {}
+
+		void execute() override
+		{
+			function();
+		}
+	};
+
+
+	struct worker
+	{
+		task_deque_type	deque;
+		std::thread		thread;
+	};
+
+
+	std::vector<std::unique_ptr<worker> >	workers;
+	std::mutex								injection_mutex;
+	std::deque<pool_task *>					injected_tasks;
+	std::atomic<std::ptrdiff_t>				injected_count;
+	std::atomic<std::ptrdiff_t>				queued_count; // Tasks pushed but not yet taken. Transiently negative when a task is taken before it's push is counted
+	std::atomic<unsigned int>				sleeping_count;
+	std::mutex								sleep_mutex;
+	std::condition_variable					sleep_condition;
+	std::atomic<bool>						stopping;
+
+	static const unsigned int spins_before_sleeping = 64;
+
+
+public:
+
+	explicit work_stealing_pool(unsigned int number_of_threads = std::thread::hardware_concurrency()):
+		injected_count(0),
+		queued_count(0),
+		sleeping_count(0),
+		stopping(false)
+	{
+		if (number_of_threads == 0)
+		{
+			number_of_threads = 1;
+		}
+
+		for (unsigned int index = 0; index != number_of_threads; ++index)
+		{
+			workers.emplace_back(new worker());
+		}
+
+		for (unsigned int index = 0; index != number_of_threads; ++index)
+		{
+			workers[index]->thread = std::thread(&work_stealing_pool::worker_loop, this, index);
+		}
+	}
+
+
+
+	work_stealing_pool(const work_stealing_pool &) = delete;
+	work_stealing_pool & operator = (const work_stealing_pool &) = delete;
+
+
+
+	// All task groups should have been waited on. Tasks still queued are destroyed without being run:
+	~work_stealing_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			stopping.store(true, std::memory_order_release);
+		}
+
+		sleep_condition.notify_all();
+
+		for (std::size_t index = 0; index != workers.size(); ++index)
+		{
+			workers[index]->thread.join();
+		}
+
+		pool_task *task;
+
+		while ((task = find_task(0)) != nullptr) // Workers have exited, so this thread may act as any deque's owner
+		{
+			delete task;
+		}
+	}
+
+
+
+	template <class function_type>
+	void spawn(task_group &group, function_type &&function)
+	{
+		pool_task * const task = new function_task<typename std::decay<function_type>::type>(typename std::decay<function_type>::type(std::forward<function_type>(function)));
+		task->group = &group;
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+
+		const unsigned int index = current_worker_index();
+
+		if (index != no_worker)
+		{
+			workers[index]->deque.push(task);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(injection_mutex);
+			injected_tasks.push_back(task);
+			injected_count.fetch_add(1, std::memory_order_release);
+		}
+
+		queued_count.fetch_add(1, std::memory_order_seq_cst);
+
+		if (sleeping_count.load(std::memory_order_seq_cst) != 0)
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			sleep_condition.notify_one();
+		}
+	}
+
+
+
+	// Runs tasks (of any group) until every task spawned into the group has completed:
+	void wait(task_group &group)
+	{
+		const unsigned int index = current_worker_index();
+
+		while (group.pending.load(std::memory_order_acquire) != 0)
+		{
+			pool_task * const task = find_task(index);
+
+			if (task != nullptr)
+			{
+				run(task);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+
+
+	std::size_t number_of_threads() const noexcept
+	{
+		return workers.size();
+	}
+
+
+private:
+
+	static const unsigned int no_worker = static_cast<unsigned int>(-1);
+
+
+	struct thread_identity
+	{
+		const work_stealing_pool *pool;
+		unsigned int index;
+	};
+
+
+	// Set by each worker thread on startup. A worker of one pool may spawn into or wait on another, where it acts as an external thread:
+	static thread_identity & this_thread_identity() noexcept
+	{
+		static thread_local thread_identity identity = {nullptr, no_worker};
+		return identity;
+	}
+
+
+
+	// The calling thread's worker index if it is one of this pool's workers, otherwise no_worker:
+	unsigned int current_worker_index() const noexcept
+	{
+		const thread_identity &identity = this_thread_identity();
+		return (identity.pool == this) ? identity.index : no_worker;
+	}
+
+
+
+	// Own deque (if a worker), then the injection queue, then the other workers' deques starting from a pseudo-random victim:
+	pool_task * find_task(const unsigned int index)
+	{
+		pool_task *task;
+
+		if (index != no_worker && workers[index]->deque.pop(task))
+		{
+			queued_count.fetch_sub(1, std::memory_order_relaxed);
+			return task;
+		}
+
+		if (injected_count.load(std::memory_order_acquire) > 0)
+		{
+			std::lock_guard<std::mutex> lock(injection_mutex);
+
+			if (!injected_tasks.empty())
+			{
+				task = injected_tasks.front();
+				injected_tasks.pop_front();
+				injected_count.fetch_sub(1, std::memory_order_relaxed);
+				queued_count.fetch_sub(1, std::memory_order_relaxed);
+				return task;
+			}
+		}
+
+		static thread_local unsigned int random_state = 0x9E3779B9u;
+		random_state ^= random_state << 13;
+		random_state ^= random_state >> 17;
+		random_state ^= random_state << 5;
+
+		const std::size_t number_of_workers = workers.size();
+		const std::size_t first_victim = random_state % number_of_workers;
+
+		for (std::size_t offset = 0; offset != number_of_workers; ++offset)
+		{
+			const std::size_t victim = (first_victim + offset) % number_of_workers;
+
+			if (victim != index && workers[victim]->deque.steal(task))
+			{
+				queued_count.fetch_sub(1, std::memory_order_relaxed);
+				return task;
+			}
+		}
+
+		return nullptr;
+	}
+
+
+
+	void run(pool_task * const task)
+	{
+		task_group * const group = task->group;
+		task->execute();
+		delete task;
+		group->pending.fetch_sub(1, std::memory_order_release);
+	}
+
+
+
+	void worker_loop(const unsigned int index)
+	{
+		this_thread_identity().pool = this;
+		this_thread_identity().index = index;
+		unsigned int failed_attempts = 0;
+
+		while (true)
+		{
+			pool_task * const task = find_task(index);
+
+			if (task != nullptr)
+			{
+				run(task);
+				failed_attempts = 0;
+				continue;
+			}
+
+			if (stopping.load(std::memory_order_acquire))
+			{
+				return;
+			}
+
+			if (++failed_attempts < spins_before_sleeping)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Sleep until a task is spawned. sleeping_count is incremented before queued_count is checked, and spawn increments queued_count before checking sleeping_count, so a wakeup cannot be missed:
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			sleeping_count.fetch_add(1, std::memory_order_seq_cst);
+
+			while (queued_count.load(std::memory_order_seq_cst) <= 0 && !stopping.load(std::memory_order_relaxed))
+			{
+				sleep_condition.wait(lock);
+			}
+
+			sleeping_count.fetch_sub(1, std::memory_order_relaxed);
+			failed_attempts = 0;
+		}
+	}
+};
+
+
+} // plf namespace
+
+
+#endif // PLF_WORK_STEALING_DEQUE_H
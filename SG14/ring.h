@@ -1,7 +1,18 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <iterator>
 #include <cassert>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "algorithm_ext.h"
 
 namespace sg14
 {
@@ -25,6 +36,79 @@ namespace sg14
 		T copy;
 	};
 
+	// Capacity policies for ring_index. static_capacity is fixed at compile time, so that wrapping an index folds to a mask when N is a power of two and to a comparison
+	// otherwise. dynamic_capacity is chosen at run time, along with a mask which is capacity - 1 when the capacity is a power of two (other than 1) and 0 otherwise:
+	template<std::size_t N>
+	class static_capacity
+	{
+	public:
+		explicit static_capacity(std::size_t = N) noexcept {}
+		static constexpr std::size_t capacity() noexcept { return N; }
+		static constexpr bool masked() noexcept { return (N & (N - 1)) == 0; }
+		static constexpr std::size_t mask() noexcept { return N - 1; }
+		void swap(static_capacity&) noexcept {}
+	};
+
+	class dynamic_capacity
+	{
+	public:
+		explicit dynamic_capacity(std::size_t capacity = 0) noexcept : m_capacity(capacity), m_mask((capacity > 1 && (capacity & (capacity - 1)) == 0) ? capacity - 1 : 0) {}
+		std::size_t capacity() const noexcept { return m_capacity; }
+		bool masked() const noexcept { return m_mask != 0; }
+		std::size_t mask() const noexcept { return m_mask; }
+		void swap(dynamic_capacity& rhs) noexcept { std::swap(m_capacity, rhs.m_capacity); std::swap(m_mask, rhs.m_mask); }
+
+	private:
+		std::size_t m_capacity;
+		std::size_t m_mask;
+	};
+
+	// The front index and size of a ring over contiguous storage, and the index math shared by ring_span, static_ring and uninitialized_ring_span - the rings themselves only
+	// hold the storage and move elements in and out of it. When the capacity is masked the front index is free-running, wrapping by masking whenever it is used. Otherwise it
+	// is kept below the capacity, and an index (which is then at most front + size) wraps with a comparison - no division either way. The indices of front_idx() and end_idx()
+	// are what ring_iterator holds, and wrap() turns one into an offset into the storage:
+	template<class Capacity>
+	class ring_index : private Capacity
+	{
+	public:
+		using size_type = std::size_t;
+		using runs_type = std::array<std::pair<size_type, size_type>, 2>; // (offset, length) pairs, the second empty unless the run wraps around the end of the storage
+
+		ring_index() noexcept;
+		ring_index(size_type capacity, size_type front_offset, size_type size) noexcept;
+
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		using Capacity::capacity;
+
+		size_type front_idx() const noexcept;
+		size_type end_idx() const noexcept;
+		size_type wrap(size_type idx) const noexcept;
+		size_type back_offset() const noexcept; // Where the next push goes
+
+		// The storage covered by the n elements (or empty slots) starting distance places after the front, as at most two runs. distance may be more than the capacity:
+		runs_type runs(size_type distance, size_type n) const noexcept;
+
+		// Counting elements in and out. push() counts in one element written at back_offset(), overwriting the front element when full, and push(n) counts in n written
+		// after the back the same way (so only the last capacity() of them remain). grow(n) counts in n written after the back without overwriting. pop() returns the
+		// offset of the front element as it removes it:
+		void push() noexcept;
+		void push(size_type n) noexcept;
+		void grow(size_type n) noexcept;
+		size_type pop() noexcept;
+		void pop(size_type n) noexcept;
+
+		void swap(ring_index& rhs) noexcept;
+
+	private:
+		size_type next(size_type idx) const noexcept;
+		size_type advance(size_type idx, size_type n) const noexcept;
+
+		size_type m_front_idx;
+		size_type m_size;
+	};
+
 	template <typename, bool>
 	class ring_iterator;
 
@@ -36,6 +120,7 @@ namespace sg14
 		using size_type = std::size_t;
 		using value_type = T;
 		using pointer = T*;
+		using const_pointer = const T*;
 		using reference = T&;
 		using const_reference = const T&;
 		using iterator = ring_iterator<type, false>;
@@ -50,6 +135,7 @@ namespace sg14
 		template <class ContiguousIterator>
 		ring_span(ContiguousIterator begin, ContiguousIterator end, ContiguousIterator first, size_type size, Popper p = Popper()) noexcept;
 
+		ring_span() noexcept; // Empty, with no storage - only useful as a placeholder to move or swap another ring_span into
 		ring_span(ring_span&&) = default;
 		ring_span& operator=(ring_span&&) = default;
 
@@ -78,19 +164,33 @@ namespace sg14
 		void emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
 		auto pop_front();
 
+		// Bulk operations, copying or moving the elements in at most two contiguous runs, so that trivially-copyable elements are transferred with memmove.
+		// push_back(first, last) behaves as push_back of each element in turn, overwriting the oldest elements once the ring is full, but copies at most capacity() of them.
+		// pop_front_n(n, out) behaves as n calls to pop_front() assigning each result to *out++ - with the default popper the elements are moved out directly.
+		// pop_front_n(n) pops n elements without a destination, as after reading them in place through contiguous_regions():
+		template<class ForwardIterator>
+		void push_back(ForwardIterator first, ForwardIterator last);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out);
+		void pop_front_n(size_type n);
+
+		// The elements from front to back, as at most two (pointer, length) pairs - the second is empty unless the elements wrap around the end of the storage:
+		std::array<std::pair<pointer, size_type>, 2> contiguous_regions() noexcept;
+		std::array<std::pair<const_pointer, size_type>, 2> contiguous_regions() const noexcept;
+
 		void swap(type& rhs) noexcept;// (std::is_nothrow_swappable<Popper>::value);
 
 		// Example implementation
 	private:
 		reference at(size_type idx) noexcept;
 		const_reference at(size_type idx) const noexcept;
-		size_type back_idx() const noexcept;
-		void increase_size() noexcept;
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out, std::true_type moving_popper);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out, std::false_type moving_popper);
 
 		T* m_data;
-		size_type m_size;
-		size_type m_capacity;
-		size_type m_front_idx;
+		ring_index<dynamic_capacity> m_index;
 		Popper m_popper;
 	};
 
@@ -135,6 +235,452 @@ namespace sg14
 		size_type m_idx;
 		std::conditional_t<is_const, const Ring, Ring>* m_rv;
 	};
+
+	// Ring owning it's storage, an array of N elements inside the ring itself. The capacity is a compile-time constant, so that wrapping an index folds to a mask when N is
+	// a power of two and to a comparison otherwise. Otherwise as ring_span: the elements are value-initialised with the ring, and are assigned to by pushes. Copyable.
+	template<typename T, std::size_t N, class Popper = default_popper<T>>
+	class static_ring
+	{
+	public:
+		using type = static_ring<T, N, Popper>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = ring_iterator<type, false>;
+		using const_iterator = ring_iterator<type, true>;
+
+		friend class ring_iterator<type, false>;
+		friend class ring_iterator<type, true>;
+
+		static_assert(N != 0, "static_ring requires a capacity of at least 1");
+
+		explicit static_ring(Popper p = Popper()) noexcept(std::is_nothrow_default_constructible<T>::value && std::is_nothrow_move_constructible<Popper>::value);
+
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		static constexpr size_type capacity() noexcept { return N; }
+
+		reference front() noexcept;
+		const_reference front() const noexcept;
+		reference back() noexcept;
+		const_reference back() const noexcept;
+
+		iterator begin() noexcept;
+		const_iterator begin() const noexcept;
+		const_iterator cbegin() const noexcept;
+		iterator end() noexcept;
+		const_iterator end() const noexcept;
+		const_iterator cend() const noexcept;
+
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_assignable<T>::value>>
+		void push_back(const value_type& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		void push_back(value_type&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+		template<class... FromType>
+		void emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
+		auto pop_front();
+
+		// As for ring_span:
+		template<class ForwardIterator>
+		void push_back(ForwardIterator first, ForwardIterator last);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out);
+		void pop_front_n(size_type n);
+		std::array<std::pair<pointer, size_type>, 2> contiguous_regions() noexcept;
+		std::array<std::pair<const_pointer, size_type>, 2> contiguous_regions() const noexcept;
+
+		void swap(type& rhs) noexcept(noexcept(std::declval<std::array<T, N>&>().swap(std::declval<std::array<T, N>&>())));
+
+		// Example implementation
+	private:
+		reference at(size_type idx) noexcept;
+		const_reference at(size_type idx) const noexcept;
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out, std::true_type moving_popper);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out, std::false_type moving_popper);
+
+		std::array<T, N> m_data;
+		ring_index<static_capacity<N>> m_index;
+		Popper m_popper;
+	};
+
+	// Ring owning it's storage, a single allocation of capacity() value-initialised elements, viewed through a ring_span. When full, a push either overwrites the front element
+	// as for ring_span (full_policy::overwrite), or reallocates with twice the capacity (full_policy::grow). Iterators and pointers are invalidated by reallocation and by moving the ring.
+	template<typename T, class Alloc = std::allocator<T>, class Popper = default_popper<T>>
+	class dynamic_ring
+	{
+	public:
+		using type = dynamic_ring<T, Alloc, Popper>;
+		using span_type = ring_span<T, Popper>;
+		using allocator_type = Alloc;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = typename span_type::iterator;
+		using const_iterator = typename span_type::const_iterator;
+
+		enum class full_policy { overwrite, grow };
+
+		static_assert(std::is_same<typename std::allocator_traits<Alloc>::pointer, T*>::value, "dynamic_ring requires an allocator with raw pointers");
+
+		explicit dynamic_ring(size_type capacity, full_policy policy = full_policy::overwrite, const Alloc& alloc = Alloc(), Popper p = Popper());
+		dynamic_ring(const dynamic_ring& source);
+		dynamic_ring(dynamic_ring&& source) noexcept;
+		dynamic_ring& operator=(const dynamic_ring& source);
+		dynamic_ring& operator=(dynamic_ring&& source) noexcept;
+		~dynamic_ring();
+
+		bool empty() const noexcept { return m_span.empty(); }
+		bool full() const noexcept { return m_span.full(); }
+		size_type size() const noexcept { return m_span.size(); }
+		size_type capacity() const noexcept { return m_capacity; }
+		full_policy policy() const noexcept { return m_policy; }
+		void set_policy(full_policy policy) noexcept { m_policy = policy; }
+		allocator_type get_allocator() const noexcept { return m_allocator; }
+
+		reference front() noexcept { return m_span.front(); }
+		const_reference front() const noexcept { return m_span.front(); }
+		reference back() noexcept { return m_span.back(); }
+		const_reference back() const noexcept { return m_span.back(); }
+
+		iterator begin() noexcept { return m_span.begin(); }
+		const_iterator begin() const noexcept { return m_span.begin(); }
+		const_iterator cbegin() const noexcept { return m_span.cbegin(); }
+		iterator end() noexcept { return m_span.end(); }
+		const_iterator end() const noexcept { return m_span.end(); }
+		const_iterator cend() const noexcept { return m_span.cend(); }
+
+		void push_back(const value_type& from_value);
+		void push_back(value_type&& from_value);
+		template<class... FromType>
+		void emplace_back(FromType&&... from_value);
+		auto pop_front() { return m_span.pop_front(); }
+
+		// As for ring_span, except that with full_policy::grow push_back(first, last) reallocates as needed to keep every element:
+		template<class ForwardIterator>
+		void push_back(ForwardIterator first, ForwardIterator last);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out) { return m_span.pop_front_n(n, out); }
+		void pop_front_n(size_type n) { m_span.pop_front_n(n); }
+		std::array<std::pair<pointer, size_type>, 2> contiguous_regions() noexcept { return m_span.contiguous_regions(); }
+		std::array<std::pair<const_pointer, size_type>, 2> contiguous_regions() const noexcept { return m_span.contiguous_regions(); }
+
+		// Reallocates if new_capacity is greater than capacity(), moving the elements to the start of the new storage. Strong exception guarantee:
+		void reserve(size_type new_capacity);
+
+		void swap(type& rhs) noexcept;
+
+		// Example implementation
+	private:
+		using allocator_traits = std::allocator_traits<Alloc>;
+
+		template<class SourceSpan>
+		void reallocate(size_type new_capacity, SourceSpan& source);
+		void make_room(size_type count);
+		void destroy_storage() noexcept;
+
+		Alloc m_allocator;
+		T* m_storage;
+		size_type m_capacity;
+		full_policy m_policy;
+		Popper m_popper; // Copied into the ring_span made over each new allocation
+		span_type m_span;
+	};
+
+	// Ring over raw storage for types that are expensive or impossible to default-construct, assign or copy. Nothing in the storage is constructed up-front: pushes construct
+	// their element in place with placement new, pops destroy it, and the span destroys whatever elements remain when it is destroyed - it owns the elements, though not the
+	// storage, which must stay valid (and suitably aligned for T) for the span's lifetime. When the ring is full a push destroys the front element and constructs the new one
+	// in it's place, so the arguments of such a push must not refer to the front element. Otherwise as ring_span, with the default popper. Movable, not copyable.
+	template<typename T>
+	class uninitialized_ring_span
+	{
+	public:
+		using type = uninitialized_ring_span<T>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = ring_iterator<type, false>;
+		using const_iterator = ring_iterator<type, true>;
+
+		friend class ring_iterator<type, false>;
+		friend class ring_iterator<type, true>;
+
+		// storage is room for capacity elements, e.g. from an allocator or an array of std::aligned_storage_t<sizeof(T), alignof(T)>:
+		uninitialized_ring_span(void* storage, size_type capacity) noexcept;
+
+		uninitialized_ring_span() noexcept; // Empty, with no storage - only useful as a placeholder to move or swap another ring into
+		uninitialized_ring_span(uninitialized_ring_span&& source) noexcept;
+		uninitialized_ring_span& operator=(uninitialized_ring_span&& source) noexcept;
+		uninitialized_ring_span(const uninitialized_ring_span&) = delete;
+		uninitialized_ring_span& operator=(const uninitialized_ring_span&) = delete;
+		~uninitialized_ring_span();
+
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		reference front() noexcept;
+		const_reference front() const noexcept;
+		reference back() noexcept;
+		const_reference back() const noexcept;
+
+		iterator begin() noexcept;
+		const_iterator begin() const noexcept;
+		const_iterator cbegin() const noexcept;
+		iterator end() noexcept;
+		const_iterator end() const noexcept;
+		const_iterator cend() const noexcept;
+
+		// Strong exception guarantee unless the ring is full, in which case the front element is gone even if constructing the new one throws:
+		void push_back(const value_type& from_value) noexcept(std::is_nothrow_copy_constructible<T>::value);
+		void push_back(value_type&& from_value) noexcept(std::is_nothrow_move_constructible<T>::value);
+		template<class... FromType>
+		void emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value);
+		value_type pop_front();
+
+		// As for ring_span. push_back(first, last) copy-constructs the elements in at most two runs, and pop_front_n(n, out) move-assigns them to out before destroying them.
+		// extend_back(n) constructs n default-initialised elements after the back, to be written in place through contiguous_regions() - n must be at most capacity() - size():
+		template<class ForwardIterator>
+		void push_back(ForwardIterator first, ForwardIterator last);
+		void extend_back(size_type n);
+		template<class OutputIterator>
+		OutputIterator pop_front_n(size_type n, OutputIterator out);
+		void pop_front_n(size_type n) noexcept;
+		void clear() noexcept;
+		std::array<std::pair<pointer, size_type>, 2> contiguous_regions() noexcept;
+		std::array<std::pair<const_pointer, size_type>, 2> contiguous_regions() const noexcept;
+
+		void swap(type& rhs) noexcept;
+
+		// Example implementation
+	private:
+		reference at(size_type idx) noexcept;
+		const_reference at(size_type idx) const noexcept;
+		void make_room() noexcept;
+
+		T* m_data;
+		ring_index<dynamic_capacity> m_index;
+	};
+
+	// Lock-free ring for one producer thread and one consumer thread. Like ring_span it does not own it's storage: the elements of [begin, end) must already be constructed,
+	// and are assigned to by pushes and moved from by pops. Only the producer may call the try_push_back/try_emplace_back functions, and only the consumer try_pop_front.
+	// Each side's index is on it's own cache line along with that side's cached copy of the other side's index, so that the other index is only re-read (and it's cache line
+	// only transferred) when the cached copy shows the ring as full or empty.
+	template<typename T>
+	class spsc_ring_span
+	{
+	public:
+		using type = spsc_ring_span<T>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using const_reference = const T&;
+
+		template <class ContiguousIterator>
+		spsc_ring_span(ContiguousIterator begin, ContiguousIterator end) noexcept;
+
+		spsc_ring_span(const spsc_ring_span&) = delete;
+		spsc_ring_span& operator=(const spsc_ring_span&) = delete;
+
+		// Exact when called from the producer or consumer thread with the other side idle, otherwise a snapshot:
+		bool empty() const noexcept;
+		bool full() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		// Producer - these return false, leaving the ring unchanged, when it is full:
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_assignable<T>::value>>
+		bool try_push_back(const value_type& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		bool try_push_back(value_type&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+		template<class... FromType>
+		bool try_emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value);
+
+		// Consumer - this returns false, leaving to_value unchanged, when the ring is empty:
+		bool try_pop_front(value_type& to_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+		// Example implementation
+	private:
+		// Indices run from 0 to twice the capacity, so that a full ring (back index == front index + capacity) can be told apart from an empty one without leaving a slot unused:
+		size_type distance(size_type front_idx, size_type back_idx) const noexcept;
+		size_type slot(size_type idx) const noexcept;
+		size_type next(size_type idx) const noexcept;
+		template<class Assign>
+		bool push(Assign&& assign);
+
+		T* const m_data;
+		const size_type m_capacity;
+		alignas(64) std::atomic<size_type> m_back_idx; // Written by the producer
+		size_type m_front_idx_cache; // Producer's copy of m_front_idx
+		alignas(64) std::atomic<size_type> m_front_idx; // Written by the consumer
+		size_type m_back_idx_cache; // Consumer's copy of m_back_idx - the class's 64-byte alignment pads this line out, keeping whatever follows the ring off it
+	};
+
+	// Lock-free bounded queue for any number of producer and consumer threads (D. Vyukov's bounded MPMC queue). Each slot carries a sequence number, telling producers whether
+	// the slot is free for their position and consumers whether it has been filled for theirs, so that a producer or consumer claims a position with a single compare-exchange
+	// and then works on it's slot without contending with the others. The caller provides the storage as an array of slot_type, whose values must be constructed, as they are
+	// assigned to by pushes and moved from by pops. Assignment must not throw, as a claimed slot cannot be given back. The batched functions claim a run of positions with one
+	// compare-exchange, so that producers and consumers moving several elements at a time contend once per batch rather than once per element.
+	template<typename T>
+	class mpmc_ring_span
+	{
+	public:
+		using type = mpmc_ring_span<T>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using const_reference = const T&;
+
+		struct slot_type
+		{
+			std::atomic<std::uint64_t> sequence;
+			T value;
+		};
+
+		static_assert(std::is_nothrow_move_assignable<T>::value, "mpmc_ring_span requires a nothrow move-assignable T");
+
+		// [begin, end) is a range of slot_type - their sequence numbers are set by the constructor:
+		template <class ContiguousIterator>
+		mpmc_ring_span(ContiguousIterator begin, ContiguousIterator end) noexcept;
+
+		mpmc_ring_span(const mpmc_ring_span&) = delete;
+		mpmc_ring_span& operator=(const mpmc_ring_span&) = delete;
+
+		// Snapshots while other threads are pushing or popping - a size of n does not guarantee that n pops will succeed, as pushes may have claimed positions they have not yet filled:
+		bool empty() const noexcept;
+		size_type size() const noexcept;
+		size_type capacity() const noexcept;
+
+		// These return false, leaving the queue unchanged, when it is full or empty. emplace constructs it's element before claiming a slot, so may throw:
+		template<bool b = true, typename = std::enable_if_t<b && std::is_nothrow_copy_assignable<T>::value>>
+		bool try_push(const value_type& from_value) noexcept;
+		bool try_push(value_type&& from_value) noexcept;
+		template<class... FromType>
+		bool try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value);
+		bool try_pop(value_type& to_value) noexcept;
+
+		// Batched - push as many elements from the front of [first, last), or pop as many (up to max_count) to out, as are available, returning how many:
+		template <class ForwardIterator>
+		size_type try_push(ForwardIterator first, ForwardIterator last) noexcept;
+		template <class OutputIterator>
+		size_type try_pop(OutputIterator out, size_type max_count) noexcept;
+
+		// Example implementation
+	private:
+		// Positions are free-running, so that a slot's sequence number is unique to the pass being made over it:
+		using index_type = std::uint64_t;
+
+		slot_type& slot(index_type pos) const noexcept;
+		index_type claim_push(size_type max_count, size_type& count) noexcept;
+		index_type claim_pop(size_type max_count, size_type& count) noexcept;
+
+		slot_type* const m_slots;
+		const size_type m_capacity;
+		const size_type m_mask; // capacity - 1 if the capacity is a power of two, so that slot() can mask rather than divide, otherwise 0
+		alignas(64) std::atomic<index_type> m_enqueue_pos;
+		alignas(64) std::atomic<index_type> m_dequeue_pos;
+	};
+
+	// Lock-free ring carrying every element from one producer thread to each of a fixed number of consumers (as in the LMAX Disruptor), so that several subsystems can each
+	// see every element without it being copied into a ring per subsystem. Each consumer, identified by it's index from 0 to consumers() - 1, has it's own cursor, and reads
+	// the elements published since it's last release in place, as at most two contiguous regions, before releasing them. Only the producer may call the try_publish functions,
+	// and each consumer's functions may only be called from one thread at a time. Like spsc_ring_span it does not own it's storage, whose elements are assigned to by publishes.
+	// With full_policy::wait_for_slowest the producer cannot publish over elements that any consumer has yet to release, so try_publish fails while the slowest consumer is
+	// capacity() elements behind. With full_policy::overwrite the producer never waits: a consumer which falls more than capacity() elements behind skips the overwritten ones,
+	// and release() reports when the producer overwrote elements while they were being read, in which case what was read may be torn and must be discarded. Since the producer
+	// can then write elements while they are read, overwrite requires a trivially copyable T.
+	template<typename T>
+	class broadcast_ring_span
+	{
+	public:
+		using type = broadcast_ring_span<T>;
+		using size_type = std::size_t;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+
+		enum class full_policy { wait_for_slowest, overwrite };
+
+		template <class ContiguousIterator>
+		broadcast_ring_span(ContiguousIterator begin, ContiguousIterator end, size_type consumers, full_policy policy = full_policy::wait_for_slowest);
+
+		broadcast_ring_span(const broadcast_ring_span&) = delete;
+		broadcast_ring_span& operator=(const broadcast_ring_span&) = delete;
+
+		size_type capacity() const noexcept { return m_capacity; }
+		size_type consumers() const noexcept { return m_consumer_count; }
+		full_policy policy() const noexcept { return m_policy; }
+
+		// Producer - these publish as many elements as there is room for (all of them with full_policy::overwrite), returning false or the number published:
+		template<bool b = true, typename = std::enable_if_t<b && std::is_copy_assignable<T>::value>>
+		bool try_publish(const value_type& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value);
+		template<bool b = true, typename = std::enable_if_t<b && std::is_move_assignable<T>::value>>
+		bool try_publish(value_type&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value);
+		template<class ForwardIterator>
+		size_type try_publish(ForwardIterator first, ForwardIterator last);
+
+		// Consumer - the elements published and not yet released by this consumer, oldest first. With full_policy::overwrite any already overwritten are skipped first:
+		std::array<std::pair<const_pointer, size_type>, 2> available(size_type consumer) noexcept;
+		size_type size(size_type consumer) const noexcept;
+
+		// Consumer - releases the first n available elements for the producer to reuse. Returns false with full_policy::overwrite if any of them were overwritten since available():
+		bool release(size_type consumer, size_type n) noexcept;
+
+		// Consumer - the number of elements skipped or discarded by this consumer because they were overwritten:
+		std::uint64_t lost(size_type consumer) const noexcept;
+
+		// Example implementation
+	private:
+		using sequence_type = std::uint64_t;
+
+		// Each cursor is aligned to (and so fills) a cache line, so that consumers releasing elements do not contend with one another:
+		struct alignas(64) cursor_type
+		{
+			std::atomic<sequence_type> position; // Elements released, written by the consumer and read by the producer
+			sequence_type lost; // Only touched by the consumer
+		};
+
+		// new[] ignores over-alignment prior to C++17, so the cursors are placed in storage from ::operator new, rounded up to their alignment:
+		struct cursor_storage_deleter
+		{
+			void operator()(void* storage) const noexcept { ::operator delete(storage); }
+		};
+
+		static cursor_type* align_cursors(void* storage) noexcept;
+		size_type slot(sequence_type sequence) const noexcept;
+		size_type room(sequence_type next, size_type wanted) noexcept;
+		void claim(sequence_type next, size_type count) noexcept;
+
+		// Sequences are free-running. With full_policy::overwrite the producer advances m_claimed past the elements it is about to write before writing them,
+		// so that a consumer reading m_claimed after it's reads can tell if any of them may have been overwritten:
+		T* const m_data;
+		const size_type m_capacity;
+		const size_type m_mask; // capacity - 1 if the capacity is a power of two, so that slot() can mask rather than divide, otherwise 0
+		const size_type m_consumer_count;
+		const full_policy m_policy;
+		std::unique_ptr<void, cursor_storage_deleter> m_cursor_storage;
+		cursor_type* const m_cursors; // Within m_cursor_storage
+		alignas(64) std::atomic<sequence_type> m_published; // Written by the producer
+		std::atomic<sequence_type> m_claimed; // Written by the producer, with full_policy::overwrite
+		sequence_type m_next; // Producer's copy of m_published
+		sequence_type m_slowest_cache; // Producer's copy of the lowest consumer cursor
+	};
 }
 
 // Sample implementation
@@ -162,66 +708,229 @@ T sg14::copy_popper<T>::operator()(T& t)
 	return t;
 }
 
-template<typename T, class Popper>
-template<class ContiguousIterator>
-sg14::ring_span<T, Popper>::ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
-	: m_data(&*begin)
-	, m_size(0)
-	, m_capacity(end - begin)
+template<class Capacity>
+sg14::ring_index<Capacity>::ring_index() noexcept
+	: Capacity()
 	, m_front_idx(0)
-	, m_popper(std::move(p))
+	, m_size(0)
 {}
 
-template<typename T, class Popper>
-template<class ContiguousIterator>
-sg14::ring_span<T, Popper>::ring_span(ContiguousIterator begin, ContiguousIterator end, ContiguousIterator first, size_type size, Popper p) noexcept
-	: m_data(&*begin)
+template<class Capacity>
+sg14::ring_index<Capacity>::ring_index(size_type capacity, size_type front_offset, size_type size) noexcept
+	: Capacity(capacity)
+	, m_front_idx(front_offset)
 	, m_size(size)
-	, m_capacity(end - begin)
-	, m_front_idx(first - begin)
-	, m_popper(std::move(p))
-{}
+{
+	assert(size <= this->capacity() && (front_offset < this->capacity() || front_offset == 0));
+}
 
-template<typename T, class Popper>
-bool sg14::ring_span<T, Popper>::empty() const noexcept
+template<class Capacity>
+bool sg14::ring_index<Capacity>::empty() const noexcept
 {
 	return m_size == 0;
 }
 
-template<typename T, class Popper>
-bool sg14::ring_span<T, Popper>::full() const noexcept
+template<class Capacity>
+bool sg14::ring_index<Capacity>::full() const noexcept
 {
-	return m_size == m_capacity;
+	return m_size == capacity();
 }
 
-template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::size_type sg14::ring_span<T, Popper>::size() const noexcept
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::size() const noexcept
 {
 	return m_size;
 }
 
-template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::size_type sg14::ring_span<T, Popper>::capacity() const noexcept
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::front_idx() const noexcept
 {
-	return m_capacity;
+	return m_front_idx;
 }
 
-template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::front() noexcept
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::end_idx() const noexcept
 {
-	return *begin();
+	return m_front_idx + m_size;
 }
 
-template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::back() noexcept
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::wrap(size_type idx) const noexcept
 {
-	return *(--end());
+	if (this->masked())
+	{
+		return idx & this->mask();
+	}
+
+	assert(idx < capacity() * 2);
+	return (idx < capacity()) ? idx : idx - capacity();
 }
 
-template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::const_reference sg14::ring_span<T, Popper>::front() const noexcept
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::back_offset() const noexcept
 {
-	return *begin();
+	return wrap(m_front_idx + m_size);
+}
+
+template<class Capacity>
+typename sg14::ring_index<Capacity>::runs_type sg14::ring_index<Capacity>::runs(size_type distance, size_type n) const noexcept
+{
+	assert(n <= capacity());
+
+	// advance() leaves an unmasked index below the capacity already, so that an empty placeholder ring (capacity 0) gets two empty runs rather than failing wrap()'s assertion:
+	const size_type start = this->masked() ? (advance(m_front_idx, distance) & this->mask()) : advance(m_front_idx, distance);
+	const size_type first_run = (n < capacity() - start) ? n : capacity() - start;
+	return {{ std::make_pair(start, first_run), std::make_pair(size_type(0), n - first_run) }};
+}
+
+template<class Capacity>
+void sg14::ring_index<Capacity>::push() noexcept
+{
+	// Storing only the member which changes - storing both when full lets the compiler merge the stores into one wider store, which the next push's loads cannot forward from:
+	if (m_size != capacity())
+	{
+		++m_size;
+	}
+	else
+	{
+		m_front_idx = next(m_front_idx);
+	}
+}
+
+template<class Capacity>
+void sg14::ring_index<Capacity>::push(size_type n) noexcept
+{
+	const size_type new_size = (n < capacity() - m_size) ? m_size + n : capacity();
+	m_front_idx = advance(m_front_idx, n - (new_size - m_size));
+	m_size = new_size;
+}
+
+template<class Capacity>
+void sg14::ring_index<Capacity>::grow(size_type n) noexcept
+{
+	assert(n <= capacity() - m_size);
+	m_size += n;
+}
+
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::pop() noexcept
+{
+	assert(m_size != 0);
+	const size_type front_offset = wrap(m_front_idx);
+	m_front_idx = next(m_front_idx);
+	--m_size;
+	return front_offset;
+}
+
+template<class Capacity>
+void sg14::ring_index<Capacity>::pop(size_type n) noexcept
+{
+	assert(n <= m_size);
+	m_front_idx = advance(m_front_idx, n);
+	m_size -= n;
+}
+
+template<class Capacity>
+void sg14::ring_index<Capacity>::swap(ring_index& rhs) noexcept
+{
+	using std::swap;
+	Capacity::swap(rhs);
+	swap(m_front_idx, rhs.m_front_idx);
+	swap(m_size, rhs.m_size);
+}
+
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::next(size_type idx) const noexcept
+{
+	if (this->masked())
+	{
+		return idx + 1;
+	}
+
+	return (++idx != capacity()) ? idx : 0;
+}
+
+// Moves an index (below the capacity, unless masked) n places on, keeping it below the capacity unless masked:
+template<class Capacity>
+typename sg14::ring_index<Capacity>::size_type sg14::ring_index<Capacity>::advance(size_type idx, size_type n) const noexcept
+{
+	if (this->masked())
+	{
+		return idx + n;
+	}
+
+	if (n >= capacity() && capacity() != 0)
+	{
+		n %= capacity();
+	}
+
+	idx += n;
+	return (idx < capacity()) ? idx : idx - capacity();
+}
+
+template<typename T, class Popper>
+sg14::ring_span<T, Popper>::ring_span() noexcept
+	: m_data(nullptr)
+	, m_index()
+	, m_popper()
+{}
+
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::ring_span<T, Popper>::ring_span(ContiguousIterator begin, ContiguousIterator end, Popper p) noexcept
+	: m_data(&*begin)
+	, m_index(end - begin, 0, 0)
+	, m_popper(std::move(p))
+{}
+
+template<typename T, class Popper>
+template<class ContiguousIterator>
+sg14::ring_span<T, Popper>::ring_span(ContiguousIterator begin, ContiguousIterator end, ContiguousIterator first, size_type size, Popper p) noexcept
+	: m_data(&*begin)
+	, m_index(end - begin, first - begin, size)
+	, m_popper(std::move(p))
+{}
+
+template<typename T, class Popper>
+bool sg14::ring_span<T, Popper>::empty() const noexcept
+{
+	return m_index.empty();
+}
+
+template<typename T, class Popper>
+bool sg14::ring_span<T, Popper>::full() const noexcept
+{
+	return m_index.full();
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::size_type sg14::ring_span<T, Popper>::size() const noexcept
+{
+	return m_index.size();
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::size_type sg14::ring_span<T, Popper>::capacity() const noexcept
+{
+	return m_index.capacity();
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::front() noexcept
+{
+	return *begin();
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::back() noexcept
+{
+	return *(--end());
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::const_reference sg14::ring_span<T, Popper>::front() const noexcept
+{
+	return *begin();
 }
 
 template<typename T, class Popper>
@@ -233,112 +942,171 @@ typename sg14::ring_span<T, Popper>::const_reference sg14::ring_span<T, Popper>:
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::iterator sg14::ring_span<T, Popper>::begin() noexcept
 {
-	return iterator(m_front_idx, this);
+	return iterator(m_index.front_idx(), this);
 }
 
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::iterator sg14::ring_span<T, Popper>::end() noexcept
 {
-	return iterator(size() + m_front_idx, this);
+	return iterator(m_index.end_idx(), this);
 }
 
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::const_iterator sg14::ring_span<T, Popper>::begin() const noexcept
 {
-	return const_iterator(m_front_idx, this);
+	return const_iterator(m_index.front_idx(), this);
 }
 
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::const_iterator sg14::ring_span<T, Popper>::cbegin() const noexcept
 {
-	return const_iterator(m_front_idx, this);
+	return const_iterator(m_index.front_idx(), this);
 }
 
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::const_iterator sg14::ring_span<T, Popper>::end() const noexcept
 {
-	return const_iterator(size() + m_front_idx, this);
+	return const_iterator(m_index.end_idx(), this);
 }
 
 template<typename T, class Popper>
 typename sg14::ring_span<T, Popper>::const_iterator sg14::ring_span<T, Popper>::cend() const noexcept
 {
-	return const_iterator(size() + m_front_idx, this);
+	return const_iterator(m_index.end_idx(), this);
 }
 
 template<typename T, class Popper>
 template<bool b, typename>
 void sg14::ring_span<T, Popper>::push_back(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value)
 {
-	m_data[back_idx()] = value;
-	increase_size();
+	m_data[m_index.back_offset()] = value;
+	m_index.push();
 }
 
 template<typename T, class Popper>
 template<bool b, typename>
 void sg14::ring_span<T, Popper>::push_back(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value)
 {
-	m_data[back_idx()] = std::move(value);
-	increase_size();
+	m_data[m_index.back_offset()] = std::move(value);
+	m_index.push();
 }
 
 template<typename T, class Popper>
 template<class... FromType>
 void sg14::ring_span<T, Popper>::emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value)
 {
-	m_data[back_idx()] = T(std::forward<FromType>(from_value)...);
-	increase_size();
+	m_data[m_index.back_offset()] = T(std::forward<FromType>(from_value)...);
+	m_index.push();
 }
 
 template<typename T, class Popper>
 auto sg14::ring_span<T, Popper>::pop_front()
 {
-	assert(m_size != 0);
-	auto old_front_idx = m_front_idx;
-	m_front_idx = (m_front_idx + 1) % m_capacity;
-	--m_size;
-	return m_popper(m_data[old_front_idx]);
+	return m_popper(m_data[m_index.pop()]);
 }
 
 template<typename T, class Popper>
-void sg14::ring_span<T, Popper>::swap(sg14::ring_span<T, Popper>& rhs) noexcept//(std::is_nothrow_swappable<Popper>::value)
+template<class ForwardIterator>
+void sg14::ring_span<T, Popper>::push_back(ForwardIterator first, ForwardIterator last)
 {
-	using std::swap;
-	swap(m_data, rhs.m_data);
-	swap(m_size, rhs.m_size);
-	swap(m_capacity, rhs.m_capacity);
-	swap(m_front_idx, rhs.m_front_idx);
-	swap(m_popper, rhs.m_popper);
+	const size_type count = static_cast<size_type>(std::distance(first, last));
+
+	// Of more than capacity() elements only the last capacity() would survive, and the first of those would be written where the skipped elements left off:
+	const size_type skipped = (count > capacity()) ? count - capacity() : 0;
+	std::advance(first, skipped);
+
+	const auto runs = m_index.runs(m_index.size() + skipped, count - skipped);
+	std::copy_n(first, runs[0].second, m_data + runs[0].first);
+	std::advance(first, runs[0].second);
+	std::copy_n(first, runs[1].second, m_data + runs[1].first);
+	m_index.push(count);
 }
 
 template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::at(size_type i) noexcept
+template<class OutputIterator>
+OutputIterator sg14::ring_span<T, Popper>::pop_front_n(size_type n, OutputIterator out)
 {
-	return m_data[i % m_capacity];
+	assert(n <= size());
+	return pop_front_n(n, out, std::is_same<Popper, default_popper<T>>());
 }
 
 template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::const_reference sg14::ring_span<T, Popper>::at(size_type i) const noexcept
+template<class OutputIterator>
+OutputIterator sg14::ring_span<T, Popper>::pop_front_n(size_type n, OutputIterator out, std::true_type)
 {
-	return m_data[i % m_capacity];
+	const auto runs = m_index.runs(0, n);
+	out = std::move(m_data + runs[0].first, m_data + runs[0].first + runs[0].second, out);
+	out = std::move(m_data + runs[1].first, m_data + runs[1].first + runs[1].second, out);
+	m_index.pop(n);
+	return out;
 }
 
 template<typename T, class Popper>
-typename sg14::ring_span<T, Popper>::size_type sg14::ring_span<T, Popper>::back_idx() const noexcept
+template<class OutputIterator>
+OutputIterator sg14::ring_span<T, Popper>::pop_front_n(size_type n, OutputIterator out, std::false_type)
 {
-	return (m_front_idx + m_size) % m_capacity;
+	for (; n != 0; --n, ++out)
+	{
+		*out = pop_front();
+	}
+
+	return out;
 }
 
 template<typename T, class Popper>
-void sg14::ring_span<T, Popper>::increase_size() noexcept
+void sg14::ring_span<T, Popper>::pop_front_n(size_type n)
 {
-	if (++m_size > m_capacity)
+	assert(n <= size());
+
+	if (std::is_same<Popper, default_popper<T>>::value)
+	{
+		// Moving the elements out would leave them valid but unspecified - leaving them as they are is equally so:
+		m_index.pop(n);
+	}
+	else
 	{
-		m_size = m_capacity;
-		m_front_idx = (m_front_idx + 1) % m_capacity;
+		for (; n != 0; --n)
+		{
+			pop_front();
+		}
 	}
 }
 
+template<typename T, class Popper>
+std::array<std::pair<typename sg14::ring_span<T, Popper>::pointer, typename sg14::ring_span<T, Popper>::size_type>, 2> sg14::ring_span<T, Popper>::contiguous_regions() noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(m_data + runs[0].first, runs[0].second), std::make_pair(m_data + runs[1].first, runs[1].second) }};
+}
+
+template<typename T, class Popper>
+std::array<std::pair<typename sg14::ring_span<T, Popper>::const_pointer, typename sg14::ring_span<T, Popper>::size_type>, 2> sg14::ring_span<T, Popper>::contiguous_regions() const noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(static_cast<const_pointer>(m_data + runs[0].first), runs[0].second), std::make_pair(static_cast<const_pointer>(m_data + runs[1].first), runs[1].second) }};
+}
+
+template<typename T, class Popper>
+void sg14::ring_span<T, Popper>::swap(sg14::ring_span<T, Popper>& rhs) noexcept//(std::is_nothrow_swappable<Popper>::value)
+{
+	using std::swap;
+	swap(m_data, rhs.m_data);
+	m_index.swap(rhs.m_index);
+	swap(m_popper, rhs.m_popper);
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::reference sg14::ring_span<T, Popper>::at(size_type i) noexcept
+{
+	return m_data[m_index.wrap(i)];
+}
+
+template<typename T, class Popper>
+typename sg14::ring_span<T, Popper>::const_reference sg14::ring_span<T, Popper>::at(size_type i) const noexcept
+{
+	return m_data[m_index.wrap(i)];
+}
+
 template <typename Ring, bool is_const>
 template<bool C>
 bool sg14::ring_iterator<Ring, is_const>::operator==(const sg14::ring_iterator<Ring, C>& rhs) const noexcept
@@ -450,3 +1218,1257 @@ sg14::ring_iterator<Ring, is_const> operator-(sg14::ring_iterator<Ring, is_const
 	it -= i;
 	return it;
 }
+
+template<typename T, std::size_t N, class Popper>
+sg14::static_ring<T, N, Popper>::static_ring(Popper p) noexcept(std::is_nothrow_default_constructible<T>::value && std::is_nothrow_move_constructible<Popper>::value)
+	: m_data()
+	, m_index()
+	, m_popper(std::move(p))
+{}
+
+template<typename T, std::size_t N, class Popper>
+bool sg14::static_ring<T, N, Popper>::empty() const noexcept
+{
+	return m_index.empty();
+}
+
+template<typename T, std::size_t N, class Popper>
+bool sg14::static_ring<T, N, Popper>::full() const noexcept
+{
+	return m_index.full();
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::size_type sg14::static_ring<T, N, Popper>::size() const noexcept
+{
+	return m_index.size();
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::reference sg14::static_ring<T, N, Popper>::front() noexcept
+{
+	return *begin();
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::reference sg14::static_ring<T, N, Popper>::back() noexcept
+{
+	return *(--end());
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_reference sg14::static_ring<T, N, Popper>::front() const noexcept
+{
+	return *begin();
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_reference sg14::static_ring<T, N, Popper>::back() const noexcept
+{
+	return *(--end());
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::iterator sg14::static_ring<T, N, Popper>::begin() noexcept
+{
+	return iterator(m_index.front_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::iterator sg14::static_ring<T, N, Popper>::end() noexcept
+{
+	return iterator(m_index.end_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_iterator sg14::static_ring<T, N, Popper>::begin() const noexcept
+{
+	return const_iterator(m_index.front_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_iterator sg14::static_ring<T, N, Popper>::cbegin() const noexcept
+{
+	return const_iterator(m_index.front_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_iterator sg14::static_ring<T, N, Popper>::end() const noexcept
+{
+	return const_iterator(m_index.end_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_iterator sg14::static_ring<T, N, Popper>::cend() const noexcept
+{
+	return const_iterator(m_index.end_idx(), this);
+}
+
+template<typename T, std::size_t N, class Popper>
+template<bool b, typename>
+void sg14::static_ring<T, N, Popper>::push_back(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value)
+{
+	m_data[m_index.back_offset()] = value;
+	m_index.push();
+}
+
+template<typename T, std::size_t N, class Popper>
+template<bool b, typename>
+void sg14::static_ring<T, N, Popper>::push_back(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	m_data[m_index.back_offset()] = std::move(value);
+	m_index.push();
+}
+
+template<typename T, std::size_t N, class Popper>
+template<class... FromType>
+void sg14::static_ring<T, N, Popper>::emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value)
+{
+	m_data[m_index.back_offset()] = T(std::forward<FromType>(from_value)...);
+	m_index.push();
+}
+
+template<typename T, std::size_t N, class Popper>
+auto sg14::static_ring<T, N, Popper>::pop_front()
+{
+	return m_popper(m_data[m_index.pop()]);
+}
+
+template<typename T, std::size_t N, class Popper>
+template<class ForwardIterator>
+void sg14::static_ring<T, N, Popper>::push_back(ForwardIterator first, ForwardIterator last)
+{
+	const size_type count = static_cast<size_type>(std::distance(first, last));
+
+	const size_type skipped = (count > capacity()) ? count - capacity() : 0;
+	std::advance(first, skipped);
+
+	const auto runs = m_index.runs(m_index.size() + skipped, count - skipped);
+	std::copy_n(first, runs[0].second, m_data.data() + runs[0].first);
+	std::advance(first, runs[0].second);
+	std::copy_n(first, runs[1].second, m_data.data() + runs[1].first);
+	m_index.push(count);
+}
+
+template<typename T, std::size_t N, class Popper>
+template<class OutputIterator>
+OutputIterator sg14::static_ring<T, N, Popper>::pop_front_n(size_type n, OutputIterator out)
+{
+	assert(n <= size());
+	return pop_front_n(n, out, std::is_same<Popper, default_popper<T>>());
+}
+
+template<typename T, std::size_t N, class Popper>
+template<class OutputIterator>
+OutputIterator sg14::static_ring<T, N, Popper>::pop_front_n(size_type n, OutputIterator out, std::true_type)
+{
+	const auto runs = m_index.runs(0, n);
+	out = std::move(m_data.data() + runs[0].first, m_data.data() + runs[0].first + runs[0].second, out);
+	out = std::move(m_data.data() + runs[1].first, m_data.data() + runs[1].first + runs[1].second, out);
+	m_index.pop(n);
+	return out;
+}
+
+template<typename T, std::size_t N, class Popper>
+template<class OutputIterator>
+OutputIterator sg14::static_ring<T, N, Popper>::pop_front_n(size_type n, OutputIterator out, std::false_type)
+{
+	for (; n != 0; --n, ++out)
+	{
+		*out = pop_front();
+	}
+
+	return out;
+}
+
+template<typename T, std::size_t N, class Popper>
+void sg14::static_ring<T, N, Popper>::pop_front_n(size_type n)
+{
+	assert(n <= size());
+
+	if (std::is_same<Popper, default_popper<T>>::value)
+	{
+		m_index.pop(n);
+	}
+	else
+	{
+		for (; n != 0; --n)
+		{
+			pop_front();
+		}
+	}
+}
+
+template<typename T, std::size_t N, class Popper>
+std::array<std::pair<typename sg14::static_ring<T, N, Popper>::pointer, typename sg14::static_ring<T, N, Popper>::size_type>, 2> sg14::static_ring<T, N, Popper>::contiguous_regions() noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(m_data.data() + runs[0].first, runs[0].second), std::make_pair(m_data.data() + runs[1].first, runs[1].second) }};
+}
+
+template<typename T, std::size_t N, class Popper>
+std::array<std::pair<typename sg14::static_ring<T, N, Popper>::const_pointer, typename sg14::static_ring<T, N, Popper>::size_type>, 2> sg14::static_ring<T, N, Popper>::contiguous_regions() const noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(static_cast<const_pointer>(m_data.data() + runs[0].first), runs[0].second), std::make_pair(static_cast<const_pointer>(m_data.data() + runs[1].first), runs[1].second) }};
+}
+
+template<typename T, std::size_t N, class Popper>
+void sg14::static_ring<T, N, Popper>::swap(type& rhs) noexcept(noexcept(std::declval<std::array<T, N>&>().swap(std::declval<std::array<T, N>&>())))
+{
+	using std::swap;
+	m_data.swap(rhs.m_data);
+	m_index.swap(rhs.m_index);
+	swap(m_popper, rhs.m_popper);
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::reference sg14::static_ring<T, N, Popper>::at(size_type idx) noexcept
+{
+	return m_data[m_index.wrap(idx)];
+}
+
+template<typename T, std::size_t N, class Popper>
+typename sg14::static_ring<T, N, Popper>::const_reference sg14::static_ring<T, N, Popper>::at(size_type idx) const noexcept
+{
+	return m_data[m_index.wrap(idx)];
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>::dynamic_ring(size_type capacity, full_policy policy, const Alloc& alloc, Popper p)
+	: m_allocator(alloc)
+	, m_storage(nullptr)
+	, m_capacity(0)
+	, m_policy(policy)
+	, m_popper(std::move(p))
+	, m_span()
+{
+	assert(capacity != 0);
+	reallocate(capacity, m_span);
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>::dynamic_ring(const dynamic_ring& source)
+	: m_allocator(allocator_traits::select_on_container_copy_construction(source.m_allocator))
+	, m_storage(nullptr)
+	, m_capacity(0)
+	, m_policy(source.m_policy)
+	, m_popper(source.m_popper)
+	, m_span()
+{
+	reallocate(source.m_capacity, source.m_span);
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>::dynamic_ring(dynamic_ring&& source) noexcept
+	: m_allocator(std::move(source.m_allocator))
+	, m_storage(source.m_storage)
+	, m_capacity(source.m_capacity)
+	, m_policy(source.m_policy)
+	, m_popper(std::move(source.m_popper))
+	, m_span(std::move(source.m_span))
+{
+	source.m_storage = nullptr;
+	source.m_capacity = 0;
+	source.m_span = span_type();
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>& sg14::dynamic_ring<T, Alloc, Popper>::operator=(const dynamic_ring& source)
+{
+	if (this != &source)
+	{
+		dynamic_ring copy(source);
+		swap(copy);
+	}
+
+	return *this;
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>& sg14::dynamic_ring<T, Alloc, Popper>::operator=(dynamic_ring&& source) noexcept
+{
+	if (this != &source)
+	{
+		dynamic_ring moved(std::move(source));
+		swap(moved);
+	}
+
+	return *this;
+}
+
+template<typename T, class Alloc, class Popper>
+sg14::dynamic_ring<T, Alloc, Popper>::~dynamic_ring()
+{
+	destroy_storage();
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::push_back(const T& value)
+{
+	if (m_span.full() && m_policy == full_policy::grow)
+	{
+		T copy(value); // value may be one of the elements about to be moved
+		make_room(1);
+		m_span.push_back(std::move(copy));
+	}
+	else
+	{
+		m_span.push_back(value);
+	}
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::push_back(T&& value)
+{
+	if (m_span.full() && m_policy == full_policy::grow)
+	{
+		T moved(std::move(value));
+		make_room(1);
+		m_span.push_back(std::move(moved));
+	}
+	else
+	{
+		m_span.push_back(std::move(value));
+	}
+}
+
+template<typename T, class Alloc, class Popper>
+template<class... FromType>
+void sg14::dynamic_ring<T, Alloc, Popper>::emplace_back(FromType&&... from_value)
+{
+	if (m_span.full() && m_policy == full_policy::grow)
+	{
+		T constructed(std::forward<FromType>(from_value)...);
+		make_room(1);
+		m_span.push_back(std::move(constructed));
+	}
+	else
+	{
+		m_span.emplace_back(std::forward<FromType>(from_value)...);
+	}
+}
+
+template<typename T, class Alloc, class Popper>
+template<class ForwardIterator>
+void sg14::dynamic_ring<T, Alloc, Popper>::push_back(ForwardIterator first, ForwardIterator last)
+{
+	if (m_policy == full_policy::grow)
+	{
+		make_room(static_cast<size_type>(std::distance(first, last)));
+	}
+
+	m_span.push_back(first, last);
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::reserve(size_type new_capacity)
+{
+	if (new_capacity > m_capacity)
+	{
+		reallocate(new_capacity, m_span);
+	}
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::swap(type& rhs) noexcept
+{
+	using std::swap;
+	swap(m_allocator, rhs.m_allocator);
+	swap(m_storage, rhs.m_storage);
+	swap(m_capacity, rhs.m_capacity);
+	swap(m_policy, rhs.m_policy);
+	swap(m_popper, rhs.m_popper);
+	m_span.swap(rhs.m_span);
+}
+
+// Makes a new allocation holding source's elements (moved if source is this ring's span and they can be moved without throwing, otherwise copied) at it's start,
+// followed by value-initialised elements, then replaces the current allocation with it:
+template<typename T, class Alloc, class Popper>
+template<class SourceSpan>
+void sg14::dynamic_ring<T, Alloc, Popper>::reallocate(size_type new_capacity, SourceSpan& source)
+{
+	T* const new_storage = allocator_traits::allocate(m_allocator, new_capacity);
+	const size_type size = source.size();
+	size_type constructed = 0;
+
+	try
+	{
+		if (size != 0) // The span of a new or moved-from ring has no storage to find regions in
+		{
+			for (const auto& region : source.contiguous_regions())
+			{
+				for (size_type i = 0; i != region.second; ++i, ++constructed)
+				{
+					allocator_traits::construct(m_allocator, new_storage + constructed, std::move_if_noexcept(region.first[i]));
+				}
+			}
+		}
+
+		for (; constructed != new_capacity; ++constructed)
+		{
+			allocator_traits::construct(m_allocator, new_storage + constructed);
+		}
+	}
+	catch (...)
+	{
+		while (constructed != 0)
+		{
+			allocator_traits::destroy(m_allocator, new_storage + --constructed);
+		}
+
+		allocator_traits::deallocate(m_allocator, new_storage, new_capacity);
+		throw;
+	}
+
+	destroy_storage();
+	m_storage = new_storage;
+	m_capacity = new_capacity;
+	m_span = span_type(new_storage, new_storage + new_capacity, new_storage, size, m_popper);
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::make_room(size_type count)
+{
+	const size_type needed = m_span.size() + count;
+
+	if (needed > m_capacity)
+	{
+		size_type new_capacity = (m_capacity != 0) ? m_capacity * 2 : 1; // A moved-from ring has no capacity
+
+		while (new_capacity < needed)
+		{
+			new_capacity *= 2;
+		}
+
+		reserve(new_capacity);
+	}
+}
+
+template<typename T, class Alloc, class Popper>
+void sg14::dynamic_ring<T, Alloc, Popper>::destroy_storage() noexcept
+{
+	if (m_storage != nullptr)
+	{
+		for (size_type i = 0; i != m_capacity; ++i)
+		{
+			allocator_traits::destroy(m_allocator, m_storage + i);
+		}
+
+		allocator_traits::deallocate(m_allocator, m_storage, m_capacity);
+		m_storage = nullptr;
+		m_capacity = 0;
+	}
+}
+
+template<typename T>
+sg14::uninitialized_ring_span<T>::uninitialized_ring_span(void* storage, size_type capacity) noexcept
+	: m_data(static_cast<T*>(storage))
+	, m_index(capacity, 0, 0)
+{
+	assert(reinterpret_cast<std::uintptr_t>(storage) % alignof(T) == 0);
+}
+
+template<typename T>
+sg14::uninitialized_ring_span<T>::uninitialized_ring_span() noexcept
+	: m_data(nullptr)
+	, m_index()
+{}
+
+template<typename T>
+sg14::uninitialized_ring_span<T>::uninitialized_ring_span(uninitialized_ring_span&& source) noexcept
+	: uninitialized_ring_span()
+{
+	swap(source);
+}
+
+template<typename T>
+sg14::uninitialized_ring_span<T>& sg14::uninitialized_ring_span<T>::operator=(uninitialized_ring_span&& source) noexcept
+{
+	if (this != &source)
+	{
+		clear();
+		swap(source); // Leaving source empty, over this ring's old storage
+	}
+
+	return *this;
+}
+
+template<typename T>
+sg14::uninitialized_ring_span<T>::~uninitialized_ring_span()
+{
+	clear();
+}
+
+template<typename T>
+bool sg14::uninitialized_ring_span<T>::empty() const noexcept
+{
+	return m_index.empty();
+}
+
+template<typename T>
+bool sg14::uninitialized_ring_span<T>::full() const noexcept
+{
+	return m_index.full();
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::size_type sg14::uninitialized_ring_span<T>::size() const noexcept
+{
+	return m_index.size();
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::size_type sg14::uninitialized_ring_span<T>::capacity() const noexcept
+{
+	return m_index.capacity();
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::reference sg14::uninitialized_ring_span<T>::front() noexcept
+{
+	return at(m_index.front_idx());
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_reference sg14::uninitialized_ring_span<T>::front() const noexcept
+{
+	return at(m_index.front_idx());
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::reference sg14::uninitialized_ring_span<T>::back() noexcept
+{
+	return at(m_index.end_idx() - 1);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_reference sg14::uninitialized_ring_span<T>::back() const noexcept
+{
+	return at(m_index.end_idx() - 1);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::iterator sg14::uninitialized_ring_span<T>::begin() noexcept
+{
+	return iterator(m_index.front_idx(), this);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_iterator sg14::uninitialized_ring_span<T>::begin() const noexcept
+{
+	return const_iterator(m_index.front_idx(), this);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_iterator sg14::uninitialized_ring_span<T>::cbegin() const noexcept
+{
+	return const_iterator(m_index.front_idx(), this);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::iterator sg14::uninitialized_ring_span<T>::end() noexcept
+{
+	return iterator(m_index.end_idx(), this);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_iterator sg14::uninitialized_ring_span<T>::end() const noexcept
+{
+	return const_iterator(m_index.end_idx(), this);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_iterator sg14::uninitialized_ring_span<T>::cend() const noexcept
+{
+	return const_iterator(m_index.end_idx(), this);
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::push_back(const T& from_value) noexcept(std::is_nothrow_copy_constructible<T>::value)
+{
+	emplace_back(from_value);
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::push_back(T&& from_value) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+	emplace_back(std::move(from_value));
+}
+
+template<typename T>
+template<class... FromType>
+void sg14::uninitialized_ring_span<T>::emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value)
+{
+	make_room();
+	::new (static_cast<void*>(m_data + m_index.back_offset())) T(std::forward<FromType>(from_value)...);
+	m_index.grow(1);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::value_type sg14::uninitialized_ring_span<T>::pop_front()
+{
+	assert(!empty());
+	T& old_front = front();
+	T result(std::move(old_front));
+	old_front.~T();
+	m_index.pop();
+	return result;
+}
+
+template<typename T>
+template<class ForwardIterator>
+void sg14::uninitialized_ring_span<T>::push_back(ForwardIterator first, ForwardIterator last)
+{
+	const size_type count = static_cast<size_type>(std::distance(first, last));
+
+	// Of more than capacity() elements only the last capacity() would survive, so the others are never constructed. Make room for the rest by destroying the oldest elements:
+	const size_type skipped = (count > capacity()) ? count - capacity() : 0;
+	const size_type kept = count - skipped;
+	std::advance(first, skipped);
+
+	if (kept > capacity() - size())
+	{
+		pop_front_n(kept - (capacity() - size()));
+	}
+
+	// Each run is counted into the ring as soon as it is constructed, so that if the second run throws the first is still destroyed with the ring:
+	const auto runs = m_index.runs(size(), kept);
+	std::uninitialized_copy_n(first, runs[0].second, m_data + runs[0].first);
+	std::advance(first, runs[0].second);
+	m_index.grow(runs[0].second);
+	std::uninitialized_copy_n(first, runs[1].second, m_data + runs[1].first);
+	m_index.grow(runs[1].second);
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::extend_back(size_type n)
+{
+	assert(n <= capacity() - size());
+	const auto runs = m_index.runs(size(), n);
+	stdext::uninitialized_default_construct(m_data + runs[0].first, m_data + runs[0].first + runs[0].second);
+	m_index.grow(runs[0].second);
+	stdext::uninitialized_default_construct(m_data + runs[1].first, m_data + runs[1].first + runs[1].second);
+	m_index.grow(runs[1].second);
+}
+
+template<typename T>
+template<class OutputIterator>
+OutputIterator sg14::uninitialized_ring_span<T>::pop_front_n(size_type n, OutputIterator out)
+{
+	assert(n <= size());
+	const auto runs = m_index.runs(0, n);
+	out = std::move(m_data + runs[0].first, m_data + runs[0].first + runs[0].second, out);
+	out = std::move(m_data + runs[1].first, m_data + runs[1].first + runs[1].second, out);
+	pop_front_n(n);
+	return out;
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::pop_front_n(size_type n) noexcept
+{
+	assert(n <= size());
+	const auto runs = m_index.runs(0, n);
+	stdext::destruct(m_data + runs[0].first, m_data + runs[0].first + runs[0].second);
+	stdext::destruct(m_data + runs[1].first, m_data + runs[1].first + runs[1].second);
+	m_index.pop(n);
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::clear() noexcept
+{
+	pop_front_n(size());
+}
+
+template<typename T>
+std::array<std::pair<typename sg14::uninitialized_ring_span<T>::pointer, typename sg14::uninitialized_ring_span<T>::size_type>, 2> sg14::uninitialized_ring_span<T>::contiguous_regions() noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(m_data + runs[0].first, runs[0].second), std::make_pair(m_data + runs[1].first, runs[1].second) }};
+}
+
+template<typename T>
+std::array<std::pair<typename sg14::uninitialized_ring_span<T>::const_pointer, typename sg14::uninitialized_ring_span<T>::size_type>, 2> sg14::uninitialized_ring_span<T>::contiguous_regions() const noexcept
+{
+	const auto runs = m_index.runs(0, size());
+	return {{ std::make_pair(static_cast<const_pointer>(m_data + runs[0].first), runs[0].second), std::make_pair(static_cast<const_pointer>(m_data + runs[1].first), runs[1].second) }};
+}
+
+template<typename T>
+void sg14::uninitialized_ring_span<T>::swap(type& rhs) noexcept
+{
+	using std::swap;
+	swap(m_data, rhs.m_data);
+	m_index.swap(rhs.m_index);
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::reference sg14::uninitialized_ring_span<T>::at(size_type idx) noexcept
+{
+	return m_data[m_index.wrap(idx)];
+}
+
+template<typename T>
+typename sg14::uninitialized_ring_span<T>::const_reference sg14::uninitialized_ring_span<T>::at(size_type idx) const noexcept
+{
+	return m_data[m_index.wrap(idx)];
+}
+
+// Destroys the front element if the ring is full, so that a push can construct into it's slot:
+template<typename T>
+void sg14::uninitialized_ring_span<T>::make_room() noexcept
+{
+	if (full())
+	{
+		assert(capacity() != 0);
+		front().~T();
+		m_index.pop();
+	}
+}
+
+template<typename T>
+template<class ContiguousIterator>
+sg14::spsc_ring_span<T>::spsc_ring_span(ContiguousIterator begin, ContiguousIterator end) noexcept
+	: m_data(&*begin)
+	, m_capacity(end - begin)
+	, m_back_idx(0)
+	, m_front_idx_cache(0)
+	, m_front_idx(0)
+	, m_back_idx_cache(0)
+{
+	assert(m_capacity != 0 && m_capacity <= std::numeric_limits<size_type>::max() / 2);
+}
+
+template<typename T>
+typename sg14::spsc_ring_span<T>::size_type sg14::spsc_ring_span<T>::distance(size_type front_idx, size_type back_idx) const noexcept
+{
+	return (back_idx >= front_idx) ? back_idx - front_idx : back_idx + (m_capacity * 2) - front_idx;
+}
+
+template<typename T>
+typename sg14::spsc_ring_span<T>::size_type sg14::spsc_ring_span<T>::slot(size_type idx) const noexcept
+{
+	return (idx < m_capacity) ? idx : idx - m_capacity;
+}
+
+template<typename T>
+typename sg14::spsc_ring_span<T>::size_type sg14::spsc_ring_span<T>::next(size_type idx) const noexcept
+{
+	return (++idx != m_capacity * 2) ? idx : 0;
+}
+
+template<typename T>
+bool sg14::spsc_ring_span<T>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename T>
+bool sg14::spsc_ring_span<T>::full() const noexcept
+{
+	return size() == m_capacity;
+}
+
+template<typename T>
+typename sg14::spsc_ring_span<T>::size_type sg14::spsc_ring_span<T>::size() const noexcept
+{
+	const size_type front_idx = m_front_idx.load(std::memory_order_acquire);
+	return distance(front_idx, m_back_idx.load(std::memory_order_acquire));
+}
+
+template<typename T>
+typename sg14::spsc_ring_span<T>::size_type sg14::spsc_ring_span<T>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template<typename T>
+template<class Assign>
+bool sg14::spsc_ring_span<T>::push(Assign&& assign)
+{
+	const size_type back_idx = m_back_idx.load(std::memory_order_relaxed);
+
+	if (distance(m_front_idx_cache, back_idx) == m_capacity)
+	{
+		m_front_idx_cache = m_front_idx.load(std::memory_order_acquire); // Synchronises with the consumer's move out of the slot
+
+		if (distance(m_front_idx_cache, back_idx) == m_capacity)
+		{
+			return false;
+		}
+	}
+
+	assign(m_data[slot(back_idx)]);
+	m_back_idx.store(next(back_idx), std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<bool b, typename>
+bool sg14::spsc_ring_span<T>::try_push_back(const T& value) noexcept(std::is_nothrow_copy_assignable<T>::value)
+{
+	return push([&value](T& to) { to = value; });
+}
+
+template<typename T>
+template<bool b, typename>
+bool sg14::spsc_ring_span<T>::try_push_back(T&& value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	return push([&value](T& to) { to = std::move(value); });
+}
+
+template<typename T>
+template<class... FromType>
+bool sg14::spsc_ring_span<T>::try_emplace_back(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value && std::is_nothrow_move_assignable<T>::value)
+{
+	return push([&](T& to) { to = T(std::forward<FromType>(from_value)...); });
+}
+
+template<typename T>
+bool sg14::spsc_ring_span<T>::try_pop_front(T& to_value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	const size_type front_idx = m_front_idx.load(std::memory_order_relaxed);
+
+	if (front_idx == m_back_idx_cache)
+	{
+		m_back_idx_cache = m_back_idx.load(std::memory_order_acquire); // Synchronises with the producer's assignment to the slot
+
+		if (front_idx == m_back_idx_cache)
+		{
+			return false;
+		}
+	}
+
+	to_value = std::move(m_data[slot(front_idx)]);
+	m_front_idx.store(next(front_idx), std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<class ContiguousIterator>
+sg14::mpmc_ring_span<T>::mpmc_ring_span(ContiguousIterator begin, ContiguousIterator end) noexcept
+	: m_slots(&*begin)
+	, m_capacity(end - begin)
+	, m_mask((m_capacity > 1 && (m_capacity & (m_capacity - 1)) == 0) ? m_capacity - 1 : 0)
+	, m_enqueue_pos(0)
+	, m_dequeue_pos(0)
+{
+	assert(m_capacity != 0);
+
+	for (size_type i = 0; i != m_capacity; ++i)
+	{
+		m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+template<typename T>
+typename sg14::mpmc_ring_span<T>::slot_type& sg14::mpmc_ring_span<T>::slot(index_type pos) const noexcept
+{
+	return m_slots[(m_mask != 0) ? (pos & m_mask) : (pos % m_capacity)];
+}
+
+template<typename T>
+bool sg14::mpmc_ring_span<T>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename T>
+typename sg14::mpmc_ring_span<T>::size_type sg14::mpmc_ring_span<T>::size() const noexcept
+{
+	// The dequeue position never passes the enqueue position, so reading it first keeps the difference from underflowing:
+	const index_type dequeue_pos = m_dequeue_pos.load(std::memory_order_acquire);
+	const index_type difference = m_enqueue_pos.load(std::memory_order_acquire) - dequeue_pos;
+	return (difference < m_capacity) ? static_cast<size_type>(difference) : m_capacity;
+}
+
+template<typename T>
+typename sg14::mpmc_ring_span<T>::size_type sg14::mpmc_ring_span<T>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+// Claims up to max_count consecutive positions whose slots are free, returning the first and setting count to the number claimed (0 if the queue is full):
+template<typename T>
+typename sg14::mpmc_ring_span<T>::index_type sg14::mpmc_ring_span<T>::claim_push(size_type max_count, size_type& count) noexcept
+{
+	index_type pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		const std::int64_t difference = static_cast<std::int64_t>(slot(pos).sequence.load(std::memory_order_acquire) - pos);
+
+		if (difference == 0)
+		{
+			// A slot can only be made free for position pos + n by the consumer of pos + n - capacity, and another producer cannot fill it without first moving m_enqueue_pos past pos,
+			// so the run counted here is still free if the compare-exchange succeeds:
+			count = 1;
+
+			while (count != max_count && slot(pos + count).sequence.load(std::memory_order_acquire) == pos + count)
+			{
+				++count;
+			}
+
+			if (m_enqueue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+			{
+				return pos;
+			}
+		}
+		else if (difference < 0) // The slot still holds the element from the previous pass
+		{
+			count = 0;
+			return pos;
+		}
+		else // Another producer has claimed pos
+		{
+			pos = m_enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T>
+typename sg14::mpmc_ring_span<T>::index_type sg14::mpmc_ring_span<T>::claim_pop(size_type max_count, size_type& count) noexcept
+{
+	index_type pos = m_dequeue_pos.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		const std::int64_t difference = static_cast<std::int64_t>(slot(pos).sequence.load(std::memory_order_acquire) - (pos + 1));
+
+		if (difference == 0)
+		{
+			count = 1;
+
+			while (count != max_count && slot(pos + count).sequence.load(std::memory_order_acquire) == pos + count + 1)
+			{
+				++count;
+			}
+
+			if (m_dequeue_pos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+			{
+				return pos;
+			}
+		}
+		else if (difference < 0) // The slot has not been filled for this pass
+		{
+			count = 0;
+			return pos;
+		}
+		else // Another consumer has claimed pos
+		{
+			pos = m_dequeue_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T>
+template<bool b, typename>
+bool sg14::mpmc_ring_span<T>::try_push(const T& value) noexcept
+{
+	size_type count;
+	const index_type pos = claim_push(1, count);
+
+	if (count == 0)
+	{
+		return false;
+	}
+
+	slot_type& target = slot(pos);
+	target.value = value;
+	target.sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+bool sg14::mpmc_ring_span<T>::try_push(T&& value) noexcept
+{
+	size_type count;
+	const index_type pos = claim_push(1, count);
+
+	if (count == 0)
+	{
+		return false;
+	}
+
+	slot_type& target = slot(pos);
+	target.value = std::move(value);
+	target.sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<class... FromType>
+bool sg14::mpmc_ring_span<T>::try_emplace(FromType&&... from_value) noexcept(std::is_nothrow_constructible<T, FromType...>::value)
+{
+	return try_push(T(std::forward<FromType>(from_value)...));
+}
+
+template<typename T>
+bool sg14::mpmc_ring_span<T>::try_pop(T& to_value) noexcept
+{
+	size_type count;
+	const index_type pos = claim_pop(1, count);
+
+	if (count == 0)
+	{
+		return false;
+	}
+
+	slot_type& source = slot(pos);
+	to_value = std::move(source.value);
+	source.sequence.store(pos + m_capacity, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<class ForwardIterator>
+typename sg14::mpmc_ring_span<T>::size_type sg14::mpmc_ring_span<T>::try_push(ForwardIterator first, ForwardIterator last) noexcept
+{
+	static_assert(std::is_nothrow_assignable<T&, typename std::iterator_traits<ForwardIterator>::reference>::value, "mpmc_ring_span requires nothrow assignment from the pushed range");
+
+	const size_type wanted = static_cast<size_type>(std::distance(first, last));
+
+	if (wanted == 0)
+	{
+		return 0;
+	}
+
+	size_type count;
+	const index_type pos = claim_push((wanted < m_capacity) ? wanted : m_capacity, count);
+
+	for (size_type i = 0; i != count; ++i, ++first)
+	{
+		slot_type& target = slot(pos + i);
+		target.value = *first;
+		target.sequence.store(pos + i + 1, std::memory_order_release);
+	}
+
+	return count;
+}
+
+template<typename T>
+template<class OutputIterator>
+typename sg14::mpmc_ring_span<T>::size_type sg14::mpmc_ring_span<T>::try_pop(OutputIterator out, size_type max_count) noexcept
+{
+	static_assert(std::is_nothrow_assignable<decltype(*out), T&&>::value, "mpmc_ring_span requires nothrow assignment to the popped range");
+
+	if (max_count == 0)
+	{
+		return 0;
+	}
+
+	size_type count;
+	const index_type pos = claim_pop((max_count < m_capacity) ? max_count : m_capacity, count);
+
+	for (size_type i = 0; i != count; ++i, ++out)
+	{
+		slot_type& source = slot(pos + i);
+		*out = std::move(source.value);
+		source.sequence.store(pos + i + m_capacity, std::memory_order_release);
+	}
+
+	return count;
+}
+
+template<typename T>
+template <class ContiguousIterator>
+sg14::broadcast_ring_span<T>::broadcast_ring_span(ContiguousIterator begin, ContiguousIterator end, size_type consumers, full_policy policy)
+	: m_data(&*begin)
+	, m_capacity(end - begin)
+	, m_mask((m_capacity > 1 && (m_capacity & (m_capacity - 1)) == 0) ? m_capacity - 1 : 0)
+	, m_consumer_count(consumers)
+	, m_policy(policy)
+	, m_cursor_storage(::operator new(sizeof(cursor_type) * consumers + alignof(cursor_type) - 1))
+	, m_cursors(align_cursors(m_cursor_storage.get()))
+	, m_published(0)
+	, m_claimed(0)
+	, m_next(0)
+	, m_slowest_cache(0)
+{
+	assert(m_capacity != 0);
+	assert(policy != full_policy::overwrite || std::is_trivially_copyable<T>::value);
+
+	for (size_type i = 0; i != consumers; ++i)
+	{
+		::new (static_cast<void*>(m_cursors + i)) cursor_type(); // Trivially destructible, so the storage is simply freed
+		m_cursors[i].position.store(0, std::memory_order_relaxed);
+		m_cursors[i].lost = 0;
+	}
+}
+
+template<typename T>
+template<bool b, typename>
+bool sg14::broadcast_ring_span<T>::try_publish(const T& from_value) noexcept(std::is_nothrow_copy_assignable<T>::value)
+{
+	if (room(m_next, 1) == 0)
+	{
+		return false;
+	}
+
+	claim(m_next, 1);
+	m_data[slot(m_next)] = from_value;
+	m_published.store(++m_next, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<bool b, typename>
+bool sg14::broadcast_ring_span<T>::try_publish(T&& from_value) noexcept(std::is_nothrow_move_assignable<T>::value)
+{
+	if (room(m_next, 1) == 0)
+	{
+		return false;
+	}
+
+	claim(m_next, 1);
+	m_data[slot(m_next)] = std::move(from_value);
+	m_published.store(++m_next, std::memory_order_release);
+	return true;
+}
+
+template<typename T>
+template<class ForwardIterator>
+typename sg14::broadcast_ring_span<T>::size_type sg14::broadcast_ring_span<T>::try_publish(ForwardIterator first, ForwardIterator last)
+{
+	size_type count = static_cast<size_type>(std::distance(first, last));
+
+	// When overwriting, of more than capacity() elements only the last capacity() would be readable, so the others are never written:
+	if (m_policy == full_policy::overwrite && count > m_capacity)
+	{
+		std::advance(first, count - m_capacity);
+		m_next += count - m_capacity;
+		count = m_capacity;
+	}
+
+	count = room(m_next, count);
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	claim(m_next, count);
+	const size_type start = slot(m_next);
+	const size_type first_run = (count < m_capacity - start) ? count : m_capacity - start;
+	std::copy_n(first, first_run, m_data + start);
+	std::advance(first, first_run);
+	std::copy_n(first, count - first_run, m_data);
+
+	m_next += count;
+	m_published.store(m_next, std::memory_order_release);
+	return count;
+}
+
+template<typename T>
+std::array<std::pair<typename sg14::broadcast_ring_span<T>::const_pointer, typename sg14::broadcast_ring_span<T>::size_type>, 2> sg14::broadcast_ring_span<T>::available(size_type consumer) noexcept
+{
+	assert(consumer < m_consumer_count);
+	cursor_type& cursor = m_cursors[consumer];
+	sequence_type position = cursor.position.load(std::memory_order_relaxed);
+	const sequence_type published = m_published.load(std::memory_order_acquire);
+
+	if (published - position > m_capacity)
+	{
+		// Lapped by the producer - skip to the oldest element still in the ring:
+		cursor.lost += published - m_capacity - position;
+		position = published - m_capacity;
+		cursor.position.store(position, std::memory_order_release);
+	}
+
+	const size_type count = static_cast<size_type>(published - position);
+	const size_type start = slot(position);
+	const size_type first_run = (count < m_capacity - start) ? count : m_capacity - start;
+	return {{ std::make_pair(static_cast<const_pointer>(m_data + start), first_run), std::make_pair(static_cast<const_pointer>(m_data), count - first_run) }};
+}
+
+template<typename T>
+typename sg14::broadcast_ring_span<T>::size_type sg14::broadcast_ring_span<T>::size(size_type consumer) const noexcept
+{
+	assert(consumer < m_consumer_count);
+	const sequence_type position = m_cursors[consumer].position.load(std::memory_order_relaxed);
+	const sequence_type published = m_published.load(std::memory_order_acquire);
+	return static_cast<size_type>((published - position < m_capacity) ? published - position : m_capacity);
+}
+
+template<typename T>
+bool sg14::broadcast_ring_span<T>::release(size_type consumer, size_type n) noexcept
+{
+	assert(consumer < m_consumer_count);
+	cursor_type& cursor = m_cursors[consumer];
+	const sequence_type position = cursor.position.load(std::memory_order_relaxed);
+	bool intact = true;
+
+	if (m_policy == full_policy::overwrite)
+	{
+		// Order the caller's reads of the elements before the read of m_claimed - if the producer had claimed any of them by then, they may have been read part-written:
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const sequence_type claimed = m_claimed.load(std::memory_order_relaxed);
+		intact = (claimed <= position + m_capacity);
+
+		if (!intact)
+		{
+			cursor.lost += n;
+		}
+	}
+
+	assert(n <= m_published.load(std::memory_order_relaxed) - position);
+	cursor.position.store(position + n, std::memory_order_release);
+	return intact;
+}
+
+template<typename T>
+std::uint64_t sg14::broadcast_ring_span<T>::lost(size_type consumer) const noexcept
+{
+	assert(consumer < m_consumer_count);
+	return m_cursors[consumer].lost;
+}
+
+template<typename T>
+typename sg14::broadcast_ring_span<T>::cursor_type* sg14::broadcast_ring_span<T>::align_cursors(void* storage) noexcept
+{
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(storage);
+	return reinterpret_cast<cursor_type*>((address + alignof(cursor_type) - 1) & ~static_cast<std::uintptr_t>(alignof(cursor_type) - 1));
+}
+
+template<typename T>
+typename sg14::broadcast_ring_span<T>::size_type sg14::broadcast_ring_span<T>::slot(sequence_type sequence) const noexcept
+{
+	return static_cast<size_type>((m_mask != 0) ? (sequence & m_mask) : (sequence % m_capacity));
+}
+
+// How many of wanted elements can be published after next - only re-reading the consumers' cursors when the cached slowest cursor shows too little room:
+template<typename T>
+typename sg14::broadcast_ring_span<T>::size_type sg14::broadcast_ring_span<T>::room(sequence_type next, size_type wanted) noexcept
+{
+	if (m_policy == full_policy::overwrite)
+	{
+		return wanted;
+	}
+
+	if (next + wanted - m_slowest_cache > m_capacity)
+	{
+		sequence_type slowest = next;
+
+		for (size_type i = 0; i != m_consumer_count; ++i)
+		{
+			const sequence_type position = m_cursors[i].position.load(std::memory_order_acquire);
+			slowest = (position < slowest) ? position : slowest;
+		}
+
+		m_slowest_cache = slowest;
+	}
+
+	const size_type free = m_capacity - static_cast<size_type>(next - m_slowest_cache);
+	return (wanted < free) ? wanted : free;
+}
+
+template<typename T>
+void sg14::broadcast_ring_span<T>::claim(sequence_type next, size_type count) noexcept
+{
+	if (m_policy == full_policy::overwrite)
+	{
+		// Announce the claim before writing any of the claimed elements:
+		m_claimed.store(next + count, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+}
@@ -0,0 +1,472 @@
+#ifndef SG14_RING_WAIT_H
+#define SG14_RING_WAIT_H
+
+#include "ring.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+	#include <climits>
+	#include <ctime>
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#else
+	#include <condition_variable>
+	#include <mutex>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#endif
+
+namespace sg14
+{
+	// Tells the processor that the caller is spinning, so that it can give the other hyperthread the core and avoid a memory-order mis-speculation on leaving the loop:
+	inline void spin_pause() noexcept
+	{
+	#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+	#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_ia32_pause();
+	#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+		__asm__ __volatile__("yield");
+	#endif
+	}
+
+	// Wait strategies - how a thread waits for another thread to make a condition true, such as a ring becoming non-empty. Each provides:
+	//   wait(ready) - returns once ready() returns true. ready() is called repeatedly until it does, so may have side effects, such as popping an element.
+	//   wait_until(ready, deadline) - as wait(), but gives up and returns false once the deadline has passed.
+	//   notify() - called by the other thread after each change that might make ready() true.
+	// busy_spin_wait has the lowest latency but keeps a core busy for as long as it waits, so is only suitable when each waiting thread has a core to itself.
+	// spin_yield_wait spins briefly, then yields the core to any other runnable thread between tries - cheap to wake, but never sleeps.
+	// spin_futex_wait spins briefly, then parks the thread in the kernel (on a futex on Linux, otherwise on a condition variable) until notified. notify() only makes a system
+	// call when a thread is actually parked, so the notifying thread pays a memory fence and a load per notify otherwise.
+	class busy_spin_wait
+	{
+	public:
+		template <class Predicate>
+		void wait(Predicate ready);
+		template <class Predicate, class Clock, class Duration>
+		bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline);
+		void notify() noexcept {}
+	};
+
+	class spin_yield_wait
+	{
+	public:
+		explicit spin_yield_wait(unsigned int spin_count = 100) noexcept : m_spin_count(spin_count) {}
+
+		template <class Predicate>
+		void wait(Predicate ready);
+		template <class Predicate, class Clock, class Duration>
+		bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline);
+		void notify() noexcept {}
+
+	private:
+		unsigned int m_spin_count;
+	};
+
+	class spin_futex_wait
+	{
+	public:
+		explicit spin_futex_wait(unsigned int spin_count = 100) noexcept;
+
+		spin_futex_wait(const spin_futex_wait&) = delete;
+		spin_futex_wait& operator=(const spin_futex_wait&) = delete;
+
+		template <class Predicate>
+		void wait(Predicate ready);
+		template <class Predicate, class Clock, class Duration>
+		bool wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline);
+		void notify() noexcept;
+
+	private:
+		// Parks until notified after epoch was read, or until the timeout (if not null) elapses - may also return spuriously:
+		void park(std::uint32_t epoch, const std::chrono::nanoseconds* timeout) noexcept;
+
+		// A waiter registers in m_waiters before it's final check of the condition, and notify() reads m_waiters after the change to the condition, with a fence on both sides,
+		// so that either the waiter sees the change or notify() sees the waiter. notify() then bumps m_epoch, so that a waiter which read the old epoch does not sleep:
+		const unsigned int m_spin_count;
+		std::atomic<std::uint32_t> m_epoch;
+		std::atomic<std::uint32_t> m_waiters;
+
+	#if !defined(__linux__)
+		std::mutex m_mutex;
+		std::condition_variable m_wakeup;
+	#endif
+	};
+
+	// Blocking push and pop over an spsc_ring_span or mpmc_ring_span, which the blocking_ring constructs in place from it's constructor arguments. Consumers wait on one
+	// WaitStrategy while the ring is empty, and producers on another while it is full. As for the ring: with an spsc_ring_span only one thread may push and one pop.
+	template <class Ring, class WaitStrategy = spin_futex_wait>
+	class blocking_ring
+	{
+	public:
+		using ring_type = Ring;
+		using wait_strategy = WaitStrategy;
+		using size_type = typename Ring::size_type;
+		using value_type = typename Ring::value_type;
+
+		template <class... RingArguments>
+		explicit blocking_ring(RingArguments&&... ring_arguments);
+
+		ring_type& ring() noexcept { return m_ring; }
+		const ring_type& ring() const noexcept { return m_ring; }
+
+		// Wait while the ring is full:
+		void push(const value_type& from_value);
+		void push(value_type&& from_value);
+		template <class Clock, class Duration>
+		bool try_push_until(const value_type& from_value, const std::chrono::time_point<Clock, Duration>& deadline);
+		template <class Rep, class Period>
+		bool try_push_for(const value_type& from_value, const std::chrono::duration<Rep, Period>& timeout);
+
+		// Wait while the ring is empty:
+		void pop(value_type& to_value);
+		template <class Clock, class Duration>
+		bool try_pop_until(value_type& to_value, const std::chrono::time_point<Clock, Duration>& deadline);
+		template <class Rep, class Period>
+		bool try_pop_for(value_type& to_value, const std::chrono::duration<Rep, Period>& timeout);
+
+		// Never wait - these return false, leaving the ring unchanged, when it is full or empty:
+		bool try_push(const value_type& from_value);
+		bool try_push(value_type&& from_value);
+		bool try_pop(value_type& to_value);
+
+		// Example implementation
+	private:
+		template <class T, class From>
+		static bool ring_try_push(spsc_ring_span<T>& ring, From&& from_value) { return ring.try_push_back(std::forward<From>(from_value)); }
+		template <class T, class From>
+		static bool ring_try_push(mpmc_ring_span<T>& ring, From&& from_value) { return ring.try_push(std::forward<From>(from_value)); }
+		template <class T>
+		static bool ring_try_pop(spsc_ring_span<T>& ring, T& to_value) { return ring.try_pop_front(to_value); }
+		template <class T>
+		static bool ring_try_pop(mpmc_ring_span<T>& ring, T& to_value) { return ring.try_pop(to_value); }
+
+		ring_type m_ring;
+		wait_strategy m_not_empty; // Waited on by consumers, notified by producers
+		wait_strategy m_not_full; // Waited on by producers, notified by consumers
+	};
+}
+
+
+
+// Implementation:
+
+template <class Predicate>
+void sg14::busy_spin_wait::wait(Predicate ready)
+{
+	while (!ready())
+	{
+		spin_pause();
+	}
+}
+
+template <class Predicate, class Clock, class Duration>
+bool sg14::busy_spin_wait::wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	while (!ready())
+	{
+		if (Clock::now() >= deadline)
+		{
+			return ready();
+		}
+
+		spin_pause();
+	}
+
+	return true;
+}
+
+template <class Predicate>
+void sg14::spin_yield_wait::wait(Predicate ready)
+{
+	for (unsigned int spin = 0; !ready(); ++spin)
+	{
+		if (spin < m_spin_count)
+		{
+			spin_pause();
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+template <class Predicate, class Clock, class Duration>
+bool sg14::spin_yield_wait::wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	for (unsigned int spin = 0; !ready(); ++spin)
+	{
+		if (Clock::now() >= deadline)
+		{
+			return ready();
+		}
+
+		if (spin < m_spin_count)
+		{
+			spin_pause();
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	return true;
+}
+
+inline sg14::spin_futex_wait::spin_futex_wait(unsigned int spin_count) noexcept
+	: m_spin_count(spin_count)
+	, m_epoch(0)
+	, m_waiters(0)
+{
+#if defined(__linux__)
+	static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "spin_futex_wait requires a lock-free 32-bit atomic to use as a futex");
+#endif
+}
+
+template <class Predicate>
+void sg14::spin_futex_wait::wait(Predicate ready)
+{
+	for (unsigned int spin = 0; spin != m_spin_count; ++spin)
+	{
+		if (ready())
+		{
+			return;
+		}
+
+		spin_pause();
+	}
+
+	while (true)
+	{
+		const std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+		m_waiters.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (ready())
+		{
+			m_waiters.fetch_sub(1, std::memory_order_relaxed);
+			return;
+		}
+
+		park(epoch, nullptr);
+		m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+		if (ready())
+		{
+			return;
+		}
+	}
+}
+
+template <class Predicate, class Clock, class Duration>
+bool sg14::spin_futex_wait::wait_until(Predicate ready, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	for (unsigned int spin = 0; spin != m_spin_count; ++spin)
+	{
+		if (ready())
+		{
+			return true;
+		}
+
+		spin_pause();
+	}
+
+	while (true)
+	{
+		const std::chrono::nanoseconds remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now());
+
+		if (remaining.count() <= 0)
+		{
+			return ready();
+		}
+
+		const std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+		m_waiters.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (ready())
+		{
+			m_waiters.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		park(epoch, &remaining);
+		m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+		if (ready())
+		{
+			return true;
+		}
+	}
+}
+
+inline void sg14::spin_futex_wait::notify() noexcept
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (m_waiters.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+#if defined(__linux__)
+	m_epoch.fetch_add(1, std::memory_order_release);
+	syscall(SYS_futex, &m_epoch, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_epoch.fetch_add(1, std::memory_order_release);
+	}
+
+	m_wakeup.notify_all();
+#endif
+}
+
+inline void sg14::spin_futex_wait::park(std::uint32_t epoch, const std::chrono::nanoseconds* timeout) noexcept
+{
+#if defined(__linux__)
+	// FUTEX_WAIT returns straight away if m_epoch no longer holds epoch, so a notify() between reading the epoch and parking is not lost:
+	if (timeout == nullptr)
+	{
+		syscall(SYS_futex, &m_epoch, FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+	}
+	else
+	{
+		timespec relative;
+		relative.tv_sec = static_cast<time_t>(timeout->count() / 1000000000);
+		relative.tv_nsec = static_cast<long>(timeout->count() % 1000000000);
+		syscall(SYS_futex, &m_epoch, FUTEX_WAIT_PRIVATE, epoch, &relative, nullptr, 0);
+	}
+#else
+	std::unique_lock<std::mutex> lock(m_mutex);
+	const auto notified = [this, epoch] { return m_epoch.load(std::memory_order_relaxed) != epoch; };
+
+	if (timeout == nullptr)
+	{
+		m_wakeup.wait(lock, notified);
+	}
+	else
+	{
+		m_wakeup.wait_for(lock, *timeout, notified);
+	}
+#endif
+}
+
+template <class Ring, class WaitStrategy>
+template <class... RingArguments>
+sg14::blocking_ring<Ring, WaitStrategy>::blocking_ring(RingArguments&&... ring_arguments)
+	: m_ring(std::forward<RingArguments>(ring_arguments)...)
+	, m_not_empty()
+	, m_not_full()
+{}
+
+template <class Ring, class WaitStrategy>
+void sg14::blocking_ring<Ring, WaitStrategy>::push(const value_type& from_value)
+{
+	m_not_full.wait([this, &from_value] { return ring_try_push(m_ring, from_value); });
+	m_not_empty.notify();
+}
+
+template <class Ring, class WaitStrategy>
+void sg14::blocking_ring<Ring, WaitStrategy>::push(value_type&& from_value)
+{
+	// A failed push leaves from_value unchanged, so it can be moved from on each try:
+	m_not_full.wait([this, &from_value] { return ring_try_push(m_ring, std::move(from_value)); });
+	m_not_empty.notify();
+}
+
+template <class Ring, class WaitStrategy>
+template <class Clock, class Duration>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_push_until(const value_type& from_value, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	if (!m_not_full.wait_until([this, &from_value] { return ring_try_push(m_ring, from_value); }, deadline))
+	{
+		return false;
+	}
+
+	m_not_empty.notify();
+	return true;
+}
+
+template <class Ring, class WaitStrategy>
+template <class Rep, class Period>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_push_for(const value_type& from_value, const std::chrono::duration<Rep, Period>& timeout)
+{
+	return try_push_until(from_value, std::chrono::steady_clock::now() + timeout);
+}
+
+template <class Ring, class WaitStrategy>
+void sg14::blocking_ring<Ring, WaitStrategy>::pop(value_type& to_value)
+{
+	m_not_empty.wait([this, &to_value] { return ring_try_pop(m_ring, to_value); });
+	m_not_full.notify();
+}
+
+template <class Ring, class WaitStrategy>
+template <class Clock, class Duration>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_pop_until(value_type& to_value, const std::chrono::time_point<Clock, Duration>& deadline)
+{
+	if (!m_not_empty.wait_until([this, &to_value] { return ring_try_pop(m_ring, to_value); }, deadline))
+	{
+		return false;
+	}
+
+	m_not_full.notify();
+	return true;
+}
+
+template <class Ring, class WaitStrategy>
+template <class Rep, class Period>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_pop_for(value_type& to_value, const std::chrono::duration<Rep, Period>& timeout)
+{
+	return try_pop_until(to_value, std::chrono::steady_clock::now() + timeout);
+}
+
+template <class Ring, class WaitStrategy>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_push(const value_type& from_value)
+{
+	if (!ring_try_push(m_ring, from_value))
+	{
+		return false;
+	}
+
+	m_not_empty.notify();
+	return true;
+}
+
+template <class Ring, class WaitStrategy>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_push(value_type&& from_value)
+{
+	if (!ring_try_push(m_ring, std::move(from_value)))
+	{
+		return false;
+	}
+
+	m_not_empty.notify();
+	return true;
+}
+
+template <class Ring, class WaitStrategy>
+bool sg14::blocking_ring<Ring, WaitStrategy>::try_pop(value_type& to_value)
+{
+	if (!ring_try_pop(m_ring, to_value))
+	{
+		return false;
+	}
+
+	m_not_full.notify();
+	return true;
+}
+
+#endif // SG14_RING_WAIT_H
@@ -0,0 +1,256 @@
+#ifndef SG14_SLIDING_WINDOW_H
+#define SG14_SLIDING_WINDOW_H
+
+#include "ring.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace sg14
+{
+	// The last window_size() samples pushed, held in a ring_span, along with statistics over them that are updated as each sample is pushed rather than recomputed.
+	// Pushes are divided into blocks of window_size(), so that the window always holds the end of the previous block and the start of the current one. The sum, mean and
+	// (population) variance are updated in O(1) per push, and are recomputed over the window at the end of each block so that floating-point rounding does not build up.
+	// The minimum and maximum are the lesser (greater) of the previous block's remaining samples, whose suffix minima and maxima are also found at the end of each block,
+	// and the current block's running minimum (maximum) - which, unlike a monotonic queue, needs no data-dependent branches per push. The work at the end of a block is
+	// O(window_size()), so every update is amortised O(1).
+	// fir() applies filter coefficients to the window as two contiguous dot products, one for each region of the ring, so that no index wraps inside the loops and they
+	// can be vectorised.
+	template <typename T = double>
+	class sliding_window
+	{
+	public:
+		using size_type = std::size_t;
+		using value_type = T;
+		using span_type = ring_span<T, null_popper<T>>;
+
+		static_assert(std::is_floating_point<T>::value, "sliding_window requires a floating-point sample type");
+
+		explicit sliding_window(size_type window_size);
+
+		void push(T sample);
+		template <class InputIterator>
+		void push(InputIterator first, InputIterator last);
+		void clear() noexcept;
+
+		bool empty() const noexcept { return m_samples.empty(); }
+		bool full() const noexcept { return m_samples.full(); }
+		size_type size() const noexcept { return m_samples.size(); }
+		size_type window_size() const noexcept { return m_samples.capacity(); }
+
+		// The samples, oldest first:
+		const span_type& samples() const noexcept { return m_samples; }
+
+		// These require a non-empty window:
+		T sum() const noexcept { return m_sum; }
+		T mean() const noexcept;
+		T variance() const noexcept;
+		T min() const noexcept;
+		T max() const noexcept;
+
+		// The sum of each sample multiplied by the matching coefficient, the first coefficient applying to the oldest sample, as std::inner_product over samples().
+		// coefficients must point to at least size() values:
+		T fir(const T* coefficients) const noexcept;
+
+		// Example implementation
+	private:
+		void end_block() noexcept;
+		void reset_extremes() noexcept;
+		static T dot(const T* lhs, const T* rhs, size_type count) noexcept;
+
+		std::vector<T> m_storage;
+		span_type m_samples;
+		T m_sum;
+		T m_squared_deviations; // Sum of the squared differences from the mean
+		T m_inverse_window_size;
+		std::vector<T> m_suffix_min; // Element i is the minimum of the previous block's samples from i on, or infinity before the first block ends
+		std::vector<T> m_suffix_max;
+		T m_prefix_min; // Of the current block's samples, or infinity before the first push in it
+		T m_prefix_max;
+		size_type m_block_position; // Samples pushed in the current block, and so the number of the previous block's samples that have left the window
+	};
+}
+
+
+
+// Implementation:
+
+template <typename T>
+sg14::sliding_window<T>::sliding_window(size_type window_size)
+	: m_storage(window_size)
+	, m_samples(m_storage.begin(), m_storage.end())
+	, m_sum(0)
+	, m_squared_deviations(0)
+	, m_inverse_window_size(T(1) / static_cast<T>(window_size))
+	, m_suffix_min(window_size)
+	, m_suffix_max(window_size)
+	, m_block_position(0)
+{
+	assert(window_size != 0);
+	reset_extremes();
+}
+
+template <typename T>
+void sg14::sliding_window<T>::push(T sample)
+{
+	if (m_samples.full())
+	{
+		// Replacing the oldest sample leaves the count unchanged:
+		const T oldest = m_samples.front();
+		const T old_mean = m_sum * m_inverse_window_size;
+		m_sum += sample - oldest;
+		const T new_mean = m_sum * m_inverse_window_size;
+		m_squared_deviations += (sample - oldest) * ((sample - new_mean) + (oldest - old_mean));
+	}
+	else
+	{
+		const T old_count = static_cast<T>(m_samples.size());
+		const T old_mean = (m_samples.empty()) ? T(0) : m_sum / old_count;
+		m_sum += sample;
+		const T new_mean = m_sum / (old_count + 1);
+		m_squared_deviations += (sample - old_mean) * (sample - new_mean);
+	}
+
+	m_samples.push_back(sample);
+	m_prefix_min = (sample < m_prefix_min) ? sample : m_prefix_min;
+	m_prefix_max = (sample > m_prefix_max) ? sample : m_prefix_max;
+
+	if (++m_block_position == m_samples.capacity())
+	{
+		end_block();
+	}
+}
+
+template <typename T>
+template <class InputIterator>
+void sg14::sliding_window<T>::push(InputIterator first, InputIterator last)
+{
+	for (; first != last; ++first)
+	{
+		push(*first);
+	}
+}
+
+template <typename T>
+void sg14::sliding_window<T>::clear() noexcept
+{
+	m_samples.pop_front_n(m_samples.size());
+	m_sum = m_squared_deviations = T(0);
+	m_block_position = 0;
+	reset_extremes();
+}
+
+template <typename T>
+T sg14::sliding_window<T>::mean() const noexcept
+{
+	assert(!m_samples.empty());
+	return m_sum / static_cast<T>(m_samples.size());
+}
+
+template <typename T>
+T sg14::sliding_window<T>::variance() const noexcept
+{
+	assert(!m_samples.empty());
+	const T variance = m_squared_deviations / static_cast<T>(m_samples.size());
+	return (variance > T(0)) ? variance : T(0); // Rounding can take a near-zero variance below zero
+}
+
+template <typename T>
+T sg14::sliding_window<T>::min() const noexcept
+{
+	assert(!m_samples.empty());
+	const T previous_block_min = m_suffix_min[m_block_position];
+	return (previous_block_min < m_prefix_min) ? previous_block_min : m_prefix_min;
+}
+
+template <typename T>
+T sg14::sliding_window<T>::max() const noexcept
+{
+	assert(!m_samples.empty());
+	const T previous_block_max = m_suffix_max[m_block_position];
+	return (previous_block_max > m_prefix_max) ? previous_block_max : m_prefix_max;
+}
+
+template <typename T>
+T sg14::sliding_window<T>::fir(const T* coefficients) const noexcept
+{
+	const auto regions = m_samples.contiguous_regions();
+	return dot(regions[0].first, coefficients, regions[0].second) + dot(regions[1].first, coefficients + regions[0].second, regions[1].second);
+}
+
+// The window now holds exactly the block just ended - recompute the sum and squared deviations over it, and find it's suffix minima and maxima for the next block:
+template <typename T>
+void sg14::sliding_window<T>::end_block() noexcept
+{
+	const auto regions = m_samples.contiguous_regions();
+	T sum = T(0), min = std::numeric_limits<T>::infinity(), max = -std::numeric_limits<T>::infinity();
+	size_type position = m_samples.size();
+
+	for (size_type region = 2; region-- != 0;)
+	{
+		for (size_type i = regions[region].second; i-- != 0;)
+		{
+			const T sample = regions[region].first[i];
+			sum += sample;
+			min = (sample < min) ? sample : min;
+			max = (sample > max) ? sample : max;
+			m_suffix_min[--position] = min;
+			m_suffix_max[position] = max;
+		}
+	}
+
+	const T mean = sum * m_inverse_window_size;
+	T squared_deviations = T(0);
+
+	for (const auto& region : regions)
+	{
+		for (size_type i = 0; i != region.second; ++i)
+		{
+			squared_deviations += (region.first[i] - mean) * (region.first[i] - mean);
+		}
+	}
+
+	m_sum = sum;
+	m_squared_deviations = squared_deviations;
+	m_prefix_min = std::numeric_limits<T>::infinity();
+	m_prefix_max = -std::numeric_limits<T>::infinity();
+	m_block_position = 0;
+}
+
+template <typename T>
+void sg14::sliding_window<T>::reset_extremes() noexcept
+{
+	std::fill(m_suffix_min.begin(), m_suffix_min.end(), std::numeric_limits<T>::infinity());
+	std::fill(m_suffix_max.begin(), m_suffix_max.end(), -std::numeric_limits<T>::infinity());
+	m_prefix_min = std::numeric_limits<T>::infinity();
+	m_prefix_max = -std::numeric_limits<T>::infinity();
+}
+
+// Four independent accumulators break the dependency between successive additions, so that the loop can be unrolled into vector multiply-adds without -ffast-math:
+template <typename T>
+T sg14::sliding_window<T>::dot(const T* lhs, const T* rhs, size_type count) noexcept
+{
+	T sum0 = T(0), sum1 = T(0), sum2 = T(0), sum3 = T(0);
+	size_type i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		sum0 += lhs[i] * rhs[i];
+		sum1 += lhs[i + 1] * rhs[i + 1];
+		sum2 += lhs[i + 2] * rhs[i + 2];
+		sum3 += lhs[i + 3] * rhs[i + 3];
+	}
+
+	for (; i != count; ++i)
+	{
+		sum0 += lhs[i] * rhs[i];
+	}
+
+	return (sum0 + sum1) + (sum2 + sum3);
+}
+
+#endif // SG14_SLIDING_WINDOW_H
@@ -6,11 +6,22 @@ namespace sg14_test
     void inplace_function_test();
     void transcode_test();
     void ring_test();
+    void spsc_ring_test();
+    void mpmc_ring_test();
+    void blocking_ring_test();
+    void broadcast_ring_test();
     void static_ring_test();
     void dynamic_ring_test();
+    void uninitialized_ring_span_test();
+    void mirrored_ring_test();
 	void thread_communication_test();
 	void filter_test();
+	void sliding_window_test();
 	void unstable_remove_test();
+	void plf_colony_change_tracking_test();
+	void plf_colony_test_suite();
+	void plf_stack_test_suite();
+	void plf_queue_test_suite();
 	void uninitialized();
 }
 
@@ -11,9 +11,22 @@ int main(int, char *[])
     sg14_test::inplace_function_test();
     sg14_test::transcode_test();
     sg14_test::ring_test();
+    sg14_test::spsc_ring_test();
+    sg14_test::mpmc_ring_test();
+    sg14_test::blocking_ring_test();
+    sg14_test::broadcast_ring_test();
+    sg14_test::static_ring_test();
+    sg14_test::dynamic_ring_test();
+    sg14_test::uninitialized_ring_span_test();
+    sg14_test::mirrored_ring_test();
     sg14_test::thread_communication_test();
     sg14_test::filter_test();
+    sg14_test::sliding_window_test();
     sg14_test::unstable_remove_test();
+    sg14_test::plf_colony_change_tracking_test();
+    sg14_test::plf_colony_test_suite();
+    sg14_test::plf_stack_test_suite();
+    sg14_test::plf_queue_test_suite();
 	sg14_test::uninitialized();
 
 	puts("tests completed");
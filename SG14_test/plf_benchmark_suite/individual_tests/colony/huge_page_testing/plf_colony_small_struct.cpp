@@ -0,0 +1,11 @@
+#include "../../../plf_bench.h"
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_huge_page_iteration<small_struct>(std::size_t(1) << 30, 10, 25); // 1GB colony
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#include "../../../plf_bench.h"
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_level_load<int>(10, 1000000, 1.1, 25, true);
+
+	return 0;
+}
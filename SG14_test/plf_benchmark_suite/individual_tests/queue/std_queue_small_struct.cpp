@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_queue< std::queue<small_struct> >(10, 1000000, 1.1, true);
+
+	return 0;
+}
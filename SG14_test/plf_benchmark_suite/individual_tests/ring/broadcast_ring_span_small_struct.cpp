@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_broadcast_ring<small_struct>(1024, 1, 4, 2000000, 5, true);
+
+	return 0;
+}
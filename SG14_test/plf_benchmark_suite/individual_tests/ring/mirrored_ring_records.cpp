@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_mirrored_ring(65536, 16, 8192, 1500, 16000000, 20, true);
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_ring_scaling<int>(1024, 16, 4000000, 32, 5, true);
+
+	return 0;
+}
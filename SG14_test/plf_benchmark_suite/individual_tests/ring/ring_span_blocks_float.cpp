@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_ring_span_blocks<float>(10000, 256, 4096, 10000000, 20, true);
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_ring_wait_strategies(64, 0, 1000, 2000, 5, true);
+
+	return 0;
+}
@@ -0,0 +1,16 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	std::cout << "Capacity, ring_span push, ring_span iterate, ring_span pop, static_ring push, static_ring iterate, static_ring pop, dynamic_ring push, dynamic_ring iterate, dynamic_ring pop" << std::endl;
+	benchmark_static_ring<int, 64>(10000000, 20, true);
+	benchmark_static_ring<int, 1000>(10000000, 20, true);
+	benchmark_static_ring<int, 1024>(10000000, 20, true);
+	benchmark_static_ring<int, 4096>(10000000, 20, true);
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_stack_bulk<int>(16, 4096, 4000000, 10, true);
+
+	return 0;
+}
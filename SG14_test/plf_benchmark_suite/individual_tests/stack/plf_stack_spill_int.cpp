@@ -0,0 +1,15 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	for (std::size_t resident_megabytes = 16; resident_megabytes <= 256; resident_megabytes *= 4)
+	{
+		benchmark_stack_spill<int>(std::size_t(1) << 30, resident_megabytes << 20, 3, "plf_stack_spill.tmp"); // 1GB stack
+	}
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include "../../plf_bench.h"
+
+
+
+int main(int argc, char **argv)
+{
+	output_to_csv_file(argv[0]);
+
+	benchmark_range_stack_trim_policy<int>(256, 1024, 262144, 4096, 10, true);
+
+	return 0;
+}
@@ -1,6 +1,7 @@
 #ifndef PLF_BENCH_H
 #define PLF_BENCH_H
 
+#include <algorithm> // std::sort, std::partition
 #include <iostream>
 #include <list>
 #include <map>
@@ -8,16 +9,42 @@
 #include <vector>
 #include <deque>
 #include <stack>
+#include <queue>
 #include <cstdio> // freopen, sprintf
 #include <limits> // std::numeric_limits
 
 #include "plf_colony.h"
 #include "plf_stack.h"
+#include "plf_queue.h"
 #include "plf_nanotimer.h"
 #include "plf_indexed_vector.h"
 #include "plf_pointer_deque.h"
 #include "plf_packed_deque.h"
 
+#if (defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	#define PLF_BENCH_ALLOCATOR_SUPPORT // The SG14 allocators require C++11
+	#include "arena_allocator.h"
+	#include "huge_page_allocator.h"
+	#include "file_backed_allocator.h"
+
+	#define PLF_BENCH_THREAD_SUPPORT // As do std::thread and the concurrent stacks
+	#include <mutex>
+	#include <thread>
+	#include "plf_concurrent_stack.h"
+	#include "plf_work_stealing_deque.h"
+#endif
+
+#if (defined(__cplusplus) && __cplusplus >= 201402L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+	#define PLF_BENCH_RING_SUPPORT // sg14::ring_span requires C++14
+	#include <array>
+	#include <condition_variable>
+	#include <numeric> // std::inner_product
+	#include "ring.h"
+	#include "mirrored_ring.h"
+	#include "ring_wait.h"
+	#include "sliding_window.h"
+#endif
+
 
 // Defines:
 
@@ -247,6 +274,20 @@ inline PLF_FORCE_INLINE void container_insert(std::stack<container_contents> &co
 }
 
 
+template <class container_contents>
+inline PLF_FORCE_INLINE void container_insert(plf::queue<container_contents> &container)
+{
+	container.push(container_contents(xor_rand() & 255));
+}
+
+
+template <class container_contents>
+inline PLF_FORCE_INLINE void container_insert(std::queue<container_contents> &container)
+{
+	container.push(container_contents(xor_rand() & 255));
+}
+
+
 
 
 template <class container_contents>
@@ -683,6 +724,81 @@ inline PLF_FORCE_INLINE void container_back_pop(std::vector<large_struct> &conta
 }
 
 
+
+// FRONT/POP FUNCTIONS:
+
+template <class container_contents>
+inline PLF_FORCE_INLINE void container_front_pop(plf::queue<container_contents> &container, double &total)
+{
+	total += container.front();
+	container.pop();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(plf::queue<small_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(plf::queue<large_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop();
+}
+
+
+template <class container_contents>
+inline PLF_FORCE_INLINE void container_front_pop(std::queue<container_contents> &container, double &total)
+{
+	total += container.front();
+	container.pop();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(std::queue<small_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(std::queue<large_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop();
+}
+
+
+template <class container_contents>
+inline PLF_FORCE_INLINE void container_front_pop(std::deque<container_contents> &container, double &total)
+{
+	total += container.front();
+	container.pop_front();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(std::deque<small_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop_front();
+}
+
+
+template <>
+inline PLF_FORCE_INLINE void container_front_pop(std::deque<large_struct> &container, double &total)
+{
+	total += container.front().number;
+	container.pop_front();
+}
+
+
 template<class container_type>
 inline PLF_FORCE_INLINE void benchmark_stack(const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false, const bool reserve = false)
 {
@@ -776,6 +892,71 @@ inline PLF_FORCE_INLINE void benchmark_stack(const unsigned int number_of_elemen
 
 
 
+// Queue tests - elements are pushed, then the queue is cycled (one push and one pop per element, as with a steady-state work or message queue), then popped until empty.
+// The cycling phase is where the container's reuse (or not) of drained memory shows:
+
+template<class container_type>
+inline PLF_FORCE_INLINE void benchmark_queue(const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double push_time = 0, cycle_time = 0, pop_time = 0, total = 0;
+	plf::nanotimer timer;
+
+	// Warm up cache, then time - the first pass's results are discarded:
+	for (unsigned int pass = 0; pass != 2; ++pass)
+	{
+		const unsigned int end = (pass == 0) ? (number_of_runs / 10) + 1 : number_of_runs;
+		push_time = cycle_time = pop_time = 0;
+
+		for (unsigned int run_number = 0; run_number != end; ++run_number)
+		{
+			container_type container;
+			timer.start();
+
+			for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+			{
+				container_insert(container);
+			}
+
+			push_time += timer.get_elapsed_us();
+			timer.start();
+
+			for (unsigned int cycle_number = 0; cycle_number != number_of_elements * 4; ++cycle_number)
+			{
+				container_insert(container);
+				container_front_pop(container, total);
+			}
+
+			cycle_time += timer.get_elapsed_us();
+			timer.start();
+
+			for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+			{
+				container_front_pop(container, total);
+			}
+
+			pop_time += timer.get_elapsed_us();
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (push_time / number_of_runs) << ", " << (cycle_time / number_of_runs) << ", " << (pop_time / number_of_runs) << ", " << ((push_time + cycle_time + pop_time) / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Push " << number_of_elements << " elements: " << (push_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Cycle (push and pop) " << number_of_elements * 4 << " times: " << (cycle_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Pop and sum: " << (pop_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Total time: " << ((push_time + cycle_time + pop_time) / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+
+
 // Combinations:
 
 template <class container_type>
@@ -2642,6 +2823,33 @@ void benchmark_range_stack(const unsigned int min_number_of_elements, const unsi
 
 
 
+template <class container_type>
+void benchmark_range_queue(const unsigned int min_number_of_elements, const unsigned int max_number_of_elements, const double multiply_factor, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Number of elements, Push, Cycle, Front/Pop, Total time" << std::endl;
+	}
+
+	for (unsigned int number_of_elements = min_number_of_elements; number_of_elements <= max_number_of_elements; number_of_elements = static_cast<unsigned int>(static_cast<double>(number_of_elements) * multiply_factor))
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_elements;
+		}
+
+		benchmark_queue<container_type>(number_of_elements, (20000000 / number_of_elements) + 1, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,\n,,,,\n";
+	}
+}
+
+
+
+
 
 template <class container_type>
 void benchmark_range_general_use(const unsigned int min_number_of_elements, const unsigned int max_number_of_elements, const double multiply_factor, const unsigned int number_of_cycles, const unsigned int initial_number_of_modifications, const unsigned int max_number_of_modifications, const unsigned int number_of_modification_addition_amount)
@@ -2765,6 +2973,2355 @@ void benchmark_range_general_use_remove_if_percentage(const unsigned int min_num
 
 
 
+// Copy tests - compares a container's copy constructor against copy-inserting each element into an empty container (the general copy path). For trivially-copyable types plf::colony's copy constructor duplicates whole groups instead:
+
+template <class container_type>
+inline PLF_FORCE_INLINE void benchmark_copy(const unsigned int number_of_elements, const unsigned int number_of_runs, const unsigned int erasure_percentage, const bool output_csv = false)
+{
+	assert (erasure_percentage < 100); // Ie. lower than 100%
+	assert (number_of_elements > 1);
+
+	const unsigned int erasure_percent_expanded = static_cast<unsigned int>((static_cast<double>(erasure_percentage) * 1.28) + 0.5);
+	double copy_time = 0, insert_time = 0, total_size = 0;
+	plf::nanotimer copy_timer, insert_timer;
+
+	container_type source;
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		container_insert(source);
+	}
+
+	for (typename container_type::iterator current_element = source.begin(); current_element != source.end();)
+	{
+		if ((xor_rand() & 127) < erasure_percent_expanded)
+		{
+			container_erase(source, current_element);
+		}
+		else
+		{
+			++current_element;
+		}
+	}
+
+
+	// Dump-runs to get the cache 'warmed up':
+	const unsigned int end = (number_of_runs / 10) + 1;
+	for (unsigned int run_number = 0; run_number != end; ++run_number)
+	{
+		container_type container(source);
+		total_size += container.size();
+
+		container_type container2;
+		container2.insert(source.begin(), source.end());
+		total_size += container2.size();
+	}
+
+	std::cerr << "Dump size: " << total_size << std::endl;
+	total_size = 0;
+
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		copy_timer.start();
+		{
+			container_type container(source);
+			total_size += container.size();
+		}
+		copy_time += copy_timer.get_elapsed_us();
+
+		insert_timer.start();
+		{
+			container_type container;
+			container.insert(source.begin(), source.end());
+			total_size += container.size();
+		}
+		insert_time += insert_timer.get_elapsed_us();
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (copy_time / number_of_runs) << ", " << (insert_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Copy construct " << source.size() << " elements: " << (copy_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Copy-insert " << source.size() << " elements: " << (insert_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump size: " << total_size << std::endl; // To prevent compiler from optimizing out the copies
+}
+
+
+
+template <class container_type>
+void benchmark_range_copy(const unsigned int min_number_of_elements, const unsigned int max_number_of_elements, const double multiply_factor, const unsigned int erasure_percentage, const bool output_csv = false)
+{
+	assert (min_number_of_elements > 1);
+	assert (min_number_of_elements < max_number_of_elements);
+
+	if (output_csv)
+	{
+		std::cout << "Erasure percentage: " << erasure_percentage << "\n\nNumber of elements, Copy construction, Copy-insertion" << std::endl;
+	}
+
+	for (unsigned int number_of_elements = min_number_of_elements; number_of_elements <= max_number_of_elements; number_of_elements = static_cast<unsigned int>(static_cast<double>(number_of_elements) * multiply_factor))
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_elements;
+		}
+
+		benchmark_copy<container_type>(number_of_elements, (10000000 / number_of_elements) + 1, erasure_percentage, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,\n,,,\n";
+	}
+}
+
+
+#ifdef PLF_BENCH_ALLOCATOR_SUPPORT
+
+// Level load/unload tests - each "level" fills a colony and a stack, erases a percentage of the colony's elements as gameplay would, then destroys both.
+// Compares the default allocator against sg14::arena_allocator, where the level's memory comes from a bump_arena that is reset in one step on unload:
+
+template <class colony_type, class stack_type>
+inline PLF_FORCE_INLINE unsigned int load_level(colony_type &colony, stack_type &stack, const unsigned int number_of_elements, const unsigned int erasure_percent_expanded)
+{
+	typedef typename colony_type::value_type element_type;
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		colony.insert(element_type(xor_rand() & 255));
+		stack.push(element_type(xor_rand() & 255));
+	}
+
+	for (typename colony_type::iterator current_element = colony.begin(); current_element != colony.end();)
+	{
+		if ((xor_rand() & 127) < erasure_percent_expanded)
+		{
+			current_element = colony.erase(current_element);
+		}
+		else
+		{
+			++current_element;
+		}
+	}
+
+	for (unsigned int element_number = 0; element_number != number_of_elements / 2; ++element_number)
+	{
+		colony.insert(element_type(xor_rand() & 255));
+	}
+
+	return static_cast<unsigned int>(colony.size() + stack.size());
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void benchmark_level_load(const unsigned int number_of_elements, const unsigned int number_of_levels, const unsigned int erasure_percentage, const bool output_csv = false)
+{
+	assert (erasure_percentage < 100); // Ie. lower than 100%
+
+	typedef sg14::arena_allocator<element_type> arena_allocator_type;
+
+	const unsigned int erasure_percent_expanded = static_cast<unsigned int>((static_cast<double>(erasure_percentage) * 1.28) + 0.5);
+	double default_time = 0, arena_time = 0, total_size = 0;
+	plf::nanotimer timer;
+	sg14::bump_arena arena;
+
+	// Dump-runs to get the cache 'warmed up', and to size the arena's chunk list for the first timed level:
+	{
+		plf::colony<element_type> colony;
+		plf::stack<element_type> stack;
+		total_size += load_level(colony, stack, number_of_elements, erasure_percent_expanded);
+	}
+
+	{
+		const arena_allocator_type allocator(arena);
+		plf::colony<element_type, arena_allocator_type> colony(allocator);
+		plf::stack<element_type, arena_allocator_type> stack(allocator);
+		total_size += load_level(colony, stack, number_of_elements, erasure_percent_expanded);
+	}
+
+	arena.reset();
+
+	std::cerr << "Dump size: " << total_size << std::endl;
+	total_size = 0;
+
+
+	for (unsigned int level_number = 0; level_number != number_of_levels; ++level_number)
+	{
+		timer.start();
+		{
+			plf::colony<element_type> colony;
+			plf::stack<element_type> stack;
+			total_size += load_level(colony, stack, number_of_elements, erasure_percent_expanded);
+		}
+		default_time += timer.get_elapsed_us();
+
+		timer.start();
+		{
+			const arena_allocator_type allocator(arena);
+			plf::colony<element_type, arena_allocator_type> colony(allocator);
+			plf::stack<element_type, arena_allocator_type> stack(allocator);
+			total_size += load_level(colony, stack, number_of_elements, erasure_percent_expanded);
+		}
+		arena.reset();
+		arena_time += timer.get_elapsed_us();
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (default_time / number_of_levels) << ", " << (arena_time / number_of_levels) << std::endl;
+	}
+	else
+	{
+		std::cout << "Load and unload level of " << number_of_elements << " elements, default allocator: " << (default_time / number_of_levels) << "us" << std::endl;
+		std::cout << "Load and unload level of " << number_of_elements << " elements, arena allocator: " << (arena_time / number_of_levels) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump size: " << total_size << std::endl; // To prevent compiler from optimizing out the levels
+}
+
+
+
+template <class element_type>
+void benchmark_range_level_load(const unsigned int min_number_of_elements, const unsigned int max_number_of_elements, const double multiply_factor, const unsigned int erasure_percentage, const bool output_csv = false)
+{
+	assert (min_number_of_elements > 1);
+	assert (min_number_of_elements < max_number_of_elements);
+
+	if (output_csv)
+	{
+		std::cout << "Erasure percentage: " << erasure_percentage << "\n\nNumber of elements, Default allocator, Arena allocator" << std::endl;
+	}
+
+	for (unsigned int number_of_elements = min_number_of_elements; number_of_elements <= max_number_of_elements; number_of_elements = static_cast<unsigned int>(static_cast<double>(number_of_elements) * multiply_factor))
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_elements;
+		}
+
+		benchmark_level_load<element_type>(number_of_elements, (10000000 / number_of_elements) + 1, erasure_percentage, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,\n,,,\n";
+	}
+}
+
+
+
+// Huge page tests - iterates over a colony of the given total size in bytes, whose groups come either from std::allocator (scattered 4K pages) or are carved out of 2MB regions by sg14::huge_page_allocator.
+// element_type must have a numeric "number" member (small_struct, large_struct):
+
+template <class colony_type>
+inline PLF_FORCE_INLINE double benchmark_colony_iteration(colony_type &colony, const std::size_t number_of_elements, const unsigned int number_of_runs, const unsigned int erasure_percent_expanded, double &total)
+{
+	typedef typename colony_type::value_type element_type;
+
+	for (std::size_t element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		colony.insert(element_type(xor_rand() & 255));
+	}
+
+	for (typename colony_type::iterator current_element = colony.begin(); current_element != colony.end();)
+	{
+		if ((xor_rand() & 127) < erasure_percent_expanded)
+		{
+			current_element = colony.erase(current_element);
+		}
+		else
+		{
+			++current_element;
+		}
+	}
+
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		for (typename colony_type::iterator current_element = colony.begin(); current_element != colony.end(); ++current_element)
+		{
+			total += current_element->number;
+		}
+	}
+
+	return timer.get_elapsed_ms() / number_of_runs;
+}
+
+
+
+template <class element_type>
+void benchmark_huge_page_iteration(const std::size_t total_bytes, const unsigned int number_of_runs, const unsigned int erasure_percentage)
+{
+	assert (erasure_percentage < 100); // Ie. lower than 100%
+
+	const unsigned int erasure_percent_expanded = static_cast<unsigned int>((static_cast<double>(erasure_percentage) * 1.28) + 0.5);
+	const std::size_t number_of_elements = total_bytes / sizeof(element_type);
+	double total = 0, default_time, huge_page_time;
+
+	{
+		plf::colony<element_type> colony;
+		default_time = benchmark_colony_iteration(colony, number_of_elements, number_of_runs, erasure_percent_expanded, total);
+	}
+
+	{
+		plf::colony<element_type, sg14::huge_page_allocator<element_type> > colony;
+		huge_page_time = benchmark_colony_iteration(colony, number_of_elements, number_of_runs, erasure_percent_expanded, total);
+	}
+
+	const sg14::huge_page_resource &resource = sg14::huge_page_resource::default_resource();
+
+	std::cout << "Iterate " << number_of_elements << " elements (" << (total_bytes >> 20) << "MB), " << erasure_percentage << "% erased, default allocator: " << default_time << "ms" << std::endl;
+	std::cout << "Iterate " << number_of_elements << " elements (" << (total_bytes >> 20) << "MB), " << erasure_percentage << "% erased, huge page allocator: " << huge_page_time << "ms" << std::endl;
+	std::cout << "Huge page regions: " << resource.explicit_huge_page_regions() << " from the explicit huge page pool, " << resource.transparent_huge_page_regions() << " transparent huge page advised" << "\n\n\n";
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the iteration
+}
+
+#endif
+
+
+
+// Stack bulk push/pop tests - batches of elements are pushed and popped back off, as with an undo buffer or a depth-first search frontier. Compares per-element push/pop
+// against range-push/pop_n on plf::stack. element_type must be constructible from, and convertible to, a number:
+
+template <class element_type>
+void benchmark_stack_bulk(const unsigned int batch_size, const unsigned int number_of_batches, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double single_time = 0, bulk_time = 0, total = 0;
+	std::vector<element_type> batch, output(batch_size);
+
+	for (unsigned int element_number = 0; element_number != batch_size; ++element_number)
+	{
+		batch.push_back(element_type(element_number & 255));
+	}
+
+	plf::nanotimer timer;
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		{
+			plf::stack<element_type> stack;
+			timer.start();
+
+			for (unsigned int batch_number = 0; batch_number != number_of_batches; ++batch_number)
+			{
+				for (unsigned int element_number = 0; element_number != batch_size; ++element_number)
+				{
+					stack.push(batch[element_number]);
+				}
+
+				if ((batch_number & 1) == 1) // Pop every second batch back off, so that the stack grows and shrinks
+				{
+					for (unsigned int element_number = 0; element_number != batch_size; ++element_number)
+					{
+						output[element_number] = stack.top();
+						stack.pop();
+					}
+
+					total += static_cast<double>(output[batch_size - 1]);
+				}
+			}
+
+			single_time += timer.get_elapsed_us();
+		}
+
+		{
+			plf::stack<element_type> stack;
+			timer.start();
+
+			for (unsigned int batch_number = 0; batch_number != number_of_batches; ++batch_number)
+			{
+				stack.push(&batch[0], &batch[0] + batch_size);
+
+				if ((batch_number & 1) == 1)
+				{
+					stack.pop_n(batch_size, &output[0]);
+					total += static_cast<double>(output[batch_size - 1]);
+				}
+			}
+
+			bulk_time += timer.get_elapsed_us();
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (single_time / number_of_runs) << ", " << (bulk_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << number_of_batches << " batches of " << batch_size << " elements, per-element push/pop: " << (single_time / number_of_runs) << "us" << std::endl;
+		std::cout << number_of_batches << " batches of " << batch_size << " elements, range push/pop_n: " << (bulk_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_stack_bulk(const unsigned int min_batch_size, const unsigned int max_batch_size, const unsigned int elements_per_run, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Batch size, Per-element push/pop, Range push/pop_n" << std::endl;
+	}
+
+	for (unsigned int batch_size = min_batch_size; batch_size <= max_batch_size; batch_size *= 4)
+	{
+		if (output_csv)
+		{
+			std::cout << batch_size;
+		}
+
+		benchmark_stack_bulk<element_type>(batch_size, elements_per_run / batch_size, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,\n,,\n";
+	}
+}
+
+
+
+// Stack trim policy tests - bursts of elements are pushed and popped back off, with a much larger spike every 16th burst, as with a per-frame scratch stack.
+// Compares the time taken and memory retained between bursts under each plf::stack trim policy. element_type must be constructible from, and convertible to, a number:
+
+template <class element_type>
+void benchmark_stack_trim_policy(const unsigned int burst_size, const unsigned int spike_size, const unsigned int number_of_bursts, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	typedef plf::stack<element_type> stack_type;
+	const typename stack_type::trim_policy policies[4] = {stack_type::trim_never, stack_type::trim_immediately, stack_type::trim_after_idle_pops, stack_type::trim_above_bytes};
+	const char *policy_names[4] = {"trim_never", "trim_immediately", "trim_after_idle_pops", "trim_above_bytes"};
+	const typename stack_type::size_type thresholds[4] = {0, 0, burst_size * 4, burst_size * sizeof(element_type) * 2}; // Idle pops - a few bursts' worth, bytes - roughly two bursts' worth of groups
+	double total = 0;
+	plf::nanotimer timer;
+
+	for (unsigned int policy_number = 0; policy_number != 4; ++policy_number)
+	{
+		double total_time = 0, average_memory_use = 0;
+		unsigned int peak_memory_use = 0;
+
+		for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+		{
+			stack_type stack;
+			stack.set_trim_policy(policies[policy_number], thresholds[policy_number]);
+			double run_memory_use = 0;
+			timer.start();
+
+			for (unsigned int burst_number = 0; burst_number != number_of_bursts; ++burst_number)
+			{
+				const unsigned int number_to_push = ((burst_number & 15) == 15) ? spike_size : burst_size;
+
+				for (unsigned int element_number = 0; element_number != number_to_push; ++element_number)
+				{
+					stack.push(element_type(element_number & 255));
+				}
+
+				for (unsigned int element_number = 0; element_number != number_to_push; ++element_number)
+				{
+					total += static_cast<double>(stack.top());
+					stack.pop();
+				}
+
+				const unsigned int memory_use = approximate_memory_use(stack); // Memory retained between bursts - included in the timing, but trivial next to the bursts themselves
+				run_memory_use += memory_use;
+				peak_memory_use = (memory_use > peak_memory_use) ? memory_use : peak_memory_use;
+			}
+
+			total_time += timer.get_elapsed_us();
+			average_memory_use += run_memory_use / number_of_bursts;
+		}
+
+		if (output_csv)
+		{
+			std::cout << ", " << (total_time / number_of_runs) << ", " << (average_memory_use / number_of_runs) << ", " << peak_memory_use;
+		}
+		else
+		{
+			std::cout << policy_names[policy_number] << ", bursts of " << burst_size << " with spikes of " << spike_size << ": " << (total_time / number_of_runs) << "us, average memory use between bursts = " << (average_memory_use / number_of_runs) << ", peak = " << peak_memory_use << std::endl;
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << std::endl;
+	}
+	else
+	{
+		std::cout << "\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_stack_trim_policy(const unsigned int burst_size, const unsigned int min_spike_size, const unsigned int max_spike_size, const unsigned int number_of_bursts, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Spike size, Never time, Never average memory, Never peak memory, Immediately time, Immediately average memory, Immediately peak memory, Idle pops time, Idle pops average memory, Idle pops peak memory, Above bytes time, Above bytes average memory, Above bytes peak memory" << std::endl;
+	}
+
+	for (unsigned int spike_size = min_spike_size; spike_size <= max_spike_size; spike_size *= 4)
+	{
+		if (output_csv)
+		{
+			std::cout << spike_size;
+		}
+
+		benchmark_stack_trim_policy<element_type>(burst_size, spike_size, number_of_bursts, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,\n,,\n";
+	}
+}
+
+
+#ifdef PLF_BENCH_ALLOCATOR_SUPPORT
+
+// Stack spill tests - a stack of the given total size in bytes is filled and then popped back to empty, as with a depth-first search frontier, either in ordinary memory
+// or with it's groups allocated from a file-backed resource which keeps only resident_bytes in memory. The backing file is created at 'path' (and unlinked straight away).
+// Reports throughput in millions of elements pushed and popped per second. element_type must be constructible from, and convertible to, a number:
+
+template <class stack_type>
+inline PLF_FORCE_INLINE double benchmark_stack_fill_and_drain(stack_type &stack, const std::size_t number_of_elements, const sg14::file_backed_resource *resource, std::size_t &bytes_spilled, double &total)
+{
+	typedef typename stack_type::value_type element_type;
+
+	plf::nanotimer timer;
+	timer.start();
+
+	for (std::size_t element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		stack.push(element_type(element_number & 255));
+	}
+
+	if (resource != NULL && resource->bytes_spilled() > bytes_spilled) // Spilling peaks once the stack is full
+	{
+		bytes_spilled = resource->bytes_spilled();
+	}
+
+	while (!stack.empty())
+	{
+		total += static_cast<double>(stack.top());
+		stack.pop();
+	}
+
+	return timer.get_elapsed_ms();
+}
+
+
+
+template <class element_type>
+void benchmark_stack_spill(const std::size_t total_bytes, const std::size_t resident_bytes, const unsigned int number_of_runs, const char *path)
+{
+	typedef sg14::file_backed_allocator<element_type> file_alloc;
+	typedef plf::stack<element_type, file_alloc> spill_stack_type;
+
+	const std::size_t number_of_elements = total_bytes / sizeof(element_type);
+	double total = 0, default_time = 0, spill_time = 0;
+	std::size_t bytes_spilled = 0;
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		{
+			plf::stack<element_type> stack;
+			default_time += benchmark_stack_fill_and_drain(stack, number_of_elements, NULL, bytes_spilled, total);
+		}
+
+		{
+			sg14::file_backed_resource resource(path, resident_bytes, total_bytes * 2);
+			spill_stack_type stack((file_alloc(resource)));
+			stack.set_trim_policy(spill_stack_type::trim_immediately);
+			spill_time += benchmark_stack_fill_and_drain(stack, number_of_elements, &resource, bytes_spilled, total);
+		}
+	}
+
+	default_time /= number_of_runs;
+	spill_time /= number_of_runs;
+
+	std::cout << "Fill and drain " << number_of_elements << " elements (" << (total_bytes >> 20) << "MB), default allocator: " << default_time << "ms, " << ((number_of_elements * 2) / (default_time * 1000)) << " million elements/s" << std::endl;
+	std::cout << "Fill and drain " << number_of_elements << " elements (" << (total_bytes >> 20) << "MB), file-backed with " << (resident_bytes >> 20) << "MB resident: " << spill_time << "ms, " << ((number_of_elements * 2) / (spill_time * 1000)) << " million elements/s" << std::endl;
+	std::cout << "Spilled to disk at peak: " << (bytes_spilled >> 20) << "MB" << "\n\n\n";
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+#endif
+
+
+#ifdef PLF_BENCH_THREAD_SUPPORT
+
+// Stack contention tests - producer threads push while the main thread pops, as with a job-result accumulator. Compares plf::stack and std::stack behind a mutex
+// against plf::spsc_stack (single producer only) and plf::mpsc_stack (each producer pushing through it's own handle). element_type must be constructible from, and convertible to, a number:
+
+template <class stack_type>
+inline PLF_FORCE_INLINE double benchmark_locked_stack_contention(const unsigned int number_of_producers, const unsigned int elements_per_producer, double &total)
+{
+	typedef typename stack_type::value_type element_type;
+
+	stack_type stack;
+	std::mutex stack_mutex;
+	std::vector<std::thread> producers;
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+	{
+		producers.push_back(std::thread([&stack, &stack_mutex, elements_per_producer]()
+		{
+			for (unsigned int element_number = 0; element_number != elements_per_producer; ++element_number)
+			{
+				std::lock_guard<std::mutex> lock(stack_mutex);
+				stack.push(element_type(element_number & 255));
+			}
+		}));
+	}
+
+	for (unsigned int remaining = number_of_producers * elements_per_producer; remaining != 0;)
+	{
+		std::lock_guard<std::mutex> lock(stack_mutex);
+
+		if (!stack.empty())
+		{
+			total += static_cast<double>(stack.top());
+			stack.pop();
+			--remaining;
+		}
+	}
+
+	for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+	{
+		producers[producer_number].join();
+	}
+
+	return timer.get_elapsed_us();
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE double benchmark_spsc_stack_contention(const unsigned int number_of_elements, double &total)
+{
+	plf::spsc_stack<element_type> stack;
+	element_type element;
+	plf::nanotimer timer;
+	timer.start();
+
+	std::thread producer([&stack, number_of_elements]()
+	{
+		for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+		{
+			stack.push(element_type(element_number & 255));
+		}
+	});
+
+	for (unsigned int remaining = number_of_elements; remaining != 0;)
+	{
+		if (stack.try_pop(element))
+		{
+			total += static_cast<double>(element);
+			--remaining;
+		}
+	}
+
+	producer.join();
+	return timer.get_elapsed_us();
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE double benchmark_mpsc_stack_contention(const unsigned int number_of_producers, const unsigned int elements_per_producer, double &total)
+{
+	plf::mpsc_stack<element_type> stack;
+	std::vector<std::thread> producers;
+	element_type element;
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+	{
+		producers.push_back(std::thread([&stack, elements_per_producer]()
+		{
+			typename plf::mpsc_stack<element_type>::producer handle(stack);
+
+			for (unsigned int element_number = 0; element_number != elements_per_producer; ++element_number)
+			{
+				handle.push(element_type(element_number & 255));
+			}
+		}));
+	}
+
+	for (unsigned int remaining = number_of_producers * elements_per_producer; remaining != 0;)
+	{
+		if (stack.try_pop(element))
+		{
+			total += static_cast<double>(element);
+			--remaining;
+		}
+	}
+
+	for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+	{
+		producers[producer_number].join();
+	}
+
+	return timer.get_elapsed_us();
+}
+
+
+
+template <class element_type>
+void benchmark_stack_contention(const unsigned int number_of_producers, const unsigned int elements_per_producer, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double plf_time = 0, std_time = 0, spsc_time = 0, mpsc_time = 0, total = 0;
+
+	// Dump-run to get the cache 'warmed up' and the threads' stacks mapped:
+	benchmark_locked_stack_contention<plf::stack<element_type> >(number_of_producers, elements_per_producer, total);
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		plf_time += benchmark_locked_stack_contention<plf::stack<element_type> >(number_of_producers, elements_per_producer, total);
+		std_time += benchmark_locked_stack_contention<std::stack<element_type> >(number_of_producers, elements_per_producer, total);
+
+		if (number_of_producers == 1)
+		{
+			spsc_time += benchmark_spsc_stack_contention<element_type>(elements_per_producer, total);
+		}
+
+		mpsc_time += benchmark_mpsc_stack_contention<element_type>(number_of_producers, elements_per_producer, total);
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (plf_time / number_of_runs) << ", " << (std_time / number_of_runs) << ", ";
+
+		if (number_of_producers == 1)
+		{
+			std::cout << (spsc_time / number_of_runs);
+		}
+
+		std::cout << ", " << (mpsc_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << number_of_producers << " producer(s) pushing " << elements_per_producer << " elements each, mutex-wrapped plf::stack: " << (plf_time / number_of_runs) << "us" << std::endl;
+		std::cout << number_of_producers << " producer(s) pushing " << elements_per_producer << " elements each, mutex-wrapped std::stack: " << (std_time / number_of_runs) << "us" << std::endl;
+
+		if (number_of_producers == 1)
+		{
+			std::cout << number_of_producers << " producer(s) pushing " << elements_per_producer << " elements each, plf::spsc_stack: " << (spsc_time / number_of_runs) << "us" << std::endl;
+		}
+
+		std::cout << number_of_producers << " producer(s) pushing " << elements_per_producer << " elements each, plf::mpsc_stack: " << (mpsc_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_stack_contention(const unsigned int max_number_of_producers, const unsigned int elements_per_producer, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Number of producers, Mutex plf::stack, Mutex std::stack, plf::spsc_stack, plf::mpsc_stack" << std::endl;
+	}
+
+	for (unsigned int number_of_producers = 1; number_of_producers <= max_number_of_producers; number_of_producers *= 2)
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_producers;
+		}
+
+		benchmark_stack_contention<element_type>(number_of_producers, elements_per_producer, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,\n,,,\n";
+	}
+}
+
+
+
+
+// Fork-join tests - recursive fib and parallel quicksort on plf::work_stealing_pool, with it's per-worker deques being either plf::work_stealing_deque
+// or a mutex-protected std::deque (owner pushes and pops at the back, thieves take from the front):
+
+class locked_task_deque
+{
+private:
+	std::mutex mutex;
+	std::deque<plf::pool_task *> tasks;
+
+public:
+	void push(plf::pool_task * const task)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(task);
+	}
+
+	bool pop(plf::pool_task * &task)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (tasks.empty())
+		{
+			return false;
+		}
+
+		task = tasks.back();
+		tasks.pop_back();
+		return true;
+	}
+
+	bool steal(plf::pool_task * &task)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (tasks.empty())
+		{
+			return false;
+		}
+
+		task = tasks.front();
+		tasks.pop_front();
+		return true;
+	}
+};
+
+
+
+template <class pool_type>
+void parallel_fib(pool_type &pool, const unsigned int n, unsigned long long &result)
+{
+	if (n < 8) // Serial cutoff - low, so that task spawning and stealing dominate
+	{
+		unsigned long long previous = 0, current = 1;
+
+		for (unsigned int counter = 0; counter != n; ++counter)
+		{
+			const unsigned long long next = previous + current;
+			previous = current;
+			current = next;
+		}
+
+		result = previous;
+		return;
+	}
+
+	unsigned long long first, second;
+	plf::task_group group;
+	pool.spawn(group, [&pool, n, &first]() { parallel_fib(pool, n - 1, first); });
+	parallel_fib(pool, n - 2, second);
+	pool.wait(group);
+	result = first + second;
+}
+
+
+
+template <class pool_type>
+void parallel_quicksort(pool_type &pool, unsigned int * const first, unsigned int * const last)
+{
+	if (last - first < 2048)
+	{
+		std::sort(first, last);
+		return;
+	}
+
+	const unsigned int pivot = first[(last - first) / 2];
+	unsigned int * const middle1 = std::partition(first, last, [pivot](const unsigned int value) { return value < pivot; });
+	unsigned int * const middle2 = std::partition(middle1, last, [pivot](const unsigned int value) { return !(pivot < value); });
+
+	plf::task_group group;
+	pool.spawn(group, [&pool, first, middle1]() { parallel_quicksort(pool, first, middle1); });
+	parallel_quicksort(pool, middle2, last);
+	pool.wait(group);
+}
+
+
+
+template <class pool_type>
+inline PLF_FORCE_INLINE void benchmark_pool_fork_join(const unsigned int number_of_threads, const unsigned int fib_n, std::vector<unsigned int> &sort_data, double &fib_time, double &sort_time, double &total)
+{
+	pool_type pool(number_of_threads);
+	std::vector<unsigned int> data(sort_data);
+	unsigned long long result;
+	plf::nanotimer timer;
+
+	timer.start();
+	parallel_fib(pool, fib_n, result);
+	fib_time += timer.get_elapsed_us();
+
+	timer.start();
+	parallel_quicksort(pool, &data[0], &data[0] + data.size());
+	sort_time += timer.get_elapsed_us();
+
+	total += static_cast<double>(result) + data[data.size() / 2];
+}
+
+
+
+void benchmark_fork_join(const unsigned int number_of_threads, const unsigned int fib_n, const unsigned int number_of_sort_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double ws_fib_time = 0, ws_sort_time = 0, locked_fib_time = 0, locked_sort_time = 0, total = 0;
+	std::vector<unsigned int> sort_data;
+
+	for (unsigned int element_number = 0; element_number != number_of_sort_elements; ++element_number)
+	{
+		sort_data.push_back(xor_rand());
+	}
+
+	// Dump-run to get the cache 'warmed up' and the threads' stacks mapped:
+	benchmark_pool_fork_join<plf::work_stealing_pool<> >(number_of_threads, fib_n, sort_data, ws_fib_time, ws_sort_time, total);
+	ws_fib_time = ws_sort_time = 0;
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		benchmark_pool_fork_join<plf::work_stealing_pool<> >(number_of_threads, fib_n, sort_data, ws_fib_time, ws_sort_time, total);
+		benchmark_pool_fork_join<plf::work_stealing_pool<locked_task_deque> >(number_of_threads, fib_n, sort_data, locked_fib_time, locked_sort_time, total);
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (ws_fib_time / number_of_runs) << ", " << (locked_fib_time / number_of_runs) << ", " << (ws_sort_time / number_of_runs) << ", " << (locked_sort_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << number_of_threads << " thread(s), fib(" << fib_n << "), plf::work_stealing_deque: " << (ws_fib_time / number_of_runs) << "us" << std::endl;
+		std::cout << number_of_threads << " thread(s), fib(" << fib_n << "), mutex-wrapped std::deque: " << (locked_fib_time / number_of_runs) << "us" << std::endl;
+		std::cout << number_of_threads << " thread(s), quicksort of " << number_of_sort_elements << " elements, plf::work_stealing_deque: " << (ws_sort_time / number_of_runs) << "us" << std::endl;
+		std::cout << number_of_threads << " thread(s), quicksort of " << number_of_sort_elements << " elements, mutex-wrapped std::deque: " << (locked_sort_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the results
+}
+
+
+
+void benchmark_range_fork_join(const unsigned int max_number_of_threads, const unsigned int fib_n, const unsigned int number_of_sort_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Number of threads, Fib plf::work_stealing_deque, Fib mutex std::deque, Quicksort plf::work_stealing_deque, Quicksort mutex std::deque" << std::endl;
+	}
+
+	for (unsigned int number_of_threads = 1; number_of_threads <= max_number_of_threads; number_of_threads *= 2)
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_threads;
+		}
+
+		benchmark_fork_join(number_of_threads, fib_n, number_of_sort_elements, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,\n,,,,\n";
+	}
+}
+
+
+#endif
+
+
+
+#ifdef PLF_BENCH_RING_SUPPORT
+
+// ring_span tests - a single thread pushes elements (overwriting the oldest once the ring is full), sums the ring by iteration, then pops until empty.
+// Each run is made at a power-of-two capacity (where indices wrap by masking) and at one less (where they wrap by comparison):
+
+template <class ring_type>
+inline PLF_FORCE_INLINE void benchmark_ring_phases(ring_type &ring, const unsigned int number_of_elements, double &push_time, double &iterate_time, double &pop_time, double &total)
+{
+	typedef typename ring_type::value_type element_type;
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		ring.push_back(element_type(element_number & 255));
+	}
+
+	push_time += timer.get_elapsed_us();
+	timer.start();
+
+	// Summing into a local, as whether the compiler keeps total (a reference) in a register across the loop otherwise depends on the rest of the calling function:
+	double sum = 0;
+
+	for (typename ring_type::iterator current = ring.begin(); current != ring.end(); ++current)
+	{
+		sum += static_cast<double>(*current);
+	}
+
+	iterate_time += timer.get_elapsed_us();
+	timer.start();
+
+	while (!ring.empty())
+	{
+		sum += static_cast<double>(ring.pop_front());
+	}
+
+	pop_time += timer.get_elapsed_us();
+	total += sum;
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void benchmark_ring_span_phases(const unsigned int capacity, const unsigned int number_of_elements, double &push_time, double &iterate_time, double &pop_time, double &total)
+{
+	std::vector<element_type> storage(capacity, element_type(0));
+	sg14::ring_span<element_type> ring(storage.begin(), storage.end());
+	benchmark_ring_phases(ring, number_of_elements, push_time, iterate_time, pop_time, total);
+}
+
+
+
+template <class element_type>
+void benchmark_ring_span(const unsigned int capacity, const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double push_time = 0, iterate_time = 0, pop_time = 0, odd_push_time = 0, odd_iterate_time = 0, odd_pop_time = 0, total = 0;
+
+	// Dump-run to get the cache 'warmed up':
+	benchmark_ring_span_phases<element_type>(capacity, number_of_elements, push_time, iterate_time, pop_time, total);
+	push_time = iterate_time = pop_time = 0;
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		benchmark_ring_span_phases<element_type>(capacity, number_of_elements, push_time, iterate_time, pop_time, total);
+		benchmark_ring_span_phases<element_type>(capacity - 1, number_of_elements, odd_push_time, odd_iterate_time, odd_pop_time, total);
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (push_time / number_of_runs) << ", " << (iterate_time / number_of_runs) << ", " << (pop_time / number_of_runs) << ", " << (odd_push_time / number_of_runs) << ", " << (odd_iterate_time / number_of_runs) << ", " << (odd_pop_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Capacity " << capacity << ", push " << number_of_elements << " elements: " << (push_time / number_of_runs) << "us, iterate: " << (iterate_time / number_of_runs) << "us, pop: " << (pop_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Capacity " << (capacity - 1) << ", push " << number_of_elements << " elements: " << (odd_push_time / number_of_runs) << "us, iterate: " << (odd_iterate_time / number_of_runs) << "us, pop: " << (odd_pop_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_ring_span(const unsigned int min_capacity, const unsigned int max_capacity, const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Capacity, Push, Iterate, Pop, Push (capacity - 1), Iterate (capacity - 1), Pop (capacity - 1)" << std::endl;
+	}
+
+	for (unsigned int capacity = min_capacity; capacity <= max_capacity; capacity *= 4)
+	{
+		if (output_csv)
+		{
+			std::cout << capacity;
+		}
+
+		benchmark_ring_span<element_type>(capacity, number_of_elements, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,,,\n,,,,,,\n";
+	}
+}
+
+
+
+
+// Owning ring tests - as above, comparing ring_span over a std::array (index wrapping chosen at runtime) against static_ring (chosen at compile time) and dynamic_ring, at one capacity:
+
+template <class element_type, std::size_t capacity>
+void benchmark_static_ring(const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double span_push = 0, span_iterate = 0, span_pop = 0, static_push = 0, static_iterate = 0, static_pop = 0, dynamic_push = 0, dynamic_iterate = 0, dynamic_pop = 0, total = 0;
+
+	for (unsigned int run_number = 0; run_number != number_of_runs + 1; ++run_number)
+	{
+		if (run_number == 1) // Discard the first run, to get the cache 'warmed up'
+		{
+			span_push = span_iterate = span_pop = static_push = static_iterate = static_pop = dynamic_push = dynamic_iterate = dynamic_pop = 0;
+		}
+
+		{
+			std::array<element_type, capacity> storage;
+			sg14::ring_span<element_type> ring(storage.begin(), storage.end());
+			benchmark_ring_phases(ring, number_of_elements, span_push, span_iterate, span_pop, total);
+		}
+
+		{
+			sg14::static_ring<element_type, capacity> ring;
+			benchmark_ring_phases(ring, number_of_elements, static_push, static_iterate, static_pop, total);
+		}
+
+		{
+			sg14::dynamic_ring<element_type> ring(capacity);
+			benchmark_ring_phases(ring, number_of_elements, dynamic_push, dynamic_iterate, dynamic_pop, total);
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << capacity << ", " << (span_push / number_of_runs) << ", " << (span_iterate / number_of_runs) << ", " << (span_pop / number_of_runs) << ", " << (static_push / number_of_runs) << ", " << (static_iterate / number_of_runs) << ", " << (static_pop / number_of_runs) << ", " << (dynamic_push / number_of_runs) << ", " << (dynamic_iterate / number_of_runs) << ", " << (dynamic_pop / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Capacity " << capacity << ", ring_span over std::array, push " << number_of_elements << " elements: " << (span_push / number_of_runs) << "us, iterate: " << (span_iterate / number_of_runs) << "us, pop: " << (span_pop / number_of_runs) << "us" << std::endl;
+		std::cout << "Capacity " << capacity << ", static_ring, push " << number_of_elements << " elements: " << (static_push / number_of_runs) << "us, iterate: " << (static_iterate / number_of_runs) << "us, pop: " << (static_pop / number_of_runs) << "us" << std::endl;
+		std::cout << "Capacity " << capacity << ", dynamic_ring, push " << number_of_elements << " elements: " << (dynamic_push / number_of_runs) << "us, iterate: " << (dynamic_iterate / number_of_runs) << "us, pop: " << (dynamic_pop / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+
+// ring_span block tests - blocks of samples are pushed into a ring and read back out, as with an audio or telemetry buffer. Compares per-element push_back and pop_front
+// against bulk push_back(first, last), plus either pop_front_n(n, out) into a block or reading in place through contiguous_regions() followed by pop_front_n(n).
+// Each block read is summed, standing in for the consumer's processing:
+
+template <class element_type>
+void benchmark_ring_span_blocks(const unsigned int capacity, const unsigned int block_size, const unsigned int number_of_blocks, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	std::vector<element_type> storage(capacity, element_type(0)), input(block_size, element_type(0)), output(block_size, element_type(0));
+	double single_time = 0, bulk_time = 0, in_place_time = 0, total = 0;
+	plf::nanotimer timer;
+
+	for (unsigned int index = 0; index != block_size; ++index)
+	{
+		input[index] = element_type(index & 255);
+	}
+
+	// Blocks are pushed two at a time before one is read, so that the ring's contents drift across the end of it's storage:
+	for (unsigned int run_number = 0; run_number != number_of_runs + 1; ++run_number)
+	{
+		if (run_number == 1) // Discard the first run, to get the cache 'warmed up'
+		{
+			single_time = bulk_time = in_place_time = 0;
+		}
+
+		{
+			sg14::ring_span<element_type> ring(storage.begin(), storage.end());
+			timer.start();
+
+			for (unsigned int block_number = 0; block_number != number_of_blocks; ++block_number)
+			{
+				for (unsigned int index = 0; index != block_size; ++index)
+				{
+					ring.push_back(input[index]);
+				}
+
+				if (block_number % 2 == 1 || ring.size() + block_size > capacity)
+				{
+					element_type sum = element_type(0);
+
+					for (unsigned int index = 0; index != block_size; ++index)
+					{
+						output[index] = ring.pop_front();
+					}
+
+					for (unsigned int index = 0; index != block_size; ++index)
+					{
+						sum += output[index];
+					}
+
+					total += static_cast<double>(sum);
+				}
+			}
+
+			single_time += timer.get_elapsed_us();
+		}
+
+		{
+			sg14::ring_span<element_type> ring(storage.begin(), storage.end());
+			timer.start();
+
+			for (unsigned int block_number = 0; block_number != number_of_blocks; ++block_number)
+			{
+				ring.push_back(input.begin(), input.end());
+
+				if (block_number % 2 == 1 || ring.size() + block_size > capacity)
+				{
+					element_type sum = element_type(0);
+					ring.pop_front_n(block_size, output.begin());
+
+					for (unsigned int index = 0; index != block_size; ++index)
+					{
+						sum += output[index];
+					}
+
+					total += static_cast<double>(sum);
+				}
+			}
+
+			bulk_time += timer.get_elapsed_us();
+		}
+
+		{
+			sg14::ring_span<element_type> ring(storage.begin(), storage.end());
+			timer.start();
+
+			for (unsigned int block_number = 0; block_number != number_of_blocks; ++block_number)
+			{
+				ring.push_back(input.begin(), input.end());
+
+				if (block_number % 2 == 1 || ring.size() + block_size > capacity)
+				{
+					const auto regions = ring.contiguous_regions();
+					const unsigned int first_run = (regions[0].second < block_size) ? static_cast<unsigned int>(regions[0].second) : block_size;
+					element_type sum = element_type(0);
+
+					for (unsigned int index = 0; index != first_run; ++index)
+					{
+						sum += regions[0].first[index];
+					}
+
+					for (unsigned int index = 0; index != block_size - first_run; ++index)
+					{
+						sum += regions[1].first[index];
+					}
+
+					ring.pop_front_n(block_size);
+					total += static_cast<double>(sum);
+				}
+			}
+
+			in_place_time += timer.get_elapsed_us();
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (single_time / number_of_runs) << ", " << (bulk_time / number_of_runs) << ", " << (in_place_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Blocks of " << block_size << ", per-element push_back/pop_front: " << (single_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Blocks of " << block_size << ", bulk push_back/pop_front_n: " << (bulk_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Blocks of " << block_size << ", bulk push_back, in-place read via contiguous_regions: " << (in_place_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_ring_span_blocks(const unsigned int capacity, const unsigned int min_block_size, const unsigned int max_block_size, const unsigned int elements_per_run, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Block size, Per-element, Bulk, Bulk with in-place read" << std::endl;
+	}
+
+	for (unsigned int block_size = min_block_size; block_size <= max_block_size; block_size *= 2)
+	{
+		if (output_csv)
+		{
+			std::cout << block_size;
+		}
+
+		benchmark_ring_span_blocks<element_type>(capacity, block_size, elements_per_run / block_size, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,\n,,,\n";
+	}
+}
+
+
+
+
+// Mirrored ring tests - a byte stream of length-prefixed records arrives in fixed-size chunks (as from a socket), and each complete record is parsed out of the ring,
+// summing it's payload in place of real parsing. Chunks do not line up with records, so records regularly wrap around the end of the ring's storage.
+// sg14::ring_span<char> has to handle the wrap by hand - records lying across the two contiguous_regions() are copied into a scratch buffer before parsing - whereas
+// sg14::mirrored_ring presents every record contiguously, and the producer writes each chunk into it with a single memcpy:
+
+inline void benchmark_mirrored_ring(const unsigned int capacity, const unsigned int max_record_size, const unsigned int chunk_size, const unsigned int stream_size, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	sg14::mirrored_ring mirrored(capacity);
+	std::vector<char> storage(mirrored.capacity()), scratch(max_record_size + 2), stream;
+	double ring_span_time = 0, mirrored_time = 0, total = 0;
+	plf::nanotimer timer;
+
+	// Records of between half and all of max_record_size payload bytes, each after a two byte little-endian length:
+	stream.reserve(stream_size + max_record_size + 2);
+
+	while (stream.size() < stream_size)
+	{
+		const unsigned int length = (max_record_size / 2) + rand_within(max_record_size / 2 + 1);
+		stream.push_back(static_cast<char>(length & 255));
+		stream.push_back(static_cast<char>(length >> 8));
+
+		for (unsigned int index = 0; index != length; ++index)
+		{
+			stream.push_back(static_cast<char>(rand_within(256)));
+		}
+	}
+
+	for (unsigned int run_number = 0; run_number != number_of_runs + 1; ++run_number)
+	{
+		if (run_number == 1) // Discard the first run, to get the cache 'warmed up'
+		{
+			ring_span_time = mirrored_time = 0;
+		}
+
+		{
+			sg14::ring_span<char> ring(storage.begin(), storage.end());
+			std::size_t position = 0;
+			unsigned int sum = 0;
+			timer.start();
+
+			while (position != stream.size())
+			{
+				std::size_t count = stream.size() - position;
+				count = (count < chunk_size) ? count : chunk_size;
+				count = (count < ring.capacity() - ring.size()) ? count : ring.capacity() - ring.size();
+				ring.push_back(stream.begin() + position, stream.begin() + position + count);
+				position += count;
+
+				while (ring.size() >= 2)
+				{
+					auto regions = ring.contiguous_regions();
+					std::size_t record_size = 2;
+					const unsigned char *record = reinterpret_cast<const unsigned char *>(regions[0].first);
+
+					if (regions[0].second < 2)
+					{
+						scratch[0] = regions[0].first[0];
+						scratch[1] = regions[1].first[0];
+						record = reinterpret_cast<const unsigned char *>(scratch.data());
+					}
+
+					record_size += record[0] | (static_cast<std::size_t>(record[1]) << 8);
+
+					if (ring.size() < record_size)
+					{
+						break;
+					}
+
+					if (regions[0].second < record_size)
+					{
+						std::copy(regions[0].first, regions[0].first + regions[0].second, scratch.begin());
+						std::copy(regions[1].first, regions[1].first + (record_size - regions[0].second), scratch.begin() + regions[0].second);
+						record = reinterpret_cast<const unsigned char *>(scratch.data());
+					}
+
+					for (std::size_t index = 2; index != record_size; ++index)
+					{
+						sum += record[index];
+					}
+
+					ring.pop_front_n(record_size);
+				}
+			}
+
+			ring_span_time += timer.get_elapsed_us();
+			total += sum;
+		}
+
+		{
+			std::size_t position = 0;
+			unsigned int sum = 0;
+			timer.start();
+
+			while (position != stream.size())
+			{
+				std::size_t count = stream.size() - position;
+				count = (count < chunk_size) ? count : chunk_size;
+				count = (count < mirrored.free_space()) ? count : mirrored.free_space();
+				std::memcpy(mirrored.write_data(), stream.data() + position, count);
+				mirrored.commit(count);
+				position += count;
+
+				while (mirrored.size() >= 2)
+				{
+					const unsigned char *record = reinterpret_cast<const unsigned char *>(mirrored.read_data());
+					const std::size_t record_size = 2 + (record[0] | (static_cast<std::size_t>(record[1]) << 8));
+
+					if (mirrored.size() < record_size)
+					{
+						break;
+					}
+
+					for (std::size_t index = 2; index != record_size; ++index)
+					{
+						sum += record[index];
+					}
+
+					mirrored.consume(record_size);
+				}
+			}
+
+			mirrored_time += timer.get_elapsed_us();
+			total += sum;
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (ring_span_time / number_of_runs) << ", " << (mirrored_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Records of up to " << max_record_size << " bytes, ring_span with manual wrap handling: " << (ring_span_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Records of up to " << max_record_size << " bytes, mirrored_ring: " << (mirrored_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the parsing
+}
+
+
+
+inline void benchmark_range_mirrored_ring(const unsigned int capacity, const unsigned int min_record_size, const unsigned int max_record_size, const unsigned int chunk_size, const unsigned int stream_size, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Maximum record size, ring_span with manual wrap handling, mirrored_ring" << std::endl;
+	}
+
+	for (unsigned int record_size = min_record_size; record_size <= max_record_size; record_size *= 2)
+	{
+		if (output_csv)
+		{
+			std::cout << record_size;
+		}
+
+		benchmark_mirrored_ring(capacity, record_size, chunk_size, stream_size, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,\n,,\n";
+	}
+}
+
+
+
+
+// Ring tests - one producer thread hands elements to one consumer thread through a fixed-capacity ring. Compares sg14::ring_span behind a mutex and condition variables
+// (as in SG14_test's thread_communication_test) against sg14::spsc_ring_span. Throughput streams elements through a single ring; latency bounces one element at a time
+// between two threads through a pair of rings, so that each round trip includes two hand-overs. element_type must be constructible from, and convertible to, a number:
+
+template <class element_type>
+class locked_ring_span
+{
+public:
+	typedef element_type value_type;
+
+	template <class iterator_type>
+	locked_ring_span(iterator_type begin, iterator_type end): ring(begin, end)
+	{}
+
+	void push_back(const element_type &element)
+	{
+		std::unique_lock<std::mutex> lock(ring_mutex);
+		not_full.wait(lock, [this] { return !ring.full(); });
+		ring.push_back(element);
+		lock.unlock();
+		not_empty.notify_one();
+	}
+
+	void pop_front(element_type &element)
+	{
+		std::unique_lock<std::mutex> lock(ring_mutex);
+		not_empty.wait(lock, [this] { return !ring.empty(); });
+		element = ring.pop_front();
+		lock.unlock();
+		not_full.notify_one();
+	}
+
+private:
+	sg14::ring_span<element_type> ring;
+	std::mutex ring_mutex;
+	std::condition_variable not_empty, not_full;
+};
+
+
+
+// Blocking push and pop for each ring type - the lock-free rings spin, yielding, while full or empty:
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_push(locked_ring_span<element_type> &ring, const element_type &element)
+{
+	ring.push_back(element);
+}
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_pop(locked_ring_span<element_type> &ring, element_type &element)
+{
+	ring.pop_front(element);
+}
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_push(sg14::spsc_ring_span<element_type> &ring, const element_type &element)
+{
+	while (!ring.try_push_back(element))
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_pop(sg14::spsc_ring_span<element_type> &ring, element_type &element)
+{
+	while (!ring.try_pop_front(element))
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_push(sg14::mpmc_ring_span<element_type> &ring, const element_type &element)
+{
+	while (!ring.try_push(element))
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE void ring_pop(sg14::mpmc_ring_span<element_type> &ring, element_type &element)
+{
+	while (!ring.try_pop(element))
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+
+template <class ring, class wait_strategy>
+inline PLF_FORCE_INLINE void ring_push(sg14::blocking_ring<ring, wait_strategy> &blocking, const typename ring::value_type &element)
+{
+	blocking.push(element);
+}
+
+
+template <class ring, class wait_strategy>
+inline PLF_FORCE_INLINE void ring_pop(sg14::blocking_ring<ring, wait_strategy> &blocking, typename ring::value_type &element)
+{
+	blocking.pop(element);
+}
+
+
+
+// The storage each ring type spans:
+
+template <class ring_type>
+struct ring_storage
+{
+	typedef typename ring_type::value_type type;
+};
+
+
+template <class element_type>
+struct ring_storage<sg14::mpmc_ring_span<element_type> >
+{
+	typedef typename sg14::mpmc_ring_span<element_type>::slot_type type;
+};
+
+
+
+template <template <class> class ring_type, class element_type>
+inline PLF_FORCE_INLINE double benchmark_ring_throughput(const unsigned int capacity, const unsigned int number_of_elements, double &total)
+{
+	std::vector<typename ring_storage<ring_type<element_type> >::type> storage(capacity);
+	ring_type<element_type> ring(storage.begin(), storage.end());
+	element_type element(0);
+	plf::nanotimer timer;
+	timer.start();
+
+	std::thread producer([&ring, number_of_elements]()
+	{
+		for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+		{
+			ring_push(ring, element_type(element_number & 255));
+		}
+	});
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		ring_pop(ring, element);
+		total += static_cast<double>(element);
+	}
+
+	producer.join();
+	return timer.get_elapsed_us();
+}
+
+
+
+template <template <class> class ring_type, class element_type>
+inline PLF_FORCE_INLINE double benchmark_ring_latency(const unsigned int capacity, const unsigned int number_of_round_trips, double &total)
+{
+	std::vector<typename ring_storage<ring_type<element_type> >::type> request_storage(capacity), reply_storage(capacity);
+	ring_type<element_type> requests(request_storage.begin(), request_storage.end()), replies(reply_storage.begin(), reply_storage.end());
+	element_type element(0);
+	plf::nanotimer timer;
+
+	std::thread echo([&requests, &replies, number_of_round_trips]()
+	{
+		element_type request(0);
+
+		for (unsigned int trip_number = 0; trip_number != number_of_round_trips; ++trip_number)
+		{
+			ring_pop(requests, request);
+			ring_push(replies, request);
+		}
+	});
+
+	timer.start();
+
+	for (unsigned int trip_number = 0; trip_number != number_of_round_trips; ++trip_number)
+	{
+		ring_push(requests, element_type(trip_number & 255));
+		ring_pop(replies, element);
+		total += static_cast<double>(element);
+	}
+
+	const double elapsed = timer.get_elapsed_us();
+	echo.join();
+	return elapsed;
+}
+
+
+
+template <class element_type>
+void benchmark_ring(const unsigned int capacity, const unsigned int number_of_elements, const unsigned int number_of_round_trips, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double locked_time = 0, spsc_time = 0, locked_latency = 0, spsc_latency = 0, total = 0;
+
+	// Dump-run to get the cache 'warmed up' and the threads' stacks mapped:
+	benchmark_ring_throughput<locked_ring_span, element_type>(capacity, number_of_elements, total);
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		locked_time += benchmark_ring_throughput<locked_ring_span, element_type>(capacity, number_of_elements, total);
+		spsc_time += benchmark_ring_throughput<sg14::spsc_ring_span, element_type>(capacity, number_of_elements, total);
+		locked_latency += benchmark_ring_latency<locked_ring_span, element_type>(capacity, number_of_round_trips, total);
+		spsc_latency += benchmark_ring_latency<sg14::spsc_ring_span, element_type>(capacity, number_of_round_trips, total);
+	}
+
+	// Millions of elements per second, and nanoseconds per round trip:
+	locked_time = static_cast<double>(number_of_elements) * number_of_runs / locked_time;
+	spsc_time = static_cast<double>(number_of_elements) * number_of_runs / spsc_time;
+	locked_latency = locked_latency * 1000 / (static_cast<double>(number_of_round_trips) * number_of_runs);
+	spsc_latency = spsc_latency * 1000 / (static_cast<double>(number_of_round_trips) * number_of_runs);
+
+	if (output_csv)
+	{
+		std::cout << ", " << locked_time << ", " << spsc_time << ", " << locked_latency << ", " << spsc_latency << std::endl;
+	}
+	else
+	{
+		std::cout << "Capacity " << capacity << ", mutex-wrapped sg14::ring_span: " << locked_time << " million elements/s, " << locked_latency << "ns round trip" << std::endl;
+		std::cout << "Capacity " << capacity << ", sg14::spsc_ring_span: " << spsc_time << " million elements/s, " << spsc_latency << "ns round trip" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_ring(const unsigned int min_capacity, const unsigned int max_capacity, const unsigned int number_of_elements, const unsigned int number_of_round_trips, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Capacity, Mutex ring_span throughput (M/s), spsc_ring_span throughput (M/s), Mutex ring_span round trip (ns), spsc_ring_span round trip (ns)" << std::endl;
+	}
+
+	for (unsigned int capacity = min_capacity; capacity <= max_capacity; capacity *= 4)
+	{
+		if (output_csv)
+		{
+			std::cout << capacity;
+		}
+
+		benchmark_ring<element_type>(capacity, number_of_elements, number_of_round_trips, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,\n,,,,\n";
+	}
+}
+
+
+
+
+// Ring wait strategy tests - a producer thread sends timestamped elements to a consumer thread blocked in pop, pausing for gap_us microseconds between elements so that the
+// consumer runs out of work and has to wait (and, with the futex strategy or a condition variable, sleep) for each one. Reports the 50th and 99th percentile hand-off latency,
+// from just before the push to just after the pop, for the mutex and condition variable ring_span, and for sg14::blocking_ring over an spsc_ring_span with each wait strategy:
+
+template <class ring_type>
+inline void benchmark_ring_handoff(const unsigned int capacity, const unsigned int number_of_elements, const unsigned int gap_us, std::vector<double> &latencies)
+{
+	typedef std::chrono::steady_clock clock;
+	std::vector<std::uint64_t> storage(capacity);
+	ring_type ring(storage.begin(), storage.end());
+
+	std::thread producer([&ring, number_of_elements, gap_us]()
+	{
+		for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+		{
+			if (gap_us != 0)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(gap_us));
+			}
+
+			ring_push(ring, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count()));
+		}
+	});
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		std::uint64_t sent = 0;
+		ring_pop(ring, sent);
+		const std::uint64_t received = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count());
+		latencies.push_back(static_cast<double>(received - sent));
+	}
+
+	producer.join();
+}
+
+
+
+inline double percentile(std::vector<double> &values, const unsigned int percent)
+{
+	std::sort(values.begin(), values.end());
+	return values.empty() ? 0 : values[(values.size() - 1) * percent / 100];
+}
+
+
+
+inline void benchmark_ring_wait_strategies(const unsigned int capacity, const unsigned int number_of_elements, const unsigned int gap_us, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	const char *names[4] = { "mutex and condition_variable ring_span", "blocking_ring, busy_spin_wait", "blocking_ring, spin_yield_wait", "blocking_ring, spin_futex_wait" };
+	std::vector<double> latencies[4];
+
+	// Dump-run to get the threads' stacks mapped:
+	benchmark_ring_handoff<locked_ring_span<std::uint64_t> >(capacity, number_of_elements, gap_us, latencies[0]);
+	latencies[0].clear();
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		benchmark_ring_handoff<locked_ring_span<std::uint64_t> >(capacity, number_of_elements, gap_us, latencies[0]);
+		benchmark_ring_handoff<sg14::blocking_ring<sg14::spsc_ring_span<std::uint64_t>, sg14::busy_spin_wait> >(capacity, number_of_elements, gap_us, latencies[1]);
+		benchmark_ring_handoff<sg14::blocking_ring<sg14::spsc_ring_span<std::uint64_t>, sg14::spin_yield_wait> >(capacity, number_of_elements, gap_us, latencies[2]);
+		benchmark_ring_handoff<sg14::blocking_ring<sg14::spsc_ring_span<std::uint64_t>, sg14::spin_futex_wait> >(capacity, number_of_elements, gap_us, latencies[3]);
+	}
+
+	for (unsigned int strategy = 0; strategy != 4; ++strategy)
+	{
+		const double p50 = percentile(latencies[strategy], 50), p99 = percentile(latencies[strategy], 99);
+
+		if (output_csv)
+		{
+			std::cout << ", " << p50 << ", " << p99;
+		}
+		else
+		{
+			std::cout << "Gap " << gap_us << "us, " << names[strategy] << ": p50 " << p50 << "ns, p99 " << p99 << "ns" << std::endl;
+		}
+	}
+
+	std::cout << (output_csv ? "\n" : "\n\n");
+}
+
+
+
+inline void benchmark_range_ring_wait_strategies(const unsigned int capacity, const unsigned int min_gap_us, const unsigned int max_gap_us, const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Gap (us), condition_variable p50 (ns), condition_variable p99 (ns), busy_spin_wait p50 (ns), busy_spin_wait p99 (ns), spin_yield_wait p50 (ns), spin_yield_wait p99 (ns), spin_futex_wait p50 (ns), spin_futex_wait p99 (ns)" << std::endl;
+	}
+
+	for (unsigned int gap_us = min_gap_us; gap_us <= max_gap_us; gap_us = (gap_us == 0) ? 1 : gap_us * 10)
+	{
+		if (output_csv)
+		{
+			std::cout << gap_us;
+		}
+
+		benchmark_ring_wait_strategies(capacity, number_of_elements, gap_us, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,,,,,\n,,,,,,,,\n";
+	}
+}
+
+
+
+
+// Broadcast ring tests - one producer thread sends every element to each of number_of_consumers consumer threads, as when several subsystems each need every event.
+// Compares copying each element into one sg14::spsc_ring_span per consumer against publishing it once to an sg14::broadcast_ring_span, whose consumers read it in place
+// in batches. element_type must have a 'number' member, which the consumers sum:
+
+template <class element_type>
+inline double benchmark_broadcast_copies(const unsigned int capacity, const unsigned int number_of_consumers, const unsigned int number_of_elements, double &total)
+{
+	typedef sg14::spsc_ring_span<element_type> ring_type;
+	std::vector<std::vector<element_type> > storage(number_of_consumers, std::vector<element_type>(capacity, element_type(0)));
+	std::vector<std::thread> consumers;
+	std::vector<double> totals(number_of_consumers, 0);
+	plf::nanotimer timer;
+
+	// The rings are cache-line aligned, which operator new only honours from C++17, so they are constructed in an aligned part of a byte buffer instead:
+	std::vector<char> ring_bytes(sizeof(ring_type) * number_of_consumers + alignof(ring_type));
+	void *ring_memory = ring_bytes.data();
+	std::size_t ring_space = ring_bytes.size();
+	ring_type *rings = static_cast<ring_type *>(std::align(alignof(ring_type), sizeof(ring_type) * number_of_consumers, ring_memory, ring_space));
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		new (rings + consumer) ring_type(storage[consumer].begin(), storage[consumer].end());
+	}
+
+	timer.start();
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		consumers.push_back(std::thread([rings, &totals, consumer, number_of_elements]()
+		{
+			element_type element(0);
+
+			for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+			{
+				ring_pop(rings[consumer], element);
+				totals[consumer] += element.number;
+			}
+		}));
+	}
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		const element_type element(element_number & 255);
+
+		for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+		{
+			ring_push(rings[consumer], element);
+		}
+	}
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		consumers[consumer].join();
+		total += totals[consumer];
+	}
+
+	const double elapsed = timer.get_elapsed_us();
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		rings[consumer].~ring_type();
+	}
+
+	return elapsed;
+}
+
+
+
+template <class element_type>
+inline double benchmark_broadcast_ring_span(const unsigned int capacity, const unsigned int number_of_consumers, const unsigned int number_of_elements, double &total)
+{
+	std::vector<element_type> storage(capacity, element_type(0));
+	sg14::broadcast_ring_span<element_type> ring(storage.begin(), storage.end(), number_of_consumers);
+	std::vector<std::thread> consumers;
+	std::vector<double> totals(number_of_consumers, 0);
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		consumers.push_back(std::thread([&ring, &totals, consumer, number_of_elements]()
+		{
+			for (unsigned int received = 0; received != number_of_elements;)
+			{
+				const auto regions = ring.available(consumer);
+				const unsigned int count = static_cast<unsigned int>(regions[0].second + regions[1].second);
+
+				if (count == 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				for (unsigned int region = 0; region != 2; ++region)
+				{
+					for (std::size_t index = 0; index != regions[region].second; ++index)
+					{
+						totals[consumer] += regions[region].first[index].number;
+					}
+				}
+
+				ring.release(consumer, count);
+				received += count;
+			}
+		}));
+	}
+
+	for (unsigned int element_number = 0; element_number != number_of_elements; ++element_number)
+	{
+		const element_type element(element_number & 255);
+
+		while (!ring.try_publish(element))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	for (unsigned int consumer = 0; consumer != number_of_consumers; ++consumer)
+	{
+		consumers[consumer].join();
+		total += totals[consumer];
+	}
+
+	return timer.get_elapsed_us();
+}
+
+
+
+template <class element_type>
+void benchmark_broadcast_ring(const unsigned int capacity, const unsigned int number_of_consumers, const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	double copies_time = 0, broadcast_time = 0, total = 0;
+
+	// Dump-run to get the cache 'warmed up' and the threads' stacks mapped:
+	benchmark_broadcast_copies<element_type>(capacity, number_of_consumers, number_of_elements, total);
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		copies_time += benchmark_broadcast_copies<element_type>(capacity, number_of_consumers, number_of_elements, total);
+		broadcast_time += benchmark_broadcast_ring_span<element_type>(capacity, number_of_consumers, number_of_elements, total);
+	}
+
+	// Millions of elements per second, each delivered to every consumer:
+	copies_time = static_cast<double>(number_of_elements) * number_of_runs / copies_time;
+	broadcast_time = static_cast<double>(number_of_elements) * number_of_runs / broadcast_time;
+
+	if (output_csv)
+	{
+		std::cout << ", " << copies_time << ", " << broadcast_time << std::endl;
+	}
+	else
+	{
+		std::cout << number_of_consumers << " consumers, a copy into an sg14::spsc_ring_span per consumer: " << copies_time << " million elements/s" << std::endl;
+		std::cout << number_of_consumers << " consumers, sg14::broadcast_ring_span: " << broadcast_time << " million elements/s" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the reads
+}
+
+
+
+template <class element_type>
+void benchmark_range_broadcast_ring(const unsigned int capacity, const unsigned int min_consumers, const unsigned int max_consumers, const unsigned int number_of_elements, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Consumers, spsc_ring_span per consumer (M/s), broadcast_ring_span (M/s)" << std::endl;
+	}
+
+	for (unsigned int number_of_consumers = min_consumers; number_of_consumers <= max_consumers; ++number_of_consumers)
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_consumers;
+		}
+
+		benchmark_broadcast_ring<element_type>(capacity, number_of_consumers, number_of_elements, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,\n,,\n";
+	}
+}
+
+
+
+
+// Sliding window tests - a stream of samples is pushed into a window of the last window_size samples, and after each push the window's statistics (sum, mean, variance,
+// minimum and maximum) and a FIR filter over it are read, as with a telemetry smoother or an audio filter. Compares recomputing each of them from scratch over a ring_span
+// (the filter by std::inner_product over the ring's iterators, as in SG14_test's filter_test) against sg14::sliding_window, which updates the statistics as each sample
+// arrives and filters the ring's two contiguous regions:
+
+inline void benchmark_sliding_window(const unsigned int window_size, const unsigned int number_of_samples, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	std::vector<double> samples(number_of_samples), coefficients(window_size);
+	unsigned int state = 1;
+
+	for (double &sample : samples)
+	{
+		state = state * 1103515245 + 12345;
+		sample = static_cast<double>((state >> 8) & 65535) * 0.01;
+	}
+
+	for (unsigned int index = 0; index != window_size; ++index)
+	{
+		coefficients[index] = 1.0 / (1.0 + index);
+	}
+
+	double recompute_statistics_time = 0, incremental_statistics_time = 0, inner_product_time = 0, fir_time = 0, total = 0;
+	plf::nanotimer timer;
+
+	for (unsigned int run_number = 0; run_number <= number_of_runs; ++run_number) // Run 0 is a dump-run, to get the cache 'warmed up'
+	{
+		{
+			std::vector<double> storage(window_size);
+			sg14::ring_span<double> ring(storage.begin(), storage.end());
+			timer.start();
+
+			for (const double sample : samples)
+			{
+				ring.push_back(sample);
+				double sum = 0;
+
+				for (const double val : ring)
+				{
+					sum += val;
+				}
+
+				const double mean = sum / static_cast<double>(ring.size());
+				double squared_deviations = 0, min = ring.front(), max = ring.front();
+
+				for (const double val : ring)
+				{
+					squared_deviations += (val - mean) * (val - mean);
+					min = (val < min) ? val : min;
+					max = (val > max) ? val : max;
+				}
+
+				total += sum + mean + squared_deviations / static_cast<double>(ring.size()) + min + max;
+			}
+
+			const double time = timer.get_elapsed_us();
+			recompute_statistics_time += (run_number != 0) ? time : 0;
+		}
+
+		{
+			sg14::sliding_window<double> window(window_size);
+			timer.start();
+
+			for (const double sample : samples)
+			{
+				window.push(sample);
+				total += window.sum() + window.mean() + window.variance() + window.min() + window.max();
+			}
+
+			const double time = timer.get_elapsed_us();
+			incremental_statistics_time += (run_number != 0) ? time : 0;
+		}
+
+		{
+			std::vector<double> storage(window_size);
+			sg14::ring_span<double> ring(storage.begin(), storage.end());
+			timer.start();
+
+			for (const double sample : samples)
+			{
+				ring.push_back(sample);
+				total += std::inner_product(ring.begin(), ring.end(), coefficients.begin(), 0.0);
+			}
+
+			const double time = timer.get_elapsed_us();
+			inner_product_time += (run_number != 0) ? time : 0;
+		}
+
+		{
+			sg14::sliding_window<double> window(window_size);
+			timer.start();
+
+			for (const double sample : samples)
+			{
+				window.push(sample);
+				total += window.fir(coefficients.data());
+			}
+
+			const double time = timer.get_elapsed_us();
+			fir_time += (run_number != 0) ? time : 0;
+		}
+	}
+
+	if (output_csv)
+	{
+		std::cout << ", " << (recompute_statistics_time / number_of_runs) << ", " << (incremental_statistics_time / number_of_runs) << ", " << (inner_product_time / number_of_runs) << ", " << (fir_time / number_of_runs) << std::endl;
+	}
+	else
+	{
+		std::cout << "Window of " << window_size << ", " << number_of_samples << " samples, statistics recomputed over ring_span: " << (recompute_statistics_time / number_of_runs) << "us, sliding_window: " << (incremental_statistics_time / number_of_runs) << "us" << std::endl;
+		std::cout << "Window of " << window_size << ", " << number_of_samples << " samples, FIR by inner_product over ring_span: " << (inner_product_time / number_of_runs) << "us, sliding_window::fir: " << (fir_time / number_of_runs) << "us" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the statistics
+}
+
+
+
+inline void benchmark_range_sliding_window(const unsigned int min_window_size, const unsigned int max_window_size, const unsigned int number_of_samples, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Window size, Statistics recomputed over ring_span, sliding_window statistics, FIR by inner_product over ring_span, sliding_window::fir" << std::endl;
+	}
+
+	for (unsigned int window_size = min_window_size; window_size <= max_window_size; window_size *= 4)
+	{
+		if (output_csv)
+		{
+			std::cout << window_size;
+		}
+
+		benchmark_sliding_window(window_size, number_of_samples, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,,\n,,,,\n";
+	}
+}
+
+
+
+
+// Ring scaling tests - equal numbers of producer and consumer threads move a fixed number of elements through one ring, each thread moving an equal share.
+// Compares the mutex-wrapped ring_span against sg14::mpmc_ring_span moving one element at a time, and in batches (push and pop of up to batch_size elements):
+
+template <template <class> class ring_type, class element_type>
+inline PLF_FORCE_INLINE double benchmark_ring_scaling(const unsigned int capacity, const unsigned int number_of_threads, const unsigned int elements_per_thread, double &total)
+{
+	std::vector<typename ring_storage<ring_type<element_type> >::type> storage(capacity);
+	ring_type<element_type> ring(storage.begin(), storage.end());
+	std::vector<std::thread> threads;
+	std::vector<double> totals(number_of_threads, 0);
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int thread_number = 0; thread_number != number_of_threads; ++thread_number)
+	{
+		threads.push_back(std::thread([&ring, elements_per_thread]()
+		{
+			for (unsigned int element_number = 0; element_number != elements_per_thread; ++element_number)
+			{
+				ring_push(ring, element_type(element_number & 255));
+			}
+		}));
+
+		threads.push_back(std::thread([&ring, &totals, thread_number, elements_per_thread]()
+		{
+			element_type element(0);
+
+			for (unsigned int element_number = 0; element_number != elements_per_thread; ++element_number)
+			{
+				ring_pop(ring, element);
+				totals[thread_number] += static_cast<double>(element);
+			}
+		}));
+	}
+
+	for (unsigned int thread_number = 0; thread_number != threads.size(); ++thread_number)
+	{
+		threads[thread_number].join();
+	}
+
+	const double elapsed = timer.get_elapsed_us();
+
+	for (unsigned int thread_number = 0; thread_number != number_of_threads; ++thread_number)
+	{
+		total += totals[thread_number];
+	}
+
+	return elapsed;
+}
+
+
+
+template <class element_type>
+inline PLF_FORCE_INLINE double benchmark_mpmc_ring_batch_scaling(const unsigned int capacity, const unsigned int number_of_threads, const unsigned int elements_per_thread, const unsigned int batch_size, double &total)
+{
+	std::vector<typename sg14::mpmc_ring_span<element_type>::slot_type> storage(capacity);
+	sg14::mpmc_ring_span<element_type> ring(storage.begin(), storage.end());
+	std::vector<std::thread> threads;
+	std::vector<double> totals(number_of_threads, 0);
+	plf::nanotimer timer;
+	timer.start();
+
+	for (unsigned int thread_number = 0; thread_number != number_of_threads; ++thread_number)
+	{
+		threads.push_back(std::thread([&ring, elements_per_thread, batch_size]()
+		{
+			std::vector<element_type> batch(batch_size, element_type(0));
+
+			for (unsigned int element_number = 0; element_number != elements_per_thread;)
+			{
+				const unsigned int current_batch_size = (elements_per_thread - element_number < batch_size) ? elements_per_thread - element_number : batch_size;
+
+				for (unsigned int batch_index = 0; batch_index != current_batch_size; ++batch_index)
+				{
+					batch[batch_index] = element_type((element_number + batch_index) & 255);
+				}
+
+				for (unsigned int pushed = 0; pushed != current_batch_size;)
+				{
+					const unsigned int count = static_cast<unsigned int>(ring.try_push(batch.begin() + pushed, batch.begin() + current_batch_size));
+					pushed += count;
+
+					if (count == 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+
+				element_number += current_batch_size;
+			}
+		}));
+
+		threads.push_back(std::thread([&ring, &totals, thread_number, elements_per_thread, batch_size]()
+		{
+			std::vector<element_type> batch(batch_size, element_type(0));
+
+			for (unsigned int element_number = 0; element_number != elements_per_thread;)
+			{
+				const unsigned int wanted = (elements_per_thread - element_number < batch_size) ? elements_per_thread - element_number : batch_size;
+				const unsigned int count = static_cast<unsigned int>(ring.try_pop(batch.begin(), wanted));
+
+				for (unsigned int batch_index = 0; batch_index != count; ++batch_index)
+				{
+					totals[thread_number] += static_cast<double>(batch[batch_index]);
+				}
+
+				element_number += count;
+
+				if (count == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	for (unsigned int thread_number = 0; thread_number != threads.size(); ++thread_number)
+	{
+		threads[thread_number].join();
+	}
+
+	const double elapsed = timer.get_elapsed_us();
+
+	for (unsigned int thread_number = 0; thread_number != number_of_threads; ++thread_number)
+	{
+		total += totals[thread_number];
+	}
+
+	return elapsed;
+}
+
+
+
+template <class element_type>
+void benchmark_ring_scaling(const unsigned int capacity, const unsigned int number_of_threads, const unsigned int total_elements, const unsigned int batch_size, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	const unsigned int elements_per_thread = total_elements / number_of_threads;
+	double locked_time = 0, mpmc_time = 0, batch_time = 0, total = 0;
+
+	// Dump-run to get the cache 'warmed up' and the threads' stacks mapped:
+	benchmark_ring_scaling<sg14::mpmc_ring_span, element_type>(capacity, number_of_threads, elements_per_thread, total);
+
+	for (unsigned int run_number = 0; run_number != number_of_runs; ++run_number)
+	{
+		locked_time += benchmark_ring_scaling<locked_ring_span, element_type>(capacity, number_of_threads, elements_per_thread, total);
+		mpmc_time += benchmark_ring_scaling<sg14::mpmc_ring_span, element_type>(capacity, number_of_threads, elements_per_thread, total);
+		batch_time += benchmark_mpmc_ring_batch_scaling<element_type>(capacity, number_of_threads, elements_per_thread, batch_size, total);
+	}
+
+	// Millions of elements per second:
+	const double elements = static_cast<double>(elements_per_thread) * number_of_threads * number_of_runs;
+	locked_time = elements / locked_time;
+	mpmc_time = elements / mpmc_time;
+	batch_time = elements / batch_time;
+
+	if (output_csv)
+	{
+		std::cout << ", " << locked_time << ", " << mpmc_time << ", " << batch_time << std::endl;
+	}
+	else
+	{
+		std::cout << number_of_threads << " producer(s) and consumer(s), mutex-wrapped sg14::ring_span: " << locked_time << " million elements/s" << std::endl;
+		std::cout << number_of_threads << " producer(s) and consumer(s), sg14::mpmc_ring_span: " << mpmc_time << " million elements/s" << std::endl;
+		std::cout << number_of_threads << " producer(s) and consumer(s), sg14::mpmc_ring_span in batches of " << batch_size << ": " << batch_time << " million elements/s" << "\n\n\n";
+	}
+
+	std::cerr << "Dump total: " << total << std::endl; // To prevent compiler from optimizing out the pops
+}
+
+
+
+template <class element_type>
+void benchmark_range_ring_scaling(const unsigned int capacity, const unsigned int max_number_of_threads, const unsigned int total_elements, const unsigned int batch_size, const unsigned int number_of_runs, const bool output_csv = false)
+{
+	if (output_csv)
+	{
+		std::cout << "Producers and consumers (each), Mutex ring_span (M/s), mpmc_ring_span (M/s), mpmc_ring_span batched (M/s)" << std::endl;
+	}
+
+	for (unsigned int number_of_threads = 1; number_of_threads <= max_number_of_threads; number_of_threads *= 2)
+	{
+		if (output_csv)
+		{
+			std::cout << number_of_threads;
+		}
+
+		benchmark_ring_scaling<element_type>(capacity, number_of_threads, total_elements, batch_size, number_of_runs, output_csv);
+	}
+
+	if (output_csv)
+	{
+		std::cout << "\n,,,\n,,,\n";
+	}
+}
+
+
+#endif
+
+
  
 // Utility functions:
 
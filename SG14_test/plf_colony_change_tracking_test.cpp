@@ -0,0 +1,239 @@
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Change tracking alters colony's layout, so it is tested in it's own translation unit, leaving plf_colony_test_suite.cpp on the default configuration.
+// The element type is local to this file, so that no colony instantiated here can collide with one instantiated without change tracking elsewhere:
+#define PLF_COLONY_CHANGE_TRACKING
+#include "plf_colony.h"
+
+#include "SG14_test.h"
+
+
+namespace
+{
+	void title2(const char *title_text)
+	{
+		std::cout << std::endl << std::endl << "--- " << title_text << " ---" << std::endl << std::endl;
+	}
+
+
+
+	void failpass(const char *test_type, bool condition)
+	{
+		std::cout << test_type << ": ";
+
+		if (condition)
+		{
+			std::cout << "Pass" << std::endl;
+		}
+		else
+		{
+			std::cout << "Fail" << std::endl;
+			abort();
+		}
+	}
+
+
+
+	struct tracked_int
+	{
+		int value;
+
+		tracked_int(const int number) : value(number) {}
+	};
+
+	typedef plf::colony<tracked_int> tracked_colony;
+
+
+
+	// Tallies the flags reported by colony::for_each_change:
+	struct change_counter
+	{
+		unsigned int &inserted, &erased, &modified;
+
+		change_counter(unsigned int &i, unsigned int &e, unsigned int &m)
+			: inserted(i), erased(e), modified(m)
+		{}
+
+		void operator () (const tracked_int *, const unsigned char change_flags)
+		{
+			inserted += (change_flags & tracked_colony::change_inserted) != 0;
+			erased += (change_flags & tracked_colony::change_erased) != 0;
+			modified += (change_flags & tracked_colony::change_modified) != 0;
+		}
+	};
+
+
+	// Records every change reported by colony::for_each_change, in order:
+	struct change_recorder
+	{
+		std::vector<std::pair<const tracked_int *, unsigned char> > &changes;
+
+		explicit change_recorder(std::vector<std::pair<const tracked_int *, unsigned char> > &c)
+			: changes(c)
+		{}
+
+		void operator () (const tracked_int *element, const unsigned char change_flags)
+		{
+			changes.push_back(std::make_pair(element, change_flags));
+		}
+	};
+
+
+
+	// Blocks returned to recycling_allocator are handed out again, most-recently-returned first, for requests of the same size - so that a newly allocated group reliably
+	// occupies the addresses of one just deallocated:
+	std::vector<std::pair<std::size_t, void *> > &recycled_blocks()
+	{
+		static std::vector<std::pair<std::size_t, void *> > blocks;
+		return blocks;
+	}
+
+	template <class T>
+	struct recycling_allocator
+	{
+		typedef T value_type;
+
+		recycling_allocator() {}
+
+		template <class U>
+		recycling_allocator(const recycling_allocator<U> &) {}
+
+		T * allocate(const std::size_t n)
+		{
+			std::vector<std::pair<std::size_t, void *> > &blocks = recycled_blocks();
+
+			for (std::size_t index = blocks.size(); index-- != 0;)
+			{
+				if (blocks[index].first == n * sizeof(T))
+				{
+					void * const block = blocks[index].second;
+					blocks.erase(blocks.begin() + static_cast<std::ptrdiff_t>(index));
+					return static_cast<T *>(block);
+				}
+			}
+
+			return static_cast<T *>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T *p, const std::size_t n)
+		{
+			recycled_blocks().push_back(std::make_pair(n * sizeof(T), static_cast<void *>(p)));
+		}
+	};
+
+	template <class T, class U>
+	bool operator == (const recycling_allocator<T> &, const recycling_allocator<U> &) { return true; }
+
+	template <class T, class U>
+	bool operator != (const recycling_allocator<T> &, const recycling_allocator<U> &) { return false; }
+}
+
+
+namespace sg14_test
+{
+
+void plf_colony_change_tracking_test()
+{
+	title2("Change tracking tests");
+
+	tracked_colony i_colony;
+
+	for (int temp = 0; temp != 1000; ++temp)
+	{
+		i_colony.insert(tracked_int(temp));
+	}
+
+	i_colony.reset_changes();
+
+	unsigned int inserted = 0, erased = 0, modified = 0;
+	change_counter counter(inserted, erased, modified);
+
+	i_colony.for_each_change(counter);
+
+	failpass("Reset changes test", inserted + erased + modified == 0);
+
+	tracked_colony::iterator the_iterator = i_colony.begin();
+	i_colony.advance(the_iterator, 10);
+	i_colony.mark_modified(the_iterator);
+	++the_iterator;
+	the_iterator = i_colony.erase(the_iterator); // erase original element 11
+	i_colony.erase(the_iterator); // erase original element 12
+	i_colony.insert(tracked_int(5000));
+
+	tracked_colony::iterator it1 = i_colony.begin(), it2 = i_colony.begin();
+	i_colony.advance(it1, 500);
+	i_colony.advance(it2, 900);
+	i_colony.erase(it1, it2); // erase 400 elements, spanning whole groups
+
+	i_colony.insert(10, tracked_int(6000));
+
+	i_colony.for_each_change(counter);
+
+	// Slots which were erased then reused are reported as both erased and inserted:
+	failpass("Change tracking modified test", modified == 1);
+	failpass("Change tracking erased test", erased == 402);
+	failpass("Change tracking inserted test", inserted == 11);
+
+	inserted = erased = modified = 0;
+	i_colony.reset_changes();
+	i_colony.clear();
+	i_colony.for_each_change(counter);
+
+	failpass("Change tracking clear test", erased == 609 && inserted == 0);
+
+	{
+		// A group allocated at the addresses of a deallocated group - the old elements' erasures must be reported before the new elements' insertions:
+		typedef plf::colony<tracked_int, recycling_allocator<tracked_int> > recycling_colony;
+		recycling_colony r_colony;
+		r_colony.change_group_sizes(8, 8);
+
+		for (int temp = 0; temp != 16; ++temp)
+		{
+			r_colony.insert(tracked_int(temp));
+		}
+
+		r_colony.reset_changes();
+
+		recycling_colony::iterator second_group = r_colony.begin();
+		r_colony.advance(second_group, 8);
+		const tracked_int * const old_address = &*second_group;
+		r_colony.erase(second_group, r_colony.end()); // deallocates the second group
+
+		recycling_colony::iterator new_element = r_colony.insert(tracked_int(100));
+
+		for (int temp = 101; temp != 108; ++temp)
+		{
+			r_colony.insert(tracked_int(temp));
+		}
+
+		failpass("Change tracking reused address test", &*new_element == old_address);
+
+		std::vector<std::pair<const tracked_int *, unsigned char> > changes;
+		r_colony.for_each_change(change_recorder(changes));
+
+		bool erased_first = changes.size() == 16;
+
+		for (std::size_t index = 0; index != changes.size(); ++index)
+		{
+			erased_first = erased_first && (changes[index].second == ((index < 8) ? recycling_colony::change_erased : recycling_colony::change_inserted));
+		}
+
+		failpass("Change tracking freed group order test", erased_first && changes[0].first == old_address && changes[8].first == old_address);
+	}
+
+	std::vector<std::pair<std::size_t, void *> > &blocks = recycled_blocks();
+
+	for (std::size_t index = 0; index != blocks.size(); ++index)
+	{
+		::operator delete(blocks[index].second);
+	}
+
+	blocks.clear();
+}
+
+}
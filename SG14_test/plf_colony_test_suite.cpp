@@ -1,8 +1,11 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <numeric>
 
 #include "plf_colony.h"
+#include "arena_allocator.h"
+#include "huge_page_allocator.h"
 
 
 #if defined(_MSC_VER)
@@ -125,6 +128,34 @@ namespace
 			: success(false)
 		{}
 	};
+
+
+
+	// Owns a heap-allocated value - not trivially-copyable, but relocatable by copying it's bytes, and counts it's constructions and destructions:
+	struct relocatable_handle
+	{
+		static unsigned int constructions, destructions;
+		int *value;
+
+		explicit relocatable_handle(const int number) : value(new int(number)) { ++constructions; }
+		relocatable_handle(const relocatable_handle &source) : value(new int(*source.value)) { ++constructions; }
+		~relocatable_handle() { delete value; ++destructions; }
+
+	private:
+		relocatable_handle & operator = (const relocatable_handle &);
+	};
+
+	unsigned int relocatable_handle::constructions = 0, relocatable_handle::destructions = 0;
+}
+
+
+namespace plf
+{
+	template <>
+	struct colony_is_trivially_relocatable<relocatable_handle>
+	{
+		static const bool value = true;
+	};
 }
 
 
@@ -889,6 +920,450 @@ void plf_colony_test_suite()
 		}
 
 
+		{
+			title2("Freeze tests");
+
+			colony<int> i_colony;
+			colony<int>::frozen_view i_view;
+
+			for (int temp = 0; temp != 5000; ++temp)
+			{
+				i_colony.insert(temp);
+			}
+
+			i_colony.freeze(i_view);
+
+			failpass("Freeze size test", i_view.size() == 5000);
+
+			bool matches = true;
+			unsigned int index = 0;
+
+			for (colony<int>::iterator the_iterator = i_colony.begin(); the_iterator != i_colony.end(); ++the_iterator, ++index)
+			{
+				matches = matches && i_view[index] == *the_iterator && i_view.get_iterator(index) == the_iterator && i_view.get_index(the_iterator) == index;
+			}
+
+			failpass("Freeze order and index map test", matches);
+
+			// Erase every third element and a range, then refreeze incrementally:
+			for (colony<int>::iterator the_iterator = i_colony.begin(); the_iterator != i_colony.end();)
+			{
+				if (*the_iterator % 3 == 0)
+				{
+					the_iterator = i_colony.erase(the_iterator);
+				}
+				else
+				{
+					++the_iterator;
+				}
+			}
+
+			colony<int>::iterator it1 = i_colony.begin(), it2 = i_colony.begin();
+			i_colony.advance(it1, 100);
+			i_colony.advance(it2, 2000);
+			i_colony.erase(it1, it2);
+
+			for (int temp = 0; temp != 300; ++temp)
+			{
+				i_colony.insert(temp);
+			}
+
+			i_colony.freeze(i_view);
+
+			failpass("Incremental freeze size test", i_view.size() == i_colony.size());
+
+			matches = true;
+			index = 0;
+
+			for (colony<int>::iterator the_iterator = i_colony.begin(); the_iterator != i_colony.end(); ++the_iterator, ++index)
+			{
+				matches = matches && &i_view[index] == &*the_iterator && i_view.get_iterator(index) == the_iterator;
+			}
+
+			failpass("Incremental freeze order test", matches);
+
+			// Two views of the same colony - refreshing one must not hide changes from the other:
+			{
+				colony<int> i_colony2;
+				colony<int>::frozen_view view1, view2;
+
+				for (int temp = 0; temp != 1000; ++temp)
+				{
+					i_colony2.insert(temp);
+				}
+
+				i_colony2.freeze(view1);
+				i_colony2.freeze(view2);
+
+				// Leave the back group with the same number of elements, but with one of them in a different location:
+				colony<int>::iterator back = i_colony2.end();
+				--back;
+				--back;
+				i_colony2.erase(i_colony2.erase(back));
+
+				const colony<int>::iterator reused = i_colony2.insert(1000);
+				i_colony2.insert(1001);
+				i_colony2.insert(1002); // into the back group's unused capacity
+				i_colony2.erase(reused);
+
+				i_colony2.freeze(view1);
+				i_colony2.freeze(view2);
+
+				matches = view1.size() == i_colony2.size() && view2.size() == i_colony2.size();
+				index = 0;
+
+				for (colony<int>::iterator the_iterator = i_colony2.begin(); the_iterator != i_colony2.end(); ++the_iterator, ++index)
+				{
+					matches = matches && &view1[index] == &*the_iterator && &view2[index] == &*the_iterator;
+				}
+
+				failpass("Multiple view freeze test", matches);
+			}
+
+			i_colony.clear();
+			i_colony.freeze(i_view);
+
+			failpass("Freeze empty colony test", i_view.empty());
+		}
+
+
+		{
+			title2("Trivially-copyable copy tests");
+
+			colony<int> i_colony;
+
+			for (int temp = 0; temp != 20000; ++temp)
+			{
+				i_colony.insert(temp);
+			}
+
+			for (colony<int>::iterator the_iterator = i_colony.begin(); the_iterator != i_colony.end();)
+			{
+				if ((*the_iterator % 7) < 3)
+				{
+					the_iterator = i_colony.erase(the_iterator);
+				}
+				else
+				{
+					++the_iterator;
+				}
+			}
+
+			colony<int> i_colony2(i_colony);
+
+			failpass("Copy equality test", i_colony2 == i_colony);
+			failpass("Copy capacity test", i_colony2.capacity() == i_colony.capacity());
+
+			const unsigned int capacity = static_cast<unsigned int>(i_colony2.capacity());
+			const unsigned int erased = 20000 - static_cast<unsigned int>(i_colony2.size());
+
+			for (unsigned int temp = 0; temp != erased; ++temp)
+			{
+				i_colony2.insert(1);
+			}
+
+			failpass("Copy erased location reuse test", i_colony2.capacity() == capacity && i_colony2.size() == 20000);
+
+			colony<int> i_colony3;
+			i_colony3 = i_colony;
+			i_colony3.shrink_to_fit();
+
+			failpass("Copy shrink_to_fit test", i_colony3 == i_colony && i_colony3.capacity() == i_colony3.size());
+		}
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Stateful allocator tests");
+
+			typedef sg14::arena_allocator<int> arena_alloc;
+			sg14::bump_arena arena(4096), arena2(4096);
+			const arena_alloc first_alloc(arena), second_alloc(arena2);
+
+			{
+				colony<int, arena_alloc> i_colony(first_alloc);
+
+				for (int temp = 0; temp != 10000; ++temp)
+				{
+					i_colony.insert(temp);
+				}
+
+				for (colony<int, arena_alloc>::iterator the_iterator = i_colony.begin(); the_iterator != i_colony.end();)
+				{
+					the_iterator = ((*the_iterator % 3) == 0) ? i_colony.erase(the_iterator) : ++the_iterator;
+				}
+
+				failpass("Allocator instance test", arena.bytes_allocated() != 0 && i_colony.get_allocator() == first_alloc);
+
+				colony<int, arena_alloc> i_colony2(i_colony, second_alloc);
+				failpass("Allocator-extended copy test", i_colony2 == i_colony && i_colony2.get_allocator() == second_alloc);
+
+				colony<int, arena_alloc> i_colony3(second_alloc);
+				i_colony3 = std::move(i_colony);
+				failpass("Unequal allocator move assignment test", i_colony3 == i_colony2 && i_colony3.get_allocator() == second_alloc);
+
+				colony<int, arena_alloc> i_colony4(std::move(i_colony3), second_alloc);
+				failpass("Equal allocator move construct test", i_colony4 == i_colony2 && i_colony3.empty());
+
+				const std::size_t arena2_used = arena2.bytes_allocated();
+				i_colony4.shrink_to_fit();
+				i_colony4.reserve(20000);
+				i_colony4.insert(3);
+				failpass("Allocator retention test", i_colony4.size() == i_colony2.size() + 1 && i_colony4.get_allocator() == second_alloc && arena2.bytes_allocated() > arena2_used);
+			}
+
+			arena.release();
+			arena2.release();
+			failpass("Arena release test", arena.bytes_reserved() == 0 && arena2.bytes_reserved() == 0);
+		}
+
+
+		{
+			title2("Huge page allocator tests");
+
+			typedef sg14::huge_page_allocator<int> huge_page_alloc;
+			sg14::huge_page_resource resource;
+
+			{
+				colony<int, huge_page_alloc> i_colony((huge_page_alloc(resource)));
+
+				for (int temp = 0; temp != 500000; ++temp)
+				{
+					i_colony.insert(temp);
+				}
+
+				failpass("Huge page region test", resource.explicit_huge_page_regions() + resource.transparent_huge_page_regions() != 0);
+
+				colony<int, huge_page_alloc> i_colony2(i_colony);
+				failpass("Huge page copy test", i_colony2 == i_colony && i_colony2.get_allocator() == huge_page_alloc(resource));
+
+				colony<int, huge_page_alloc> i_colony3;
+				i_colony3 = std::move(i_colony2);
+				failpass("Huge page move propagation test", i_colony3 == i_colony && i_colony3.get_allocator() == huge_page_alloc(resource));
+
+				i_colony.clear();
+				i_colony3.shrink_to_fit();
+				failpass("Huge page shrink test", i_colony3.size() == 500000);
+			}
+		}
+		#endif
+
+
+		{
+			title2("Transfer tests");
+
+			colony<int> active, sleeping;
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				active.insert(temp);
+			}
+
+			int total = 0;
+
+			for (colony<int>::iterator the_iterator = active.begin(); the_iterator != active.end();)
+			{
+				if ((*the_iterator % 4) == 0)
+				{
+					total += *(active.transfer(the_iterator++, sleeping));
+				}
+				else
+				{
+					++the_iterator;
+				}
+			}
+
+			failpass("Transfer test", active.size() == 750 && sleeping.size() == 250 && total == 124500);
+
+			total = 0;
+
+			for (colony<int>::iterator the_iterator = sleeping.begin(); the_iterator != sleeping.end(); ++the_iterator)
+			{
+				total += ((*the_iterator % 4) == 0);
+			}
+
+			failpass("Transfer contents test", total == 250);
+
+			colony<int>::iterator first = active.begin(), last = active.begin();
+			active.advance(first, 100);
+			active.advance(last, 600);
+
+			const colony<int>::iterator new_location = active.transfer(first, last, sleeping);
+
+			failpass("Range transfer test", active.size() == 250 && sleeping.size() == 750 && *new_location == 134);
+
+			active.transfer(active.begin(), active.end(), sleeping);
+
+			failpass("Range transfer all test", active.empty() && sleeping.size() == 1000);
+
+			total = 0;
+
+			for (colony<int>::iterator the_iterator = sleeping.begin(); the_iterator != sleeping.end(); ++the_iterator)
+			{
+				total += *the_iterator;
+			}
+
+			failpass("Range transfer contents test", total == 499500);
+			failpass("Empty range transfer test", active.transfer(active.begin(), active.end(), sleeping) == sleeping.end());
+
+			// Relocate into erased locations in the destination - every other element is erased from sleeping, then refilled:
+			for (colony<int>::iterator the_iterator = sleeping.begin(); the_iterator != sleeping.end();)
+			{
+				the_iterator = sleeping.erase(the_iterator);
+
+				if (the_iterator != sleeping.end())
+				{
+					++the_iterator;
+				}
+			}
+
+			const int remaining_total = std::accumulate(sleeping.begin(), sleeping.end(), 0);
+			const colony<int>::size_type original_capacity = sleeping.capacity();
+
+			for (int temp = 0; temp != 500; ++temp)
+			{
+				active.insert(1);
+			}
+
+			active.transfer(active.begin(), active.end(), sleeping);
+
+			failpass("Transfer into erased locations test", sleeping.size() == 1000 && sleeping.capacity() == original_capacity && std::accumulate(sleeping.begin(), sleeping.end(), 0) == remaining_total + 500 && static_cast<colony<int>::size_type>(std::distance(sleeping.begin(), sleeping.end())) == 1000);
+
+			// Types which are not trivially-copyable are moved rather than relocated:
+			colony<std::vector<int> > v_active, v_sleeping;
+
+			for (int temp = 0; temp != 100; ++temp)
+			{
+				v_active.insert(std::vector<int>(10, temp));
+			}
+
+			const colony<std::vector<int> >::iterator v_location = v_active.transfer(v_active.begin(), v_sleeping);
+			v_active.transfer(v_active.begin(), v_active.end(), v_sleeping);
+
+			failpass("Non-trivially-copyable transfer test", v_active.empty() && v_sleeping.size() == 100 && v_location->size() == 10 && (*v_location)[0] == 0);
+
+			// Types which opt in to colony_is_trivially_relocatable are relocated without being constructed or destroyed:
+			{
+				colony<relocatable_handle> h_active, h_sleeping;
+
+				for (int temp = 0; temp != 100; ++temp)
+				{
+					h_active.emplace(temp);
+				}
+
+				const unsigned int constructions = relocatable_handle::constructions, destructions = relocatable_handle::destructions;
+
+				const colony<relocatable_handle>::iterator h_location = h_active.transfer(h_active.begin(), h_sleeping);
+				colony<relocatable_handle>::iterator h_first = h_active.begin();
+				h_active.advance(h_first, 10);
+				h_active.transfer(h_first, h_active.end(), h_sleeping);
+
+				int h_total = 0;
+
+				for (colony<relocatable_handle>::iterator the_iterator = h_sleeping.begin(); the_iterator != h_sleeping.end(); ++the_iterator)
+				{
+					h_total += *(the_iterator->value);
+				}
+
+				failpass("Relocatable transfer test", h_active.size() == 10 && h_sleeping.size() == 90 && *(h_location->value) == 0 && h_total == 4950 - (1 + 2 + 3 + 4 + 5 + 6 + 7 + 8 + 9 + 10)
+					&& relocatable_handle::constructions == constructions && relocatable_handle::destructions == destructions);
+			}
+
+			failpass("Relocatable transfer destruction test", relocatable_handle::constructions == relocatable_handle::destructions);
+		}
+
+
+		{
+			title2("Clear keep capacity tests");
+
+			colony<int> scratch;
+
+			for (int temp = 0; temp != 50000; ++temp)
+			{
+				scratch.insert(temp);
+			}
+
+			for (colony<int>::iterator the_iterator = scratch.begin(); the_iterator != scratch.end();)
+			{
+				if ((*the_iterator % 3) == 0)
+				{
+					the_iterator = scratch.erase(the_iterator);
+				}
+				else
+				{
+					++the_iterator;
+				}
+			}
+
+			const colony<int>::size_type original_capacity = scratch.capacity();
+			scratch.clear(true);
+
+			failpass("Clear keep capacity test", scratch.empty() && scratch.begin() == scratch.end() && scratch.capacity() == original_capacity);
+
+			const colony<int>::size_type retained_memory_use = scratch.approximate_memory_use();
+
+			for (int temp = 0; temp != 10; ++temp)
+			{
+				scratch.insert(temp);
+			}
+
+			failpass("Partial reuse capacity test", scratch.capacity() == original_capacity && scratch.approximate_memory_use() == retained_memory_use);
+
+			{
+				colony<int> swapped;
+				swapped.swap(scratch);
+				failpass("Retained capacity swap test", swapped.capacity() == original_capacity && scratch.capacity() == 0);
+				scratch.swap(swapped);
+			}
+
+			scratch.clear(true);
+
+			int total = 0;
+
+			for (int frame = 0; frame != 3; ++frame)
+			{
+				for (int temp = 0; temp != 50000; ++temp)
+				{
+					scratch.insert(temp);
+				}
+
+				total = 0;
+
+				for (colony<int>::iterator the_iterator = scratch.begin(); the_iterator != scratch.end(); ++the_iterator)
+				{
+					total += *the_iterator & 1;
+				}
+
+				if (frame != 2)
+				{
+					scratch.clear(true);
+				}
+			}
+
+			failpass("Reuse after clear test", scratch.size() == 50000 && total == 25000 && scratch.capacity() == original_capacity);
+
+			scratch.erase(scratch.begin());
+			scratch.insert(1);
+			failpass("Erase and insert after reuse test", scratch.size() == 50000);
+
+			scratch.clear(true);
+			scratch.shrink_to_fit();
+			failpass("Shrink retained groups test", scratch.capacity() == 0);
+
+			colony<std::vector<int> > vector_colony;
+
+			for (int temp = 0; temp != 500; ++temp)
+			{
+				vector_colony.insert(std::vector<int>(10, temp));
+			}
+
+			vector_colony.clear(true);
+			vector_colony.insert(std::vector<int>(5, 1));
+
+			failpass("Non-trivial clear keep capacity test", vector_colony.size() == 1 && vector_colony.begin()->size() == 5);
+		}
+
+
 		#ifdef PLF_VARIADICS_SUPPORT
 		{
 			title2("Perfect Forwarding tests");
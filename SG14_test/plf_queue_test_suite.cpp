@@ -0,0 +1,570 @@
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "plf_queue.h"
+#include "arena_allocator.h"
+
+
+#if defined(_MSC_VER)
+	#define PLF_FORCE_INLINE __forceinline
+
+	#if _MSC_VER < 1600
+		#define PLF_NOEXCEPT throw()
+	#elif _MSC_VER == 1600
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#define PLF_NOEXCEPT throw()
+	#elif _MSC_VER == 1700
+		#define PLF_TYPE_TRAITS_SUPPORT
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#define PLF_NOEXCEPT throw()
+	#elif _MSC_VER == 1800
+		#define PLF_TYPE_TRAITS_SUPPORT
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_VARIADICS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#define PLF_NOEXCEPT throw()
+		#define PLF_INITIALIZER_LIST_SUPPORT
+	#elif _MSC_VER >= 1900
+		#define PLF_TYPE_TRAITS_SUPPORT
+		#define PLF_ALLOCATOR_TRAITS_SUPPORT
+		#define PLF_VARIADICS_SUPPORT
+		#define PLF_MOVE_SEMANTICS_SUPPORT
+		#define PLF_NOEXCEPT noexcept
+		#define PLF_INITIALIZER_LIST_SUPPORT
+	#endif
+#elif defined(__cplusplus) && __cplusplus >= 201103L
+	#define PLF_FORCE_INLINE // note: GCC creates faster code without forcing inline
+
+	#if defined(__GNUC__) && defined(__GNUC_MINOR__) && !defined(__clang__) // If compiler is GCC/G++
+		#if __GNUC__ == 4 && __GNUC_MINOR__ >= 4 // 4.3 and below do not support initializer lists
+			#define PLF_INITIALIZER_LIST_SUPPORT
+		#elif __GNUC__ >= 5 // GCC v4.9 and below do not support std::is_trivially_copyable
+			#define PLF_INITIALIZER_LIST_SUPPORT
+			#define PLF_TYPE_TRAITS_SUPPORT
+		#endif
+	#else // Assume type traits and initializer support for non-GCC compilers
+		#define PLF_INITIALIZER_LIST_SUPPORT
+		#define PLF_TYPE_TRAITS_SUPPORT
+	#endif
+
+	#define PLF_ALLOCATOR_TRAITS_SUPPORT
+	#define PLF_VARIADICS_SUPPORT // Variadics, in this context, means both variadic templates and variadic macros are supported
+	#define PLF_MOVE_SEMANTICS_SUPPORT
+	#define PLF_NOEXCEPT noexcept
+#else
+	#define PLF_FORCE_INLINE
+	#define PLF_NOEXCEPT throw()
+#endif
+
+
+
+
+
+
+namespace
+{
+    void title1(const char *title_text)
+    {
+        std::cout << std::endl << std::endl << std::endl << "*** " << title_text << " ***" << std::endl;
+        std::cout << "===========================================" << std::endl << std::endl << std::endl;
+    }
+    
+
+
+	void title2(const char *title_text)
+	{
+		std::cout << std::endl << std::endl << "--- " << title_text << " ---" << std::endl << std::endl;
+	}
+
+
+
+    void failpass(const char *test_type, bool condition)
+    {
+        std::cout << test_type << ": ";
+        
+        if (condition)
+        {
+            std::cout << "Pass" << std::endl;
+        }
+        else
+        {
+            std::cout << "Fail" << std::endl;
+            std::cin.get();
+            abort();
+        }
+    }
+
+
+
+	// Fast xorshift+128 random number generator function (original: https://codingforspeed.com/using-faster-psudo-random-generator-xorshift/)
+	unsigned int xor_rand()
+	{
+		static unsigned int x = 123456789;
+		static unsigned int y = 362436069;
+		static unsigned int z = 521288629;
+		static unsigned int w = 88675123;
+
+		const unsigned int t = x ^ (x << 11);
+
+		// Rotate the static values (w rotation in return statement):
+		x = y;
+		y = z;
+		z = w;
+
+		return w = w ^ (w >> 19) ^ (t ^ (t >> 8));
+	}
+
+
+
+	// Hands out arrays of int from the top of a buffer downwards, so that each new group's elements end exactly where the previous group's begin.
+	// Anything else (the queue's group structures) comes from the heap, so as not to sit between the arrays:
+	struct descending_buffer
+	{
+		char *bottom, *top;
+	};
+
+	template <class T>
+	struct descending_allocator
+	{
+		typedef T value_type;
+		descending_buffer *buffer;
+
+		explicit descending_allocator(descending_buffer &source) : buffer(&source) {}
+		template <class U> descending_allocator(const descending_allocator<U> &source) : buffer(source.buffer) {}
+
+		T * allocate(const size_t n)
+		{
+			if (!std::is_same<T, int>::value)
+			{
+				return static_cast<T *>(::operator new(n * sizeof(T)));
+			}
+
+			if (static_cast<size_t>(buffer->top - buffer->bottom) < n * sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			buffer->top -= n * sizeof(T);
+			return reinterpret_cast<T *>(buffer->top);
+		}
+
+		void deallocate(T *p, size_t)
+		{
+			if (!std::is_same<T, int>::value)
+			{
+				::operator delete(p);
+			}
+		}
+
+		template <class U> bool operator == (const descending_allocator<U> &rh) const { return buffer == rh.buffer; }
+		template <class U> bool operator != (const descending_allocator<U> &rh) const { return buffer != rh.buffer; }
+	};
+
+
+
+	struct perfect_forwarding_test
+	{
+		const bool success;
+	
+		perfect_forwarding_test(int&&, int& perfect2)
+			: success(true)
+		{
+			perfect2 = 1;
+		}
+	
+		template <typename T, typename U>
+		perfect_forwarding_test(T&& imperfect1, U&& imperfect2)
+			: success(false)
+		{}
+	};
+
+
+
+	struct throwing_copy // Copy construction throws once copies_until_throw reaches zero
+	{
+		int value;
+		static int copies_until_throw;
+
+		explicit throwing_copy(const int number): value(number) {}
+
+		throwing_copy(const throwing_copy &source): value(source.value)
+		{
+			if (--copies_until_throw == 0)
+			{
+				throw 1;
+			}
+		}
+	};
+
+	int throwing_copy::copies_until_throw = -1;
+}
+
+
+namespace sg14_test
+{
+
+
+void plf_queue_test_suite()
+{
+	using namespace std;
+	using namespace plf;
+
+
+	unsigned int looper = 0;
+
+
+	while (++looper != 50)
+	{
+		{
+			title1("Queue");
+			title1("Test basics");
+
+			queue<unsigned int> i_queue(50);
+
+			for (unsigned int temp = 0; temp != 250000; ++temp)
+			{
+				i_queue.push(temp);
+			}
+
+			failpass("Multipush test", i_queue.size() == 250000 && i_queue.front() == 0 && i_queue.back() == 249999);
+
+			queue<unsigned int> i_queue2;
+			i_queue2 = i_queue;
+
+			queue<unsigned int> i_queue3(i_queue);
+
+			failpass("Copy constructor test", i_queue3.size() == 250000 && i_queue3.front() == 0);
+
+			queue<unsigned int> i_queue6(i_queue, i_queue3.get_allocator());
+
+			failpass("Allocator-extended copy constructor test", i_queue6.size() == 250000);
+
+			const size_t reserve_capacity = i_queue3.capacity();
+			i_queue3.reserve(400000);
+
+			failpass("Reserve test", i_queue3.size() == 250000 && i_queue3.capacity() >= 400000 && i_queue3.capacity() > reserve_capacity && i_queue3.front() == 0);
+
+
+			#ifdef PLF_MOVE_SEMANTICS_SUPPORT
+				queue<unsigned int> i_queue4;
+				i_queue4 = std::move(i_queue3);
+				failpass("Move equality operator test", i_queue2 == i_queue4);
+				queue<unsigned int> i_queue5(std::move(i_queue4), i_queue3.get_allocator());
+
+				failpass("Allocator-extended move-construct test", i_queue5.size() == 250000);
+
+				i_queue3 = std::move(i_queue5);
+
+			#else
+				failpass("Equality operator test", i_queue2 == i_queue3);
+			#endif
+
+			failpass("Copy test", i_queue2.size() == 250000);
+			failpass("Equality operator test 2", i_queue == i_queue2);
+
+			i_queue2.push(5);
+			i_queue2.swap(i_queue3);
+
+			failpass("Swap test", i_queue2.size() == i_queue3.size() - 1);
+
+			swap(i_queue2, i_queue3);
+
+			failpass("Swap test 2", i_queue3.size() == i_queue2.size() - 1 && i_queue3.back() == 249999 && i_queue2.back() == 5);
+
+			failpass("max_size() test", i_queue2.max_size() > i_queue2.size());
+
+
+			unsigned int total = 0;
+
+			for (unsigned int temp = 0; temp != 200000; ++temp)
+			{
+				total += (i_queue.front() == temp);
+				i_queue.pop();
+			}
+
+			failpass("Multipop test", i_queue.size() == 50000);
+			failpass("FIFO order test", total == 200000 && i_queue.front() == 200000);
+
+			const size_t temp_capacity = i_queue.capacity();
+			i_queue.shrink_to_fit();
+
+			failpass("shrink_to_fit() test", temp_capacity != i_queue.capacity() && i_queue.size() == 50000 && i_queue.front() == 200000 && i_queue.back() == 249999);
+
+
+			unsigned int next_push = 250000, next_pop = 200000;
+			total = 0;
+
+			do
+			{
+				if ((xor_rand() & 3) == 0)
+				{
+					i_queue.push(next_push++);
+				}
+				else
+				{
+					total += (i_queue.front() != next_pop++);
+					i_queue.pop();
+				}
+			} while (!i_queue.empty());
+
+			failpass("Randomly pop/push till empty test", i_queue.size() == 0 && total == 0 && next_pop == next_push);
+
+			#ifdef PLF_VARIADICS_SUPPORT
+				i_queue.emplace(20);
+				failpass("Emplace test", i_queue.size() == 1 && i_queue.front() == 20);
+			#endif
+
+			i_queue.clear();
+			failpass("Clear test", i_queue.empty() && i_queue.capacity() == 0 && i_queue.begin() == i_queue.end());
+		}
+
+
+		{
+			title2("Group reuse tests");
+
+			queue<int> i_queue(8, 64);
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_queue.push(temp);
+			}
+
+			int next_pop = 0, next_push = 1000, total = 0;
+
+			for (int temp = 0; temp != 1000; ++temp) // Grow to the working size, draining the small initial groups
+			{
+				i_queue.push(next_push++);
+				total += (i_queue.front() == next_pop++);
+				i_queue.pop();
+			}
+
+			const size_t steady_capacity = i_queue.capacity();
+
+			for (int temp = 0; temp != 100000; ++temp) // Steady state - drained front groups are reused at the back, so no further groups are needed
+			{
+				i_queue.push(next_push++);
+				total += (i_queue.front() == next_pop++);
+				i_queue.pop();
+			}
+
+			failpass("Drained group reuse test", i_queue.capacity() == steady_capacity && total == 101000 && i_queue.size() == 1000);
+
+			while (!i_queue.empty())
+			{
+				i_queue.pop();
+			}
+
+			failpass("Pop till empty test", i_queue.capacity() == steady_capacity);
+
+			i_queue.push(5);
+			failpass("Push after empty test", i_queue.size() == 1 && i_queue.front() == 5 && i_queue.back() == 5);
+
+			i_queue.trim_trailing_groups();
+			failpass("Trim test", i_queue.capacity() < steady_capacity && i_queue.front() == 5);
+		}
+
+
+		{
+			title2("Iteration tests");
+
+			queue<int> i_queue(8, 64);
+			failpass("Empty iteration test", i_queue.begin() == i_queue.end());
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_queue.push(temp);
+			}
+
+			for (int temp = 0; temp != 500; ++temp)
+			{
+				i_queue.pop();
+			}
+
+			int total = 0, expected = 500;
+
+			for (queue<int>::const_iterator current = i_queue.begin(); current != i_queue.end(); ++current)
+			{
+				total += (*current == expected++);
+			}
+
+			failpass("Forward iteration test", total == 500 && expected == 1000);
+		}
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Adjacent group iteration tests");
+
+			// Each group's elements end where the previous group's begin, so that one-past the back of a full current group is the front group's first element:
+			int storage[1024];
+			descending_buffer buffer = { reinterpret_cast<char *>(storage), reinterpret_cast<char *>(storage + 1024) };
+			queue<int, descending_allocator<int> > i_queue(8, 64, descending_allocator<int>(buffer));
+
+			do // Fill past the first group, to the end of the second
+			{
+				i_queue.push(static_cast<int>(i_queue.size()));
+			} while (i_queue.size() <= 8 || i_queue.capacity() != i_queue.size());
+
+			failpass("Adjacent group iteration test", static_cast<size_t>(std::distance(i_queue.begin(), i_queue.end())) == i_queue.size() && i_queue.begin() != i_queue.end());
+
+			size_t wrong_distances = 0;
+
+			for (int temp = 0; temp != 200; ++temp) // Move the front and back across several group ends, reusing groups
+			{
+				if ((xor_rand() & 1) == 0 || i_queue.empty())
+				{
+					i_queue.push(temp);
+				}
+				else
+				{
+					i_queue.pop();
+				}
+
+				wrong_distances += (static_cast<size_t>(std::distance(i_queue.begin(), i_queue.end())) != i_queue.size());
+			}
+
+			failpass("Adjacent group push/pop iteration test", wrong_distances == 0);
+		}
+		#endif
+
+
+		{
+			title2("Non-trivial type tests");
+
+			queue<std::string> s_queue;
+
+			for (int temp = 0; temp != 10000; ++temp)
+			{
+				s_queue.push(std::string(static_cast<size_t>(temp % 100) + 20, 'a'));
+			}
+
+			queue<std::string> s_queue2(s_queue);
+			int total = 0;
+
+			for (int temp = 0; temp != 5000; ++temp)
+			{
+				total += (s_queue.front().size() == static_cast<size_t>(temp % 100) + 20);
+				s_queue.pop();
+			}
+
+			failpass("String FIFO test", total == 5000 && s_queue.size() == 5000 && s_queue2.size() == 10000);
+
+			s_queue2 = s_queue;
+			failpass("String copy assignment test", s_queue2 == s_queue && s_queue2.front().size() == 20);
+		}
+
+
+		{
+			title2("Exception safety tests");
+
+			queue<throwing_copy> t_queue(8, 64);
+			bool caught = false;
+
+			for (int temp = 0; temp != 8; ++temp) // Fill the first group exactly, so that the next push moves to a new group
+			{
+				t_queue.push(throwing_copy(temp));
+			}
+
+			throwing_copy::copies_until_throw = 1;
+
+			try
+			{
+				t_queue.push(throwing_copy(8));
+			}
+			catch (int)
+			{
+				caught = true;
+			}
+
+			throwing_copy::copies_until_throw = -1;
+			failpass("Push exception test", caught && t_queue.size() == 8 && t_queue.back().value == 7);
+
+			for (int temp = 8; temp != 20; ++temp)
+			{
+				t_queue.push(throwing_copy(temp));
+			}
+
+			int total = 0;
+
+			for (int temp = 0; temp != 20; ++temp)
+			{
+				total += (t_queue.front().value == temp);
+				t_queue.pop();
+			}
+
+			failpass("Push after exception test", total == 20 && t_queue.empty());
+
+			caught = false;
+			t_queue.push(throwing_copy(1));
+			throwing_copy::copies_until_throw = 1;
+
+			try
+			{
+				t_queue.push(throwing_copy(2));
+			}
+			catch (int)
+			{
+				caught = true;
+			}
+
+			throwing_copy::copies_until_throw = -1;
+			t_queue.pop();
+			failpass("Pop to empty after exception test", caught && t_queue.empty());
+		}
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Stateful allocator tests");
+
+			typedef sg14::arena_allocator<int> arena_alloc;
+			sg14::bump_arena arena(4096), arena2(4096);
+			const arena_alloc first_alloc(arena), second_alloc(arena2);
+
+			{
+				queue<int, arena_alloc> i_queue(first_alloc);
+
+				for (int temp = 0; temp != 10000; ++temp)
+				{
+					i_queue.push(temp);
+				}
+
+				failpass("Allocator instance test", arena.bytes_allocated() != 0 && i_queue.get_allocator() == first_alloc);
+
+				queue<int, arena_alloc> i_queue2(std::move(i_queue), second_alloc);
+				failpass("Unequal allocator move construct test", i_queue2.size() == 10000 && i_queue2.front() == 0 && i_queue2.back() == 9999 && i_queue2.get_allocator() == second_alloc);
+			}
+
+			arena.release();
+			failpass("Arena release test", arena.bytes_reserved() == 0);
+		}
+		#endif
+
+
+		#ifdef PLF_VARIADICS_SUPPORT
+		{
+			title2("Perfect Forwarding tests");
+
+			queue<perfect_forwarding_test> pf_queue;
+
+			int lvalue = 0;
+			int &lvalueref = lvalue;
+
+			pf_queue.emplace(7, lvalueref);
+
+			failpass("Perfect forwarding test", pf_queue.front().success);
+			failpass("Perfect forwarding test 2", lvalueref == 1);
+		}
+		#endif
+	}
+
+	title1("Test Suite PASS - Press ENTER to Exit");
+	cin.get();
+}
+
+}
@@ -1,6 +1,18 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "plf_stack.h"
+#include "plf_concurrent_stack.h"
+#include "plf_work_stealing_deque.h"
+#include "arena_allocator.h"
+#include "file_backed_allocator.h"
 
 
 #if defined(_MSC_VER)
@@ -95,6 +107,72 @@ namespace
 
 
 
+	// Fast xorshift+128 random number generator function (original: https://codingforspeed.com/using-faster-psudo-random-generator-xorshift/)
+	unsigned int xor_rand()
+	{
+		static unsigned int x = 123456789;
+		static unsigned int y = 362436069;
+		static unsigned int z = 521288629;
+		static unsigned int w = 88675123;
+
+		const unsigned int t = x ^ (x << 11);
+
+		// Rotate the static values (w rotation in return statement):
+		x = y;
+		y = z;
+		z = w;
+
+		return w = w ^ (w >> 19) ^ (t ^ (t >> 8));
+	}
+
+
+
+	// Hands out arrays of int from the top of a buffer downwards, so that each new group's elements end exactly where the previous group's begin.
+	// Anything else (the stack's group structures) comes from the heap, so as not to sit between the arrays:
+	struct descending_buffer
+	{
+		char *bottom, *top;
+	};
+
+	template <class T>
+	struct descending_allocator
+	{
+		typedef T value_type;
+		descending_buffer *buffer;
+
+		explicit descending_allocator(descending_buffer &source) : buffer(&source) {}
+		template <class U> descending_allocator(const descending_allocator<U> &source) : buffer(source.buffer) {}
+
+		T * allocate(const size_t n)
+		{
+			if (!std::is_same<T, int>::value)
+			{
+				return static_cast<T *>(::operator new(n * sizeof(T)));
+			}
+
+			if (static_cast<size_t>(buffer->top - buffer->bottom) < n * sizeof(T))
+			{
+				throw std::bad_alloc();
+			}
+
+			buffer->top -= n * sizeof(T);
+			return reinterpret_cast<T *>(buffer->top);
+		}
+
+		void deallocate(T *p, size_t)
+		{
+			if (!std::is_same<T, int>::value)
+			{
+				::operator delete(p);
+			}
+		}
+
+		template <class U> bool operator == (const descending_allocator<U> &rh) const { return buffer == rh.buffer; }
+		template <class U> bool operator != (const descending_allocator<U> &rh) const { return buffer != rh.buffer; }
+	};
+
+
+
 	struct perfect_forwarding_test
 	{
 		const bool success;
@@ -248,6 +326,704 @@ void plf_stack_test_suite()
 		}
 
 
+		{
+			title2("Bulk push/pop tests");
+
+			std::vector<int> source(10000);
+
+			for (int temp = 0; temp != 10000; ++temp)
+			{
+				source[temp] = temp;
+			}
+
+			stack<int> i_stack(8, 256);
+
+			i_stack.push(&source[0], &source[0] + 10000);
+
+			failpass("Pointer range push test", i_stack.size() == 10000 && i_stack.top() == 9999);
+
+			std::vector<int> destination(10000);
+			i_stack.pop_n(3000, &destination[0]);
+
+			int total = 0;
+
+			for (int temp = 0; temp != 3000; ++temp)
+			{
+				total += (destination[temp] == 7000 + temp);
+			}
+
+			failpass("pop_n order test", total == 3000 && i_stack.size() == 7000 && i_stack.top() == 6999);
+
+			i_stack.push(source.begin() + 7000, source.end());
+			failpass("Iterator range push test", i_stack.size() == 10000 && i_stack.top() == 9999);
+
+			i_stack.push_n(5000, 42);
+			failpass("push_n test", i_stack.size() == 15000 && i_stack.top() == 42);
+
+			i_stack.pop_n(5000, destination.begin());
+			i_stack.pop_n(10000, &destination[0]);
+
+			total = 0;
+
+			for (int temp = 0; temp != 10000; ++temp)
+			{
+				total += (destination[temp] == temp);
+			}
+
+			failpass("pop_n to empty test", total == 10000 && i_stack.empty());
+
+			i_stack.push(&source[0], &source[0] + 100);
+			i_stack.push(5);
+			failpass("Push after pop_n to empty test", i_stack.size() == 101 && i_stack.top() == 5);
+
+
+			stack<std::string> s_stack;
+			s_stack.push_n(700, std::string("a fairly long string, to avoid the small string optimisation"));
+			s_stack.push(std::string("top"));
+
+			std::vector<std::string> s_destination;
+			s_stack.pop_n(s_stack.size(), std::back_inserter(s_destination));
+
+			failpass("Non-trivial bulk push/pop test", s_stack.empty() && s_destination.size() == 701 && s_destination.back() == "top" && s_destination.front().size() > 20);
+		}
+
+
+		{
+			title2("Mark/rewind tests");
+
+			stack<int> i_stack(8, 64);
+			const stack<int>::marker empty_mark = i_stack.mark();
+
+			i_stack.push_n(100, 1);
+			const stack<int>::marker frame_mark = i_stack.mark();
+			const size_t capacity = i_stack.capacity();
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_stack.push(temp);
+			}
+
+			i_stack.rewind(frame_mark);
+			failpass("Rewind test", i_stack.size() == 100 && i_stack.top() == 1 && frame_mark.size() == 100);
+
+			const size_t frame_capacity = i_stack.capacity();
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_stack.push(temp);
+			}
+
+			i_stack.rewind(frame_mark);
+			failpass("Rewind group reuse test", i_stack.capacity() == frame_capacity && frame_capacity > capacity);
+
+			i_stack.rewind(empty_mark);
+			failpass("Rewind to empty test", i_stack.empty() && i_stack.capacity() == frame_capacity);
+
+			i_stack.push(5);
+			failpass("Push after rewind test", i_stack.size() == 1 && i_stack.top() == 5);
+
+
+			stack<std::string> s_stack;
+			s_stack.push(std::string("bottom"));
+			const stack<std::string>::marker s_mark = s_stack.mark();
+			s_stack.push_n(500, std::string("a fairly long string, to avoid the small string optimisation"));
+			s_stack.rewind(s_mark);
+			failpass("Non-trivial rewind test", s_stack.size() == 1 && s_stack.top() == "bottom");
+
+			s_stack.rewind(stack<std::string>::marker());
+			failpass("Default marker rewind test", s_stack.empty());
+		}
+
+
+		{
+			title2("Iteration tests");
+
+			stack<int> i_stack(8, 64);
+			failpass("Empty iteration test", i_stack.begin() == i_stack.end() && i_stack.rbegin() == i_stack.rend());
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				i_stack.push(temp);
+			}
+
+			for (int temp = 0; temp != 500; ++temp) // Leave unused trailing groups past the top of the stack
+			{
+				i_stack.pop();
+			}
+
+			int total = 0, expected = 0;
+
+			for (stack<int>::const_iterator current = i_stack.begin(); current != i_stack.end(); ++current)
+			{
+				total += (*current == expected++);
+			}
+
+			failpass("Forward iteration test", total == 500 && expected == 500);
+
+			total = 0;
+
+			for (stack<int>::const_reverse_iterator current = i_stack.rbegin(); current != i_stack.rend(); ++current)
+			{
+				total += (*current == --expected);
+			}
+
+			failpass("Reverse iteration test", total == 500 && expected == 0);
+
+			while (i_stack.capacity() != i_stack.size()) // Fill to the end of a group, so that the top element is the last element of the current group
+			{
+				i_stack.push(expected++);
+			}
+
+			i_stack.pop();
+			i_stack.push(0);
+
+			stack<int>::const_iterator last = i_stack.end();
+			--last;
+			failpass("Iteration at group end test", *last == 0 && static_cast<size_t>(std::distance(i_stack.cbegin(), i_stack.cend())) == i_stack.size());
+
+			std::vector<int> serialized;
+			unsigned int number_of_blocks = 0;
+
+			struct block_appender
+			{
+				std::vector<int> &destination;
+				unsigned int &count;
+				block_appender(std::vector<int> &dest, unsigned int &c) : destination(dest), count(c) {}
+				void operator () (const int *first, const int *last) { destination.insert(destination.end(), first, last); ++count; }
+			};
+
+			i_stack.for_each_block(block_appender(serialized, number_of_blocks));
+
+			failpass("for_each_block test", serialized.size() == i_stack.size() && number_of_blocks > 1 && std::equal(serialized.begin(), serialized.end(), i_stack.begin()));
+
+			i_stack.clear();
+			failpass("Cleared iteration test", i_stack.cbegin() == i_stack.cend());
+		}
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Adjacent group iteration tests");
+
+			// Each group's elements end where the previous group's begin, so that one-past the top of a full current group is the first group's first element:
+			int storage[1024];
+			descending_buffer buffer = { reinterpret_cast<char *>(storage), reinterpret_cast<char *>(storage + 1024) };
+			stack<int, descending_allocator<int> > i_stack(8, 64, descending_allocator<int>(buffer));
+
+			do // Fill past the first group, to the end of the second
+			{
+				i_stack.push(static_cast<int>(i_stack.size()));
+			} while (i_stack.size() <= 8 || i_stack.capacity() != i_stack.size());
+
+			failpass("Adjacent group iteration test", static_cast<size_t>(std::distance(i_stack.cbegin(), i_stack.cend())) == i_stack.size() && i_stack.cbegin() != i_stack.cend());
+
+			size_t wrong_distances = 0;
+
+			for (int temp = 0; temp != 100; ++temp) // Sweep the top across several group ends
+			{
+				if ((xor_rand() & 1) == 0 || i_stack.empty())
+				{
+					i_stack.push(temp);
+				}
+				else
+				{
+					i_stack.pop();
+				}
+
+				wrong_distances += (static_cast<size_t>(std::distance(i_stack.cbegin(), i_stack.cend())) != i_stack.size());
+			}
+
+			failpass("Adjacent group push/pop iteration test", wrong_distances == 0);
+		}
+		#endif
+
+
+		{
+			title2("Trim policy tests");
+
+			stack<int> reference(8, 64), i_stack(8, 64), i_stack2(8, 64), i_stack3(8, 64), i_stack4(8, 64);
+			i_stack2.set_trim_policy(stack<int>::trim_immediately);
+			i_stack4.set_trim_policy(stack<int>::trim_above_bytes, 128 * sizeof(int));
+
+			for (int temp = 0; temp != 1000; ++temp)
+			{
+				reference.push(temp);
+				i_stack.push(temp);
+				i_stack2.push(temp);
+				i_stack3.push(temp);
+				i_stack4.push(temp);
+			}
+
+			const size_t full_capacity = reference.capacity();
+
+			for (int temp = 0; temp != 500; ++temp)
+			{
+				reference.pop();
+				i_stack.pop();
+				i_stack2.pop();
+				i_stack3.pop();
+				i_stack4.pop();
+			}
+
+			reference.trim_trailing_groups();
+			const size_t trimmed_capacity = reference.capacity();
+
+			failpass("trim_never test", i_stack.get_trim_policy() == stack<int>::trim_never && i_stack.capacity() == full_capacity && trimmed_capacity < full_capacity);
+			failpass("trim_immediately test", i_stack2.capacity() == trimmed_capacity && i_stack2.size() == 500 && i_stack2.top() == 499);
+			failpass("trim_above_bytes test", i_stack4.capacity() == trimmed_capacity + 64);
+
+			i_stack3.set_trim_policy(stack<int>::trim_after_idle_pops, 5); // Trailing groups are present, so the idle pop count starts here
+
+			for (int temp = 0; temp != 4; ++temp)
+			{
+				i_stack3.pop();
+			}
+
+			failpass("trim_after_idle_pops pending test", i_stack3.capacity() == full_capacity);
+
+			i_stack3.pop();
+			failpass("trim_after_idle_pops test", i_stack3.capacity() == trimmed_capacity && i_stack3.get_trim_threshold() == 5);
+
+			stack<int> i_stack5(i_stack4);
+			failpass("Trim policy copy test", i_stack5.get_trim_policy() == stack<int>::trim_above_bytes && i_stack5.get_trim_threshold() == 128 * sizeof(int));
+
+			const stack<int>::marker frame_mark = i_stack2.mark();
+			i_stack2.push_n(1000, 1);
+			i_stack2.rewind(frame_mark);
+			failpass("trim_immediately rewind test", i_stack2.capacity() == trimmed_capacity && i_stack2.top() == 499);
+
+			i_stack.set_trim_policy(stack<int>::trim_immediately);
+			failpass("set_trim_policy immediate trim test", i_stack.capacity() == trimmed_capacity);
+
+			for (int temp = 0; temp != 500; ++temp)
+			{
+				i_stack2.pop();
+			}
+
+			failpass("trim_immediately empty test", i_stack2.empty() && i_stack2.capacity() == 8);
+		}
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Stateful allocator tests");
+
+			typedef sg14::arena_allocator<int> arena_alloc;
+			sg14::bump_arena arena(4096), arena2(4096);
+			const arena_alloc first_alloc(arena), second_alloc(arena2);
+
+			{
+				stack<int, arena_alloc> i_stack(first_alloc);
+
+				for (int temp = 0; temp != 10000; ++temp)
+				{
+					i_stack.push(temp);
+				}
+
+				failpass("Allocator instance test", arena.bytes_allocated() != 0 && i_stack.get_allocator() == first_alloc);
+
+				stack<int, arena_alloc> i_stack2(second_alloc);
+				i_stack2 = i_stack;
+				failpass("Copy assignment allocator test", i_stack2.size() == 10000 && i_stack2.top() == 9999 && i_stack2.get_allocator() == second_alloc);
+
+				stack<int, arena_alloc> i_stack3(second_alloc);
+				i_stack3 = std::move(i_stack);
+				failpass("Unequal allocator move assignment test", i_stack3.size() == 10000 && i_stack3.get_allocator() == second_alloc);
+
+				i_stack3.shrink_to_fit();
+				failpass("Allocator retention test", i_stack3.get_allocator() == second_alloc);
+
+				int total = 0;
+
+				for (int temp = 9999; temp != -1; --temp)
+				{
+					total += (i_stack3.top() == temp);
+					i_stack3.pop();
+				}
+
+				failpass("Unequal allocator move order test", total == 10000);
+			}
+
+			arena.release();
+			failpass("Arena release test", arena.bytes_reserved() == 0);
+		}
+		#endif
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("File-backed allocator tests");
+
+			typedef sg14::file_backed_allocator<int> file_alloc;
+			sg14::file_backed_resource resource("plf_stack_spill_test.tmp", 65536, std::size_t(1) << 28);
+
+			{
+				stack<int, file_alloc> i_stack((file_alloc(resource)));
+				i_stack.set_trim_policy(stack<int, file_alloc>::trim_immediately); // So that popped-from groups are returned and the resident window follows the top back down
+
+				for (int temp = 0; temp != 1000000; ++temp)
+				{
+					i_stack.push(temp);
+				}
+
+				#if defined(__linux__)
+					failpass("Spill test", resource.bytes_spilled() != 0 && resource.bytes_in_use() - resource.bytes_spilled() < resource.resident_bytes() * 2);
+				#endif
+
+				int total = 0;
+
+				for (int temp = 999999; temp != -1; --temp)
+				{
+					total += (i_stack.top() == temp);
+					i_stack.pop();
+				}
+
+				failpass("Spilled pop test", total == 1000000 && i_stack.empty());
+
+				#if defined(__linux__)
+					failpass("Spilled group return test", resource.bytes_in_use() < resource.resident_bytes());
+				#endif
+
+				for (int temp = 0; temp != 200000; ++temp)
+				{
+					i_stack.push(temp);
+				}
+
+				failpass("Push after spill test", i_stack.size() == 200000 && i_stack.top() == 199999);
+
+				stack<std::string, sg14::file_backed_allocator<std::string> > s_stack((sg14::file_backed_allocator<std::string>(resource)));
+				s_stack.push_n(20000, std::string("a fairly long string, to avoid the small string optimisation"));
+				failpass("Non-trivial spill test", s_stack.size() == 20000 && s_stack.top() == "a fairly long string, to avoid the small string optimisation");
+			}
+
+			failpass("File-backed destruction test", resource.bytes_in_use() == 0);
+
+			// Allocations returned out of order, including over-aligned ones, are only released once everything above them has been:
+			void * const first = resource.allocate(100);
+			void * const aligned = resource.allocate(5000, 4096);
+			void * const last = resource.allocate(1);
+			const std::size_t in_use = resource.bytes_in_use();
+
+			resource.deallocate(aligned, 5000, 4096);
+			resource.deallocate(first, 100);
+
+			failpass("File-backed out-of-order return test", reinterpret_cast<std::size_t>(aligned) % 4096 == 0 && resource.bytes_in_use() == in_use);
+
+			resource.deallocate(last, 1);
+
+			failpass("File-backed out-of-order release test", resource.bytes_in_use() == 0);
+		}
+		#endif
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Concurrent stack tests");
+
+			const unsigned int number_of_elements = 100000, number_of_producers = 4;
+
+			{
+				spsc_stack<unsigned int> i_stack;
+
+				for (unsigned int temp = 0; temp != 100; ++temp)
+				{
+					i_stack.push(temp);
+				}
+
+				unsigned int value = 0, total = 0;
+
+				for (unsigned int temp = 100; temp != 0; --temp)
+				{
+					total += (i_stack.try_pop(value) && value == temp - 1);
+				}
+
+				failpass("SPSC LIFO test", total == 100 && i_stack.empty() && !i_stack.try_pop(value));
+			}
+
+			{
+				spsc_stack<unsigned int> i_stack;
+				std::vector<unsigned char> popped(number_of_elements, 0);
+
+				std::thread producer_thread([&i_stack, number_of_elements]()
+				{
+					for (unsigned int temp = 0; temp != number_of_elements; ++temp)
+					{
+						i_stack.push(temp);
+					}
+				});
+
+				unsigned int value, number_popped = 0, duplicates = 0;
+
+				while (number_popped != number_of_elements)
+				{
+					if (i_stack.try_pop(value))
+					{
+						duplicates += popped[value]++;
+						++number_popped;
+					}
+				}
+
+				producer_thread.join();
+
+				failpass("SPSC concurrent push/pop test", duplicates == 0 && i_stack.empty());
+			}
+
+			{
+				spsc_stack<std::string> s_stack(3, 64);
+
+				for (unsigned int temp = 0; temp != 1000; ++temp)
+				{
+					s_stack.push(std::string(40, static_cast<char>('a' + (temp % 26))));
+				}
+
+				std::string value;
+				s_stack.try_pop(value);
+
+				failpass("SPSC non-trivial type test", value == std::string(40, 'a' + (999 % 26)) && s_stack.size() == 999);
+			}
+
+			{
+				mpsc_stack<unsigned int> i_stack;
+				std::vector<std::thread> producer_threads;
+
+				for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+				{
+					producer_threads.push_back(std::thread([&i_stack, producer_number, number_of_elements]()
+					{
+						mpsc_stack<unsigned int>::producer handle(i_stack);
+
+						for (unsigned int temp = 0; temp != number_of_elements; ++temp)
+						{
+							handle.push((producer_number * number_of_elements) + temp);
+						}
+					}));
+				}
+
+				std::vector<unsigned char> popped(number_of_producers * number_of_elements, 0);
+				unsigned int value, number_popped = 0, duplicates = 0;
+
+				while (number_popped != number_of_producers * number_of_elements)
+				{
+					if (i_stack.try_pop(value))
+					{
+						duplicates += popped[value]++;
+						++number_popped;
+					}
+				}
+
+				for (unsigned int producer_number = 0; producer_number != number_of_producers; ++producer_number)
+				{
+					producer_threads[producer_number].join();
+				}
+
+				failpass("MPSC concurrent push/pop test", duplicates == 0 && i_stack.empty());
+			}
+
+			{
+				mpsc_stack<std::string> s_stack;
+				mpsc_stack<std::string>::producer handle(s_stack);
+				std::string value;
+
+				handle.push("first");
+				handle.push("second");
+
+				failpass("MPSC unflushed visibility test", !s_stack.try_pop(value));
+
+				handle.flush();
+				handle.push("third");
+
+				failpass("MPSC flush test", s_stack.try_pop(value) && value == "second");
+			}
+
+			{
+				// A producer which stops part-way through a group is invisible to the consumer until it flushes, however long the consumer waits:
+				mpsc_stack<unsigned int> i_stack(64, 64);
+				std::atomic<int> stage(0);
+
+				std::thread producer_thread([&i_stack, &stage]()
+				{
+					mpsc_stack<unsigned int>::producer handle(i_stack);
+
+					for (unsigned int temp = 0; temp != 10; ++temp)
+					{
+						handle.push(temp);
+					}
+
+					stage.store(1);
+
+					while (stage.load() != 2)
+					{
+						std::this_thread::yield();
+					}
+
+					handle.flush();
+					stage.store(3);
+
+					while (stage.load() != 4) // Keep the handle alive, so that only flush() can have linked the group
+					{
+						std::this_thread::yield();
+					}
+				});
+
+				while (stage.load() != 1)
+				{
+					std::this_thread::yield();
+				}
+
+				unsigned int value = 0, number_popped = 0;
+				bool visible_before_flush = false;
+
+				for (unsigned int attempt = 0; attempt != 1000; ++attempt)
+				{
+					visible_before_flush |= i_stack.try_pop(value);
+					std::this_thread::yield();
+				}
+
+				stage.store(2);
+
+				while (stage.load() != 3)
+				{
+					std::this_thread::yield();
+				}
+
+				while (i_stack.try_pop(value))
+				{
+					number_popped += (value == 9 - number_popped);
+				}
+
+				stage.store(4);
+				producer_thread.join();
+
+				failpass("MPSC cross-thread flush required test", !visible_before_flush && number_popped == 10);
+			}
+		}
+		#endif
+
+
+		#ifdef PLF_ALLOCATOR_TRAITS_SUPPORT
+		{
+			title2("Work-stealing deque tests");
+
+			{
+				work_stealing_deque<unsigned int> deque(4, 16);
+				unsigned int value = 0;
+
+				for (unsigned int temp = 0; temp != 100; ++temp)
+				{
+					deque.push(temp);
+				}
+
+				failpass("Owner pop order test", deque.pop(value) && value == 99 && deque.size() == 99);
+				failpass("Steal order test", deque.steal(value) && value == 0 && deque.size() == 98);
+
+				while (deque.pop(value)) {}
+				failpass("Empty test", deque.empty() && !deque.steal(value));
+			}
+
+			{
+				const unsigned int number_of_elements = 100000, number_of_thieves = 3;
+				work_stealing_deque<unsigned int> deque(4, 64);
+				std::vector<unsigned int> taken(number_of_elements, 0);
+				std::atomic<unsigned int> number_taken(0);
+				std::atomic<bool> finished(false);
+				std::vector<std::thread> thieves;
+
+				for (unsigned int thief = 0; thief != number_of_thieves; ++thief)
+				{
+					thieves.push_back(std::thread([&deque, &taken, &number_taken, &finished]()
+					{
+						unsigned int value;
+
+						while (!finished.load())
+						{
+							if (deque.steal(value))
+							{
+								++taken[value]; // Each value is taken by exactly one thread, so there is no race on it's counter
+								++number_taken;
+							}
+						}
+					}));
+				}
+
+				unsigned int value;
+
+				for (unsigned int temp = 0; temp != number_of_elements; ++temp)
+				{
+					deque.push(temp);
+
+					if ((xor_rand() & 3) == 0 && deque.pop(value))
+					{
+						++taken[value];
+						++number_taken;
+					}
+				}
+
+				while (number_taken.load() != number_of_elements)
+				{
+					if (deque.pop(value))
+					{
+						++taken[value];
+						++number_taken;
+					}
+				}
+
+				finished.store(true);
+
+				for (unsigned int thief = 0; thief != number_of_thieves; ++thief)
+				{
+					thieves[thief].join();
+				}
+
+				unsigned int total = 0;
+
+				for (unsigned int temp = 0; temp != number_of_elements; ++temp)
+				{
+					total += (taken[temp] == 1);
+				}
+
+				failpass("Concurrent steal test", total == number_of_elements);
+			}
+
+			{
+				work_stealing_pool<> pool(4);
+				std::atomic<unsigned int> counter(0);
+				task_group group;
+
+				for (unsigned int temp = 0; temp != 1000; ++temp)
+				{
+					pool.spawn(group, [&counter]() { ++counter; });
+				}
+
+				pool.wait(group);
+				failpass("Pool external spawn test", counter.load() == 1000);
+
+				struct fib
+				{
+					static void run(work_stealing_pool<> &fib_pool, const unsigned int n, unsigned int &result)
+					{
+						if (n < 2)
+						{
+							result = n;
+							return;
+						}
+
+						unsigned int first, second;
+						task_group fib_group;
+						fib_pool.spawn(fib_group, [&fib_pool, n, &first]() { run(fib_pool, n - 1, first); });
+						run(fib_pool, n - 2, second);
+						fib_pool.wait(fib_group);
+						result = first + second;
+					}
+				};
+
+				unsigned int result = 0;
+				fib::run(pool, 20, result);
+				failpass("Pool fork-join test", result == 6765);
+			}
+		}
+		#endif
+
+
 		#ifdef PLF_VARIADICS_SUPPORT
 		{
 			title2("Perfect Forwarding tests");
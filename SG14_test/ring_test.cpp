@@ -1,12 +1,22 @@
 #include "SG14_test.h"
 
 #include "ring.h"
+#include "mirrored_ring.h"
+#include "ring_wait.h"
+#include "sliding_window.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <deque>
 #include <mutex>
 #include <future>
 #include <iostream>
 #include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
 
 void sg14_test::ring_test()
 {
@@ -49,9 +59,514 @@ void sg14_test::ring_test()
 	assert(Q5.front() == 6);
 	assert(Q5.back() == 10);
 
+	// Power-of-two capacities index by masking and others by comparison - both must behave as a plain modular ring, including when overwriting and when starting part-way through:
+	for (std::size_t capacity = 1; capacity != 10; ++capacity)
+	{
+		std::vector<int> storage(capacity);
+		sg14::ring_span<int> R(storage.begin(), storage.end(), storage.begin() + (capacity / 2), 0);
+		std::deque<int> model;
+		unsigned int seed = 1;
+
+		for (int i = 0; i != 2000; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+
+			if ((seed >> 16) % 3 != 0)
+			{
+				R.push_back(i);
+				model.push_back(i);
+
+				if (model.size() > capacity)
+				{
+					model.pop_front();
+				}
+			}
+			else if (!R.empty())
+			{
+				assert(R.pop_front() == model.front());
+				model.pop_front();
+			}
+
+			assert(R.size() == model.size());
+			std::size_t position = 0;
+
+			for (int value : R)
+			{
+				assert(value == model[position++]);
+			}
+
+			assert(position == model.size());
+			assert(R.empty() || (R.front() == model.front() && R.back() == model.back()));
+		}
+	}
+
+	// Bulk operations must match the element-by-element ones, however the runs fall across the end of the storage:
+	for (std::size_t capacity = 1; capacity != 10; ++capacity)
+	{
+		std::vector<int> bulk_storage(capacity), single_storage(capacity);
+		sg14::ring_span<int> bulk(bulk_storage.begin(), bulk_storage.end()), single(single_storage.begin(), single_storage.end());
+		std::vector<int> values(25), bulk_out(25), single_out(25);
+		int next_value = 0;
+
+		for (int i = 0; i != 300; ++i)
+		{
+			const std::size_t count = static_cast<std::size_t>(i * 7) % (capacity * 2 + 3);
+
+			if (i % 2 == 0)
+			{
+				for (std::size_t j = 0; j != count; ++j)
+				{
+					values[j] = next_value++;
+					single.push_back(values[j]);
+				}
+
+				bulk.push_back(values.begin(), values.begin() + count);
+			}
+			else
+			{
+				const std::size_t n = (count < single.size()) ? count : single.size();
+
+				if (i % 3 == 0)
+				{
+					bulk.pop_front_n(n);
+					std::fill(bulk_out.begin(), bulk_out.begin() + n, 0);
+				}
+				else
+				{
+					assert(bulk.pop_front_n(n, bulk_out.begin()) == bulk_out.begin() + n);
+				}
+
+				for (std::size_t j = 0; j != n; ++j)
+				{
+					single_out[j] = single.pop_front();
+					assert(i % 3 == 0 || bulk_out[j] == single_out[j]);
+				}
+			}
+
+			assert(bulk.size() == single.size());
+			const auto regions = bulk.contiguous_regions();
+			assert(regions[0].second + regions[1].second == single.size());
+			assert(regions[1].second == 0 || regions[1].first == bulk_storage.data());
+			auto current = single.begin();
+
+			for (const auto& region : regions)
+			{
+				for (std::size_t j = 0; j != region.second; ++j, ++current)
+				{
+					assert(region.first[j] == *current);
+				}
+			}
+		}
+	}
+
+	// With a popper other than the default, bulk pops go through the popper:
+	std::array<int, 4> C;
+	sg14::ring_span<int, sg14::copy_popper<int>> Q7(std::begin(C), std::end(C), sg14::copy_popper<int>(-1));
+	const int D[] = { 1, 2, 3 };
+	Q7.push_back(std::begin(D), std::end(D));
+	int E[2];
+	Q7.pop_front_n(2, E);
+	assert(Q7.size() == 1 && Q7.front() == 3);
+	assert(C[0] == -1 && C[1] == -1);
+	Q7.pop_front_n(1);
+	assert(Q7.empty() && C[2] == -1);
+
 	puts("Ring test completed.\n");
 }
 
+namespace
+{
+	// Drives ring with random pushes (overwriting when full), bulk pushes and pops, checking it against a std::deque holding what a ring of the given capacity should:
+	template <class Ring>
+	void check_ring_against_model(Ring& ring, std::size_t capacity)
+	{
+		std::deque<int> model;
+		std::vector<int> block(capacity * 2 + 1);
+		unsigned int seed = 7;
+		int next_value = 0;
+
+		for (int i = 0; i != 3000; ++i)
+		{
+			seed = seed * 1103515245u + 12345u;
+			const unsigned int choice = (seed >> 16) % 8;
+
+			if (choice < 4)
+			{
+				ring.push_back(next_value);
+				model.push_back(next_value++);
+			}
+			else if (choice == 4)
+			{
+				const std::size_t count = (seed >> 20) % block.size();
+
+				for (std::size_t j = 0; j != count; ++j)
+				{
+					block[j] = next_value;
+					model.push_back(next_value++);
+				}
+
+				ring.push_back(block.begin(), block.begin() + count);
+			}
+			else if (!ring.empty())
+			{
+				assert(ring.pop_front() == model.front());
+				model.pop_front();
+			}
+
+			while (model.size() > capacity)
+			{
+				model.pop_front();
+			}
+
+			assert(ring.size() == model.size());
+			assert(ring.empty() || (ring.front() == model.front() && ring.back() == model.back()));
+			std::size_t position = 0;
+
+			for (int value : ring)
+			{
+				assert(value == model[position++]);
+			}
+
+			assert(position == model.size());
+		}
+	}
+}
+
+void sg14_test::static_ring_test()
+{
+	sg14::static_ring<int, 4> Q;
+	static_assert(sg14::static_ring<int, 4>::capacity() == 4, "static_ring capacity is a constant");
+	static_assert(sizeof(sg14::static_ring<int, 4>) <= sizeof(int) * 4 + sizeof(std::size_t) * 3, "static_ring storage is inline");
+
+	assert(Q.empty());
+	Q.push_back(1);
+	Q.push_back(2);
+	Q.emplace_back(3);
+	assert(Q.size() == 3 && Q.front() == 1 && Q.back() == 3);
+
+	Q.push_back(4);
+	Q.push_back(5);
+	assert(Q.full() && Q.front() == 2 && Q.back() == 5);
+
+	// Copies are independent:
+	sg14::static_ring<int, 4> Q2 = Q;
+	assert(Q.pop_front() == 2);
+	assert(Q2.front() == 2 && Q2.size() == 4);
+	Q2.swap(Q);
+	assert(Q.size() == 4 && Q2.size() == 3 && Q2.front() == 3);
+
+	int out[4];
+	assert(Q.pop_front_n(4, out) == out + 4);
+	assert(out[0] == 2 && out[3] == 5 && Q.empty());
+
+	// Both index-wrapping schemes:
+	sg14::static_ring<int, 8> R8;
+	check_ring_against_model(R8, 8);
+	sg14::static_ring<int, 7> R7;
+	check_ring_against_model(R7, 7);
+	sg14::static_ring<int, 1> R1;
+	check_ring_against_model(R1, 1);
+
+	const auto regions = R7.contiguous_regions();
+	assert(regions[0].second + regions[1].second == R7.size());
+
+	puts("Static ring test completed.\n");
+}
+
+void sg14_test::dynamic_ring_test()
+{
+	using ring = sg14::dynamic_ring<int>;
+
+	// Overwriting, as ring_span:
+	ring Q(5);
+	assert(Q.capacity() == 5 && Q.policy() == ring::full_policy::overwrite);
+	check_ring_against_model(Q, 5);
+	ring Q8(8);
+	check_ring_against_model(Q8, 8);
+
+	// Growing keeps every element, in order:
+	ring G(3, ring::full_policy::grow);
+
+	for (int i = 0; i != 100; ++i)
+	{
+		G.push_back(i);
+	}
+
+	assert(G.size() == 100 && G.capacity() == 192);
+	assert(G.front() == 0 && G.back() == 99);
+
+	for (int i = 0; i != 50; ++i)
+	{
+		assert(G.pop_front() == i);
+	}
+
+	std::vector<int> block(300);
+	std::iota(block.begin(), block.end(), 100);
+	G.push_back(block.begin(), block.end());
+	assert(G.size() == 350 && G.capacity() == 384);
+	int expected = 50;
+
+	for (int value : G)
+	{
+		assert(value == expected++);
+	}
+
+	// Pushing an element of the ring itself, as it reallocates:
+	ring A(2, ring::full_policy::grow);
+	A.push_back(7);
+	A.push_back(8);
+	A.push_back(A.front());
+	assert(A.size() == 3 && A.back() == 7);
+
+	// Copying, moving and switching policy:
+	ring C(G);
+	assert(C.size() == G.size() && C.front() == G.front() && C.back() == G.back());
+	C.pop_front();
+	assert(G.front() == 50);
+
+	ring M(std::move(C));
+	assert(M.size() == 349 && M.front() == 51);
+	assert(C.capacity() == 0 && C.empty());
+	C = M;
+	assert(C.size() == 349 && C.front() == 51);
+	C.push_back(1000); // Grows, as the policy was copied
+	assert(C.size() == 350);
+
+	M.set_policy(ring::full_policy::overwrite);
+	M.reserve(349);
+	M.push_back(block.begin(), block.end());
+	assert(M.size() == M.capacity() && M.back() == 399);
+
+	// A moved-from ring can grow again:
+	ring D(std::move(M));
+	M.set_policy(ring::full_policy::grow);
+	M.push_back(5);
+	assert(M.size() == 1 && M.capacity() == 1 && M.front() == 5);
+
+	// Non-trivial elements, reallocated with move:
+	sg14::dynamic_ring<std::string> S(1, sg14::dynamic_ring<std::string>::full_policy::grow);
+	S.push_back(std::string(40, 'a'));
+	S.emplace_back(40, 'b');
+	S.push_back("c");
+	assert(S.size() == 3 && S.front() == std::string(40, 'a') && S.back() == "c");
+	assert(S.pop_front().size() == 40);
+	assert(S.front() == std::string(40, 'b'));
+
+	puts("Dynamic ring test completed.\n");
+}
+
+namespace
+{
+	// Neither default-constructible nor assignable, counting live instances so that every construction can be matched to a destruction:
+	struct tracked
+	{
+		static int live;
+
+		tracked(int v, const std::string& tag) : value(v), name(tag) { if (v < 0) throw v; ++live; }
+		tracked(const tracked& other) : value(other.value), name(other.name) { ++live; }
+		tracked& operator=(const tracked&) = delete;
+		~tracked() { --live; }
+
+		int value;
+		std::string name;
+	};
+
+	int tracked::live = 0;
+}
+
+void sg14_test::uninitialized_ring_span_test()
+{
+	// Pushes construct and pops destroy, with nothing constructed up-front:
+	{
+		std::aligned_storage_t<sizeof(tracked), alignof(tracked)> storage[3];
+		sg14::uninitialized_ring_span<tracked> Q(storage, 3);
+		assert(Q.empty() && Q.capacity() == 3 && tracked::live == 0);
+
+		Q.emplace_back(1, "one");
+		Q.emplace_back(2, "two");
+		Q.push_back(tracked(3, "three"));
+		assert(Q.full() && tracked::live == 3);
+		assert(Q.front().value == 1 && Q.back().name == "three");
+
+		// Overwriting destroys the front element:
+		Q.emplace_back(4, "four");
+		assert(Q.size() == 3 && tracked::live == 3 && Q.front().value == 2 && Q.back().value == 4);
+
+		assert(Q.pop_front().value == 2);
+		assert(Q.size() == 2 && tracked::live == 2);
+
+		// A throwing construction leaves a ring with room unchanged:
+		try
+		{
+			Q.emplace_back(-1, "bad");
+			assert(false);
+		}
+		catch (int)
+		{
+		}
+
+		assert(Q.size() == 2 && tracked::live == 2 && Q.back().value == 4);
+
+		std::vector<tracked> block;
+		block.emplace_back(5, "five");
+		block.emplace_back(6, "six");
+		Q.push_back(block.begin(), block.end());
+		assert(Q.size() == 3 && tracked::live == 5 && Q.front().value == 4 && Q.back().value == 6);
+
+		Q.pop_front_n(2);
+		assert(Q.size() == 1 && tracked::live == 3 && Q.front().value == 6);
+	}
+
+	assert(tracked::live == 0); // The span destroyed it's remaining element
+
+	// Move-only elements, moved out by the pops:
+	{
+		std::aligned_storage_t<sizeof(std::unique_ptr<int>), alignof(std::unique_ptr<int>)> storage[4];
+		sg14::uninitialized_ring_span<std::unique_ptr<int>> Q(storage, 4);
+
+		for (int i = 0; i != 6; ++i)
+		{
+			Q.emplace_back(new int(i));
+		}
+
+		assert(Q.size() == 4 && *Q.front() == 2);
+		std::unique_ptr<int> out[3];
+		assert(Q.pop_front_n(3, out) == out + 3);
+		assert(*out[0] == 2 && *out[2] == 4 && *Q.front() == 5);
+
+		// Moving hands over the elements, and leaves the source empty:
+		sg14::uninitialized_ring_span<std::unique_ptr<int>> M(std::move(Q));
+		assert(Q.empty() && M.size() == 1 && *M.front() == 5);
+		M.push_back(std::unique_ptr<int>(new int(6)));
+		Q = std::move(M);
+		assert(M.empty() && Q.size() == 2 && *Q.back() == 6);
+	}
+
+	// extend_back default-initialises elements to be written in place, across the end of the storage:
+	{
+		std::aligned_storage_t<sizeof(float), alignof(float)> storage[5];
+		sg14::uninitialized_ring_span<float> Q(storage, 5);
+		Q.push_back(0.0f);
+		Q.push_back(0.0f);
+		Q.push_back(0.0f);
+		Q.pop_front_n(3);
+		Q.extend_back(4);
+		const auto regions = Q.contiguous_regions();
+		assert(regions[0].second == 2 && regions[1].second == 2);
+
+		for (std::size_t i = 0; i != 2; ++i)
+		{
+			regions[0].first[i] = float(i);
+			regions[1].first[i] = float(i + 2);
+		}
+
+		for (int i = 0; i != 4; ++i)
+		{
+			assert(Q.pop_front() == float(i));
+		}
+	}
+
+	// Both index-wrapping schemes:
+	std::aligned_storage_t<sizeof(int), alignof(int)> storage8[8], storage7[7], storage1[1];
+	sg14::uninitialized_ring_span<int> R8(storage8, 8);
+	check_ring_against_model(R8, 8);
+	sg14::uninitialized_ring_span<int> R7(storage7, 7);
+	check_ring_against_model(R7, 7);
+	sg14::uninitialized_ring_span<int> R1(storage1, 1);
+	check_ring_against_model(R1, 1);
+
+	puts("Uninitialized ring span test completed.\n");
+}
+
+void sg14_test::mirrored_ring_test()
+{
+	sg14::mirrored_ring R(100);
+	const std::size_t capacity = R.capacity();
+	assert(capacity >= 100 && R.empty() && R.free_space() == capacity);
+
+	// Random-sized writes and reads, checked against a model - every read must see the readable bytes contiguously, however they wrap:
+	std::deque<char> model;
+	std::vector<char> scratch(capacity);
+	unsigned int seed = 12345;
+	char next_byte = 0;
+
+	for (int round = 0; round != 2000; ++round)
+	{
+		seed = seed * 1103515245 + 12345;
+		const std::size_t write_count = (seed >> 8) % (capacity / 3 + 1);
+
+		// Alternate between writing in place and copying in:
+		if (round % 2 == 0)
+		{
+			const std::size_t count = (write_count < R.free_space()) ? write_count : R.free_space();
+			char* const destination = R.write_data();
+
+			for (std::size_t i = 0; i != count; ++i)
+			{
+				destination[i] = next_byte;
+				model.push_back(next_byte++);
+			}
+
+			R.commit(count);
+		}
+		else
+		{
+			for (std::size_t i = 0; i != write_count; ++i)
+			{
+				scratch[i] = static_cast<char>(next_byte + i);
+			}
+
+			const std::size_t count = R.write(scratch.data(), write_count);
+			assert(count == ((write_count < capacity - model.size()) ? write_count : capacity - model.size()));
+			model.insert(model.end(), scratch.begin(), scratch.begin() + count);
+			next_byte = static_cast<char>(next_byte + count);
+		}
+
+		assert(R.size() == model.size() && R.free_space() == capacity - model.size());
+		const char* const readable = R.read_data();
+
+		for (std::size_t i = 0; i != model.size(); ++i)
+		{
+			assert(readable[i] == model[i]);
+		}
+
+		seed = seed * 1103515245 + 12345;
+		const std::size_t read_count = (seed >> 8) % (R.size() + 1);
+
+		if (round % 3 == 0)
+		{
+			assert(R.read(scratch.data(), read_count) == read_count);
+			assert(std::equal(scratch.begin(), scratch.begin() + read_count, model.begin()));
+		}
+		else
+		{
+			R.consume(read_count);
+		}
+
+		model.erase(model.begin(), model.begin() + read_count);
+	}
+
+	// Filling to capacity, from an offset part-way through:
+	R.consume(R.size());
+	R.write("abc", 3);
+	R.consume(3);
+	std::vector<char> fill(capacity + 10, 'x');
+	assert(R.write(fill.data(), fill.size()) == capacity && R.full() && R.free_space() == 0);
+	assert(R.read_data()[0] == 'x' && R.read_data()[capacity - 1] == 'x');
+	assert(R.read(fill.data(), fill.size()) == capacity && R.empty());
+
+	// Moving hands over the storage:
+	R.write("hello", 5);
+	sg14::mirrored_ring M(std::move(R));
+	assert(R.capacity() == 0 && R.empty());
+	assert(M.size() == 5 && std::string(M.read_data(), 5) == "hello");
+	sg14::mirrored_ring N(1);
+	N = std::move(M);
+	assert(N.size() == 5 && std::string(N.read_data(), 5) == "hello");
+
+	puts("Mirrored ring test completed.\n");
+}
+
 void sg14_test::thread_communication_test()
 {
 	std::array<int, 10> A;
@@ -91,6 +606,464 @@ void sg14_test::thread_communication_test()
 	});
 }
 
+void sg14_test::spsc_ring_test()
+{
+	std::array<int, 3> A;
+	sg14::spsc_ring_span<int> Q(std::begin(A), std::end(A));
+	int val = 0;
+
+	assert(Q.empty());
+	assert(Q.capacity() == 3);
+	assert(!Q.try_pop_front(val));
+
+	assert(Q.try_push_back(1));
+	assert(Q.try_push_back(2));
+	assert(Q.try_emplace_back(3));
+	assert(Q.full());
+	assert(!Q.try_push_back(4));
+	assert(Q.size() == 3);
+
+	assert(Q.try_pop_front(val) && val == 1);
+	assert(Q.try_push_back(4));
+	assert(!Q.try_push_back(5));
+
+	// Wrap the indices around several times:
+	for (int i = 5; i != 20; ++i)
+	{
+		assert(Q.try_pop_front(val) && val == i - 3);
+		assert(Q.try_push_back(i));
+		assert(Q.size() == 3);
+	}
+
+	assert(Q.try_pop_front(val) && val == 17);
+	assert(Q.try_pop_front(val) && val == 18);
+	assert(Q.try_pop_front(val) && val == 19);
+	assert(Q.empty());
+	assert(!Q.try_pop_front(val) && val == 19);
+
+	std::array<std::string, 2> S;
+	sg14::spsc_ring_span<std::string> Q2(std::begin(S), std::end(S));
+	std::string str("moved");
+	std::string out;
+	assert(Q2.try_push_back(std::move(str)));
+	assert(Q2.try_emplace_back(3, 'x'));
+	assert(!Q2.try_emplace_back(3, 'y'));
+	assert(Q2.try_pop_front(out) && out == "moved");
+	assert(Q2.try_pop_front(out) && out == "xxx");
+
+	// One producer and one consumer thread - every value must arrive, in order:
+	std::array<unsigned int, 64> B;
+	sg14::spsc_ring_span<unsigned int> buffer(std::begin(B), std::end(B));
+	const unsigned int count = 1000000;
+
+	std::thread producer([&]()
+	{
+		for (unsigned int i = 0; i != count; ++i)
+		{
+			while (!buffer.try_push_back(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	unsigned int expected = 0, received = 0;
+
+	while (expected != count)
+	{
+		if (buffer.try_pop_front(received))
+		{
+			assert(received == expected);
+			++expected;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+	assert(buffer.empty());
+
+	puts("SPSC ring test completed.\n");
+}
+
+void sg14_test::mpmc_ring_test()
+{
+	std::array<sg14::mpmc_ring_span<int>::slot_type, 4> A;
+	sg14::mpmc_ring_span<int> Q(std::begin(A), std::end(A));
+	int val = 0;
+
+	assert(Q.empty());
+	assert(Q.capacity() == 4);
+	assert(!Q.try_pop(val));
+
+	assert(Q.try_push(1));
+	assert(Q.try_emplace(2));
+	assert(Q.size() == 2);
+	assert(Q.try_pop(val) && val == 1);
+
+	// Batches are cut short by the space or elements available:
+	const int values[] = { 3, 4, 5, 6, 7 };
+	assert(Q.try_push(std::begin(values), std::end(values)) == 3);
+	assert(Q.size() == 4);
+	assert(!Q.try_push(8));
+	assert(Q.try_push(std::begin(values), std::end(values)) == 0);
+
+	int out[6] = {};
+	assert(Q.try_pop(out, 0) == 0);
+	assert(Q.try_pop(out, 3) == 3);
+	assert(out[0] == 2 && out[1] == 3 && out[2] == 4);
+	assert(Q.try_push(std::begin(values), std::begin(values) + 2) == 2);
+	assert(Q.try_pop(out, 6) == 3);
+	assert(out[0] == 5 && out[1] == 3 && out[2] == 4);
+	assert(Q.empty());
+	assert(Q.try_pop(out, 6) == 0);
+
+	// Several producers and consumers, half of each moving batches - every value must arrive once, and each producer's values in the order it pushed them:
+	std::array<sg14::mpmc_ring_span<unsigned int>::slot_type, 64> B;
+	sg14::mpmc_ring_span<unsigned int> buffer(std::begin(B), std::end(B));
+	const unsigned int number_of_threads = 4, per_producer = 200000;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<unsigned int>> received(number_of_threads);
+	std::atomic<unsigned int> remaining(number_of_threads * per_producer);
+
+	for (unsigned int t = 0; t != number_of_threads; ++t)
+	{
+		threads.emplace_back([&buffer, t, per_producer]()
+		{
+			unsigned int batch[16];
+
+			for (unsigned int i = 0; i != per_producer;)
+			{
+				if (t % 2 == 0)
+				{
+					if (buffer.try_push((t << 24) | i))
+					{
+						++i;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+				else
+				{
+					unsigned int batch_size = 0;
+
+					for (; batch_size != 16 && i + batch_size != per_producer; ++batch_size)
+					{
+						batch[batch_size] = (t << 24) | (i + batch_size);
+					}
+
+					const unsigned int pushed = static_cast<unsigned int>(buffer.try_push(batch, batch + batch_size));
+					i += pushed;
+
+					if (pushed == 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		});
+
+		threads.emplace_back([&buffer, &received, &remaining, t]()
+		{
+			unsigned int batch[16];
+
+			while (remaining.load() != 0)
+			{
+				const unsigned int popped = static_cast<unsigned int>((t % 2 == 0) ? (buffer.try_pop(batch[0]) ? 1 : 0) : buffer.try_pop(batch, 16));
+				received[t].insert(received[t].end(), batch, batch + popped);
+				remaining -= popped;
+
+				if (popped == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	assert(buffer.empty());
+
+	std::vector<unsigned int> next_expected(number_of_threads, 0);
+	unsigned int total_received = 0;
+
+	for (unsigned int t = 0; t != number_of_threads; ++t)
+	{
+		std::vector<long> last_seen(number_of_threads, -1);
+
+		for (unsigned int value : received[t])
+		{
+			const unsigned int producer = value >> 24, index = value & 0xFFFFFF;
+			assert(static_cast<long>(index) > last_seen[producer]); // In order per producer, as seen by one consumer
+			last_seen[producer] = index;
+			++next_expected[producer];
+		}
+
+		total_received += static_cast<unsigned int>(received[t].size());
+	}
+
+	for (unsigned int t = 0; t != number_of_threads; ++t)
+	{
+		assert(next_expected[t] == per_producer);
+	}
+
+	assert(total_received == number_of_threads * per_producer);
+
+	puts("MPMC ring test completed.\n");
+}
+
+namespace
+{
+	// One producer hands count elements to one consumer through a small ring, so that both regularly wait - the consumer while it is empty and the producer while it is full:
+	template <class WaitStrategy>
+	void check_blocking_handoff(int count)
+	{
+		std::vector<int> storage(4);
+		sg14::blocking_ring<sg14::spsc_ring_span<int>, WaitStrategy> Q(storage.begin(), storage.end());
+
+		std::thread producer([&Q, count]()
+		{
+			for (int i = 0; i != count; ++i)
+			{
+				Q.push(i);
+			}
+		});
+
+		for (int i = 0; i != count; ++i)
+		{
+			int val = -1;
+			Q.pop(val);
+			assert(val == i);
+		}
+
+		producer.join();
+		assert(Q.ring().empty());
+
+		// Timed waits give up on a ring that stays empty or full:
+		int val = -1;
+		const auto start = std::chrono::steady_clock::now();
+		assert(!Q.try_pop_for(val, std::chrono::milliseconds(2)) && val == -1);
+		assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(2));
+
+		for (int i = 0; i != 4; ++i)
+		{
+			assert(Q.try_push(i));
+		}
+
+		assert(!Q.try_push(4) && !Q.try_push_for(4, std::chrono::milliseconds(1)));
+		assert(Q.try_pop_for(val, std::chrono::milliseconds(1)) && val == 0);
+		assert(Q.try_push_until(4, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+	}
+}
+
+void sg14_test::blocking_ring_test()
+{
+	check_blocking_handoff<sg14::busy_spin_wait>(2000);
+	check_blocking_handoff<sg14::spin_yield_wait>(20000);
+	check_blocking_handoff<sg14::spin_futex_wait>(20000);
+
+	// A timed wait which is notified before it's deadline:
+	{
+		std::vector<int> storage(4);
+		sg14::blocking_ring<sg14::spsc_ring_span<int>> Q(storage.begin(), storage.end());
+		std::thread producer([&Q]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			Q.push(42);
+		});
+
+		int val = 0;
+		assert(Q.try_pop_for(val, std::chrono::seconds(10)) && val == 42);
+		producer.join();
+	}
+
+	// Several producers and consumers through an mpmc_ring_span, with every element arriving exactly once:
+	{
+		using ring = sg14::mpmc_ring_span<int>;
+		std::vector<ring::slot_type> slots(8);
+		sg14::blocking_ring<ring> Q(slots.begin(), slots.end());
+		const int per_thread = 5000;
+		std::vector<std::thread> threads;
+		std::vector<long long> sums(3, 0);
+
+		for (int t = 0; t != 3; ++t)
+		{
+			threads.emplace_back([&Q, t, per_thread]()
+			{
+				for (int i = 0; i != per_thread; ++i)
+				{
+					Q.push(t * per_thread + i + 1);
+				}
+			});
+
+			threads.emplace_back([&Q, &sums, t, per_thread]()
+			{
+				for (int i = 0; i != per_thread; ++i)
+				{
+					int val = 0;
+					Q.pop(val);
+					sums[t] += val;
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		const long long n = 3 * per_thread;
+		assert(sums[0] + sums[1] + sums[2] == n * (n + 1) / 2);
+		assert(Q.ring().empty());
+	}
+
+	puts("Blocking ring test completed.\n");
+}
+
+void sg14_test::broadcast_ring_test()
+{
+	using ring = sg14::broadcast_ring_span<int>;
+
+	// Gated by the slowest consumer:
+	{
+		std::array<int, 4> A;
+		ring Q(A.begin(), A.end(), 2);
+		assert(Q.capacity() == 4 && Q.consumers() == 2 && Q.policy() == ring::full_policy::wait_for_slowest);
+
+		for (int i = 0; i != 4; ++i)
+		{
+			assert(Q.try_publish(i));
+		}
+
+		assert(!Q.try_publish(4));
+		auto regions = Q.available(0);
+		assert(regions[0].second == 4 && regions[1].second == 0 && regions[0].first[0] == 0 && regions[0].first[3] == 3);
+		assert(Q.release(0, 2) && Q.size(0) == 2 && Q.size(1) == 4);
+		assert(!Q.try_publish(4)); // Consumer 1 has released nothing
+
+		assert(Q.release(1, 3));
+		const int more[] = { 4, 5, 6 };
+		assert(Q.try_publish(std::begin(more), std::end(more)) == 2); // Consumer 0 now holds the ring back
+
+		// Elements are read in place, across the end of the storage:
+		regions = Q.available(1);
+		assert(regions[0].second == 1 && regions[1].second == 2);
+		assert(regions[0].first[0] == 3 && regions[1].first[0] == 4 && regions[1].first[1] == 5);
+		assert(Q.release(1, 3) && Q.size(1) == 0);
+		assert(Q.lost(0) == 0 && Q.lost(1) == 0);
+	}
+
+	// Overwriting, with a consumer that falls behind:
+	{
+		std::array<int, 4> A;
+		ring Q(A.begin(), A.end(), 1, ring::full_policy::overwrite);
+
+		for (int i = 0; i != 10; ++i)
+		{
+			assert(Q.try_publish(i));
+		}
+
+		auto regions = Q.available(0);
+		assert(Q.lost(0) == 6 && regions[0].second + regions[1].second == 4);
+		assert(regions[0].first[0] == 6 && regions[1].first[1] == 9);
+
+		// Overwritten while being read - the batch must be discarded:
+		assert(Q.try_publish(10));
+		assert(!Q.release(0, 4) && Q.lost(0) == 10);
+
+		regions = Q.available(0);
+		assert(regions[0].second + regions[1].second == 1 && regions[0].first[0] == 10);
+		assert(Q.release(0, 1));
+
+		// Publishing more than the capacity in one go keeps the last capacity() elements:
+		std::vector<int> block(7);
+		std::iota(block.begin(), block.end(), 11);
+		assert(Q.try_publish(block.begin(), block.end()) == 4);
+		regions = Q.available(0);
+		assert(Q.lost(0) == 13 && Q.size(0) == 4 && (regions[0].second != 0 ? regions[0].first[0] : regions[1].first[0]) == 14);
+	}
+
+	// One producer and three consumers, each seeing every element in order, at power-of-two and other capacities:
+	for (std::size_t capacity : { 8, 7 })
+	{
+		const int count = 20000;
+		std::vector<int> storage(capacity);
+		ring Q(storage.begin(), storage.end(), 3);
+		std::vector<std::thread> consumers;
+
+		for (std::size_t c = 0; c != 3; ++c)
+		{
+			consumers.emplace_back([&Q, c, count]()
+			{
+				int expected = 0;
+
+				while (expected != count)
+				{
+					const auto regions = Q.available(c);
+
+					for (const auto& region : regions)
+					{
+						for (std::size_t i = 0; i != region.second; ++i)
+						{
+							assert(region.first[i] == expected);
+							++expected;
+						}
+					}
+
+					if (regions[0].second + regions[1].second == 0)
+					{
+						std::this_thread::yield();
+					}
+
+					Q.release(c, regions[0].second + regions[1].second);
+				}
+			});
+		}
+
+		int next = 0;
+		int block[3];
+
+		while (next != count)
+		{
+			std::size_t published;
+
+			if (next % 2 == 0 && count - next >= 3)
+			{
+				block[0] = next;
+				block[1] = next + 1;
+				block[2] = next + 2;
+				published = Q.try_publish(std::begin(block), std::end(block));
+			}
+			else
+			{
+				published = Q.try_publish(next) ? 1 : 0;
+			}
+
+			if (published == 0)
+			{
+				std::this_thread::yield();
+			}
+
+			next += static_cast<int>(published);
+		}
+
+		for (std::thread& consumer : consumers)
+		{
+			consumer.join();
+		}
+	}
+
+	puts("Broadcast ring test completed.\n");
+}
+
 void sg14_test::filter_test()
 {
 	std::array< double, 3 > A;
@@ -111,3 +1084,70 @@ void sg14_test::filter_test()
 	assert( std::inner_product( buffer.begin(), buffer.end(), filter_coefficients.begin(), 0.0 ) == 5.0 );
 	puts( "Filter example completed.\n" );
 }
+
+void sg14_test::sliding_window_test()
+{
+	// The filter example again, through the sliding window:
+	{
+		sg14::sliding_window<double> window(3);
+		const std::array<double, 4> samples = { 1.0, 2.0, 3.0, 5.0 };
+		window.push(samples.begin(), samples.end());
+		assert(window.size() == 3 && window.samples().front() == 2.0);
+
+		const std::array<double, 3> filter_coefficients = { 0.25, 0.5, 0.25 };
+		window.push(7.0);
+		assert(window.fir(filter_coefficients.data()) == 5.0);
+		assert(window.sum() == 15.0 && window.mean() == 5.0 && window.min() == 3.0 && window.max() == 7.0);
+		assert(std::abs(window.variance() - 8.0 / 3.0) < 1e-12);
+	}
+
+	// Every statistic against recomputing it from scratch, for windows which are and are not powers of two, through many wraparounds:
+	for (std::size_t window_size : { 1u, 2u, 5u, 8u, 33u })
+	{
+		sg14::sliding_window<double> window(window_size);
+		std::vector<double> expected;
+		std::vector<double> coefficients(window_size);
+		std::iota(coefficients.begin(), coefficients.end(), 1.0);
+		unsigned int state = 12345;
+
+		for (int i = 0; i != 2000; ++i)
+		{
+			// Runs of rising, falling and repeated values, which exercise the min and max queues:
+			state = state * 1103515245 + 12345;
+			const double sample = (i % 300 < 100) ? i * 0.5 : (i % 300 < 200) ? -i * 0.25 : static_cast<double>((state >> 16) % 7);
+			window.push(sample);
+			expected.push_back(sample);
+
+			if (expected.size() > window_size)
+			{
+				expected.erase(expected.begin());
+			}
+
+			assert(window.size() == expected.size() && std::equal(window.samples().begin(), window.samples().end(), expected.begin()));
+			assert(window.min() == *std::min_element(expected.begin(), expected.end()));
+			assert(window.max() == *std::max_element(expected.begin(), expected.end()));
+
+			const double sum = std::accumulate(expected.begin(), expected.end(), 0.0);
+			const double mean = sum / expected.size();
+			double squared_deviations = 0.0;
+
+			for (double val : expected)
+			{
+				squared_deviations += (val - mean) * (val - mean);
+			}
+
+			const double fir = std::inner_product(expected.begin(), expected.end(), coefficients.begin(), 0.0);
+			assert(std::abs(window.sum() - sum) <= 1e-9 * (1.0 + std::abs(sum)));
+			assert(std::abs(window.mean() - mean) <= 1e-9 * (1.0 + std::abs(mean)));
+			assert(std::abs(window.variance() - squared_deviations / expected.size()) <= 1e-9 * (1.0 + squared_deviations));
+			assert(std::abs(window.fir(coefficients.data()) - fir) <= 1e-9 * (1.0 + std::abs(fir)));
+		}
+
+		window.clear();
+		assert(window.empty());
+		window.push(-3.0);
+		assert(window.size() == 1 && window.sum() == -3.0 && window.variance() == 0.0 && window.min() == -3.0 && window.max() == -3.0);
+	}
+
+	puts("Sliding window test completed.\n");
+}